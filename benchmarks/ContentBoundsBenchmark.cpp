@@ -0,0 +1,199 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ContentBoundsBenchmark.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+// 内容边界查找的微基准：逐列二分（旧实现）、整幅列统计、按块列统计
+// 用法：ContentBoundsBenchmark [width] [height] [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "algo/ColumnProfile.hpp"
+
+namespace {
+
+constexpr uint8_t kWhiteThreshold = 200;
+constexpr double kRatio = 0.1;
+
+// HoleDetection 原来的实现：每次二分都跨所有采样行读取同一列
+std::pair<int, int> gather_bounds(const cv::Mat& gray, int step) {
+  const int height = gray.rows;
+  const int width = gray.cols;
+  const int sampled = (height + step - 1) / step;
+  std::vector<const uint8_t*> rows;
+  for (int y = 0; y < height; y += step) {
+    rows.push_back(gray.ptr<uint8_t>(y));
+  }
+  auto is_white = [&](int x) {
+    int count = 0;
+    for (const auto* row : rows) {
+      count += row[x] > kWhiteThreshold;
+    }
+    return static_cast<double>(count) / sampled > kRatio;
+  };
+
+  int x_min = 0;
+  if (is_white(0)) {
+    int left = 0, right = width - 1;
+    while (left < right) {
+      int mid = (left + right) / 2;
+      if (is_white(mid)) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    x_min = left;
+  }
+  int x_max = width - 1;
+  if (is_white(width - 1)) {
+    int left = 0, right = width - 1;
+    while (left < right) {
+      int mid = (left + right + 1) / 2;
+      if (is_white(mid)) {
+        right = mid - 1;
+      } else {
+        left = mid;
+      }
+    }
+    x_max = left;
+  }
+  return {x_min, x_max};
+}
+
+// 先算整幅列统计，再在统计上二分
+std::pair<int, int> full_profile_bounds(const cv::Mat& gray, int step,
+                                        std::vector<uint32_t>& counts) {
+  const int sampled =
+      algo::count_bright_columns(gray, step, kWhiteThreshold, counts);
+  auto is_white = [&](int x) {
+    return static_cast<double>(counts[x]) / sampled > kRatio;
+  };
+  int x_min = 0;
+  while (x_min < gray.cols && is_white(x_min)) {
+    ++x_min;
+  }
+  int x_max = gray.cols - 1;
+  while (x_max > 0 && is_white(x_max)) {
+    --x_max;
+  }
+  return {x_min, x_max};
+}
+
+// HoleDetection 现在的实现
+std::pair<int, int> block_profile_bounds(const cv::Mat& gray, int step,
+                                         algo::ColumnProfile& profile) {
+  profile.reset(gray, step, kWhiteThreshold);
+  return algo::find_content_bounds(profile, kRatio);
+}
+
+// 每次调用前写一遍大缓冲区把图像挤出缓存，模拟新到的一帧
+void evict_caches(std::vector<uint8_t>& scratch) {
+  for (size_t i = 0; i < scratch.size(); i += 64) {
+    scratch[i] = static_cast<uint8_t>(scratch[i] + 1);
+  }
+}
+
+// 返回每次调用的中位耗时（微秒）
+template <typename Func>
+double median_us(int iterations, std::vector<uint8_t>* scratch,
+                 Func&& func) {
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  for (int i = 0; i < iterations; ++i) {
+    if (scratch) {
+      evict_caches(*scratch);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(end - start).count());
+  }
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                   samples.end());
+  return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int width = argc > 1 ? std::atoi(argv[1]) : 8192;
+  const int height = argc > 2 ? std::atoi(argv[2]) : 2600;
+  const int iterations = argc > 3 ? std::atoi(argv[3]) : 200;
+  const int step = height > 1000 ? 8 : 1;
+
+  // 两侧白边，中间是暗的纹理
+  cv::Mat gray(height, width, CV_8UC1);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> texture(0, 120);
+  const int left_border = width / 11;
+  const int right_border = width / 17;
+  for (int y = 0; y < height; ++y) {
+    uint8_t* row = gray.ptr<uint8_t>(y);
+    for (int x = 0; x < width; ++x) {
+      const bool border = x < left_border || x >= width - right_border;
+      row[x] = static_cast<uint8_t>(border ? 245 : texture(rng));
+    }
+  }
+
+  std::vector<uint32_t> counts;
+  algo::ColumnProfile profile;
+  const auto expected = gather_bounds(gray, step);
+  const auto full = full_profile_bounds(gray, step, counts);
+  const auto actual = block_profile_bounds(gray, step, profile);
+  if (expected != actual || expected != full) {
+    std::printf("mismatch: gather {%d, %d}, full {%d, %d}, block {%d, %d}\n",
+                expected.first, expected.second, full.first, full.second,
+                actual.first, actual.second);
+    return 1;
+  }
+
+  std::printf("%dx%d, row step %d, bounds {%d, %d}\n", width, height, step,
+              actual.first, actual.second);
+  std::printf("%-16s %12s %12s\n", "", "warm (us)", "cold (us)");
+
+  std::vector<uint8_t> scratch(size_t{64} << 20);
+  volatile int sink = 0;
+  auto report = [&](const char* name, auto&& func) {
+    const double warm = median_us(iterations, nullptr, func);
+    const double cold = median_us(iterations, &scratch, func);
+    std::printf("%-16s %12.1f %12.1f\n", name, warm, cold);
+  };
+  report("column gather", [&] { sink = sink + gather_bounds(gray, step).first; });
+  report("full profile", [&] {
+    sink = sink + full_profile_bounds(gray, step, counts).first;
+  });
+  report("block profile", [&] {
+    sink = sink + block_profile_bounds(gray, step, profile).first;
+  });
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: BatchingFrameProcessor.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "FrameProcessor.hpp"
+
+// 攒批参数：攒够 max_frames 帧，或者最早的一帧等待超过 max_delay，就处理一批
+struct BatchingConfig {
+  size_t max_frames = 4;
+  std::chrono::microseconds max_delay{5000};
+};
+
+/**
+ * @brief 把逐帧调用攒成批次交给 inner->process_batch() 的处理器
+ *
+ * 放在 AlgoAdapter 前面，让算法可以在一批帧之间分摊配置快照、
+ * 缓冲区分配等准备工作。攒满时由送入最后一帧的线程直接处理这一批，
+ * 超时的不满批次由内部的定时线程处理，因此 inner 可能被多个线程
+ * 同时调用，批次之间也不保证先后顺序，需要顺序时在外面套
+ * OrderedFrameProcessor。
+ *
+ * 等待中的帧持有帧缓冲的引用，不计入 FramePipeline 的在途帧数，
+ * 停止采集前应调用 flush()。最后一个拷贝析构时会处理剩余的帧。
+ *
+ * 默认不启用，需要时显式套在处理器外面：超时批次在定时线程上运行，
+ * 不占 ProcessingExecutor 的 worker 预算，也不受 lane 的 wait() 约束。
+ */
+class BatchingFrameProcessor : public FrameProcessor {
+ public:
+  struct Stats {
+    uint64_t batches = 0;    // 交给 inner 的批次数
+    uint64_t frames = 0;     // 交给 inner 的帧数
+    uint64_t timed_out = 0;  // 因为等待超时而提前处理的批次数
+  };
+
+  explicit BatchingFrameProcessor(std::shared_ptr<FrameProcessor> inner,
+                                  BatchingConfig cfg = {});
+
+  void process(const CapturedFrame& frame) override;
+  // 上游已经成批时逐帧并入当前批次，批次边界仍由本处理器决定
+  void process_batch(std::span<const CapturedFrame* const> frames) override;
+
+  // 丢帧通知直接转给 inner
+  void on_dropped(uint64_t sequence) override;
+  // 在调用线程上立即处理所有等待中的帧，再让 inner 交付剩余结果
+  void flush() override;
+
+  Stats stats() const;
+  const BatchingConfig& config() const;
+
+ private:
+  class State;
+  // 共享状态，拷贝出来的处理器仍然往同一个批次里攒帧
+  std::shared_ptr<State> state_;
+};
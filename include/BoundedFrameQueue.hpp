@@ -0,0 +1,112 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: BoundedFrameQueue.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "FrameProcessor.hpp"
+#include "concurrentqueue.h"
+#include "protocol/messages.hpp"
+
+// 队列满时的准入策略
+enum class BackpressurePolicy {
+  DropOldest,        // 挤掉最旧的一帧，保证处理的总是最新的图像
+  DropNewest,        // 直接丢弃新到的帧
+  BlockWithTimeout,  // 阻塞生产者直到有空位，超时则丢弃新帧
+  KeepEveryNth,      // 积压时每 N 帧保留一帧（挤掉最旧的），其余丢弃
+};
+
+// 帧准入配置，同时作用于算法处理队列和原始图像队列。
+// 两个队列里的帧都占着缓冲池的 slab，容量之和应当明显小于
+// FrameBufferPool::kDefaultMaxSlabs，否则池满后每帧都要临时分配
+struct FrameAdmissionConfig {
+  BackpressurePolicy policy = BackpressurePolicy::DropOldest;
+  size_t processing_capacity = 16;  // 等待算法处理的最大帧数
+  size_t raw_capacity = 8;  // 原始图像队列的最大帧数，没有消费者时也常驻
+  std::chrono::microseconds block_timeout{20000};
+  uint32_t keep_every_n = 4;
+};
+
+/**
+ * @brief 有界帧队列：在 moodycamel 队列外加一层准入控制
+ *
+ * 只允许一个生产者（相机回调线程）调用 push()，消费者可以有多个，
+ * 也可以绕过本类直接从 queue() 中取帧。容量判断基于 size_approx()，
+ * 允许有一两帧的误差。
+ *
+ * 被拒绝的新帧和被挤掉的旧帧都会交给丢帧回调（在生产者线程上）。
+ */
+class BoundedFrameQueue {
+ public:
+  enum class Admission {
+    Admitted,  // 新帧入队，队列深度 +1
+    Replaced,  // 新帧入队并挤掉了一帧旧帧，队列深度不变
+    Rejected,  // 新帧被丢弃
+  };
+
+  using DropHandler = std::function<void(const CapturedFramePtr& frame)>;
+
+  BoundedFrameQueue(size_t capacity, BackpressurePolicy policy);
+
+  void configure(size_t capacity, const FrameAdmissionConfig& cfg);
+  // 在生产者开始 push() 之前设置
+  void set_drop_handler(DropHandler handler) {
+    on_drop_ = std::move(handler);
+  }
+
+  Admission push(CapturedFramePtr frame);
+  bool try_pop(CapturedFramePtr& frame) { return queue_.try_dequeue(frame); }
+
+  bool full() const { return queue_.size_approx() >= capacity_.load(); }
+  protocol::QueueStats stats() const;
+
+  moodycamel::ConcurrentQueue<CapturedFramePtr>& queue() { return queue_; }
+
+ private:
+  bool wait_for_space() const;
+  Admission replace_oldest(CapturedFramePtr frame);
+  Admission reject(const CapturedFramePtr& frame);
+
+  moodycamel::ConcurrentQueue<CapturedFramePtr> queue_;
+  std::atomic<size_t> capacity_;
+  std::atomic<BackpressurePolicy> policy_;
+  std::atomic<int64_t> block_timeout_us_{20000};
+  std::atomic<uint32_t> keep_every_n_{4};
+  uint32_t pressure_arrivals_ = 0;  // 只在生产者线程中访问
+  DropHandler on_drop_;
+
+  std::atomic<uint64_t> admitted_{0};
+  std::atomic<uint64_t> dropped_oldest_{0};
+  std::atomic<uint64_t> dropped_newest_{0};
+  std::atomic<uint64_t> timed_out_{0};
+  std::atomic<uint64_t> decimated_{0};
+};
@@ -29,7 +29,9 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "DvpCameraCapture.hpp"
@@ -131,8 +133,26 @@ class DvpCameraBuilder {
   DvpCameraBuilder& triggerSource(dvpTriggerSource src);
   DvpCameraBuilder& triggerDelay(double us);
 
+  // === 帧队列背压策略 ===
+  DvpCameraBuilder& backpressure(const FrameAdmissionConfig& admission);
+
+  // === 处理线程预算（来自进程级执行器）===
+  DvpCameraBuilder& workerBudget(size_t workers,
+                                 const std::vector<int>& cpus = {});
+
   // === 回调注册（支持链式注册多个）===
-  DvpCameraBuilder& onFrame(const FrameProcessor& proc);
+  // 每次调用追加一个处理阶段，所有阶段并行处理同一帧
+  DvpCameraBuilder& onFrame(std::shared_ptr<FrameProcessor> proc,
+                            std::string name = {});
+  // 直接传处理器对象（如 AlgoAdapter），按真实类型保存，不会被切片
+  template <typename Processor,
+            typename = std::enable_if_t<std::is_base_of_v<
+                FrameProcessor, std::decay_t<Processor>>>>
+  DvpCameraBuilder& onFrame(Processor&& proc, std::string name = {}) {
+    return onFrame(std::make_shared<std::decay_t<Processor>>(
+                       std::forward<Processor>(proc)),
+                   std::move(name));
+  }
   DvpCameraBuilder& onEvent(DvpEventType event, const DvpEventHandler& handler);
 
   // === 构建并启动 ===
@@ -226,8 +246,15 @@ class DvpCameraBuilder {
     std::optional<dvpTriggerSource> trigger_source;
     std::optional<double> trigger_delay;
 
+    // 背压
+    std::optional<FrameAdmissionConfig> admission;
+
+    // 处理线程预算
+    std::optional<WorkerBudget> worker_budget;
+
     // 回调
-    std::vector<FrameProcessor> frame_processors;
+    std::vector<std::pair<std::string, std::shared_ptr<FrameProcessor>>>
+        frame_processors;
     std::unordered_map<DvpEventType, DvpEventHandler> event_handlers;
   };
 
@@ -28,12 +28,17 @@
 
 #include <memory>
 #include <shared_mutex>
+#include <string>
 
-#include "BS_thread_pool.hpp"
+#include "BoundedFrameQueue.hpp"
 #include "CameraCapture.hpp"
 #include "DvpConfig.hpp"
 #include "DvpEventManager.hpp"
+#include "FrameBufferPool.hpp"
+#include "FramePipeline.hpp"
 #include "FrameProcessor.hpp"
+#include "FrameProcessorChain.hpp"
+#include "ProcessingExecutor.hpp"
 #include "concurrentqueue.h"
 #include "protocol/messages.hpp"
 
@@ -43,43 +48,59 @@ class DvpCameraCapture : public CameraCapture {
   ~DvpCameraCapture() override;
 
   bool start() override;
-  bool start(const FrameProcessor& processor) override;
+  // 追加一个处理阶段后启动
+  bool start(std::shared_ptr<FrameProcessor> processor) override;
   void stop() override;
   void set_config(const CameraConfig& cfg) override;
   void set_roi(int x, int y, int width, int height) override;
 
-  // 获取当前状态
+  // 获取当前状态（包含两个帧队列的准入统计）
   protocol::FrontendStatus get_status() const;
 
+  // 背压策略（线程安全，可在采集过程中修改）
+  void set_admission_config(const FrameAdmissionConfig& cfg);
+
+  // 从进程级执行器申请的 worker 预算，需在 start() 之前设置
+  void set_worker_budget(const WorkerBudget& budget);
+
   // 动态配置（线程安全）
   virtual void set_config(const DvpConfig& cfg);
   virtual DvpConfig get_config() const;
 
   virtual void register_event_handler(DvpEventType event,
                                       DvpEventHandler handler);
-  virtual void add_frame_processor(const FrameProcessor& processor);
   virtual DvpEventManager* get_event_manager() const;
 
-  auto& get_frame_processor() const { return user_processor_; }
+  // 处理阶段：同一帧并行交给所有启用的阶段（线程安全，可在采集中修改）
+  virtual size_t add_frame_processor(std::shared_ptr<FrameProcessor> processor,
+                                     std::string name = {});
+  bool set_frame_processor_enabled(size_t index, bool enabled);
+  bool set_frame_processor_enabled(const std::string& name, bool enabled);
+  const FrameProcessorChain& get_frame_processors() const {
+    return pipeline_.processors();
+  }
 
   // 获取图像队列的引用
-  moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>>& get_frame_queue()
-      override {
-    return frame_queue_;
+  moodycamel::ConcurrentQueue<CapturedFramePtr>& get_frame_queue() override {
+    return pipeline_.frame_queue();
+  }
+
+  // 帧缓冲池统计（用于确认稳态下没有整帧分配）
+  FrameBufferPool::Stats get_frame_pool_stats() const {
+    return pipeline_.frame_pool_stats();
   }
 
 #ifdef SAVE_RESULT_IMAGE_QUEUE
   // 获取结果图像队列的引用
-  moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>>&
-  get_result_queue() {
-    return result_queue_;
+  moodycamel::ConcurrentQueue<CapturedFramePtr>& get_result_queue() {
+    return pipeline_.result_queue();
   }
 #endif
 
  private:
   static int OnFrameCallback([[maybe_unused]] dvpHandle, dvpStreamEvent, void*,
                              dvpFrame*, void*);
-  void process_frame(const dvpFrame& frame, const void* buffer);
+  size_t expected_frame_bytes() const;  // 按当前 ROI/格式估算单帧大小
   void update_camera_params();  // 应用配置到 SDK
   void update_status(const protocol::FrontendStatus& new_status);
   protocol::FrontendStatus current_status_;
@@ -89,14 +110,10 @@ class DvpCameraCapture : public CameraCapture {
   std::shared_ptr<DvpConfig> config_;
   mutable std::shared_mutex config_mutex_;
   mutable std::shared_mutex status_mutex_;
-  moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>> frame_queue_;
 
-// 结果队列
-#ifdef SAVE_RESULT_IMAGE_QUEUE
-  moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>> result_queue_;
-#endif
-
-  BS::thread_pool<> thread_pool_{std::thread::hardware_concurrency()};
-  FrameProcessor user_processor_;  // 用户自定义的帧处理器，目前最多只有一个
   std::unique_ptr<DvpEventManager> event_manager_;
+
+  // 帧缓冲池、两个帧队列、处理 lane 和处理阶段，与回放相机共用。
+  // 放在最后：析构时最先等待处理任务结束
+  FramePipeline pipeline_;
 };
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -78,9 +79,14 @@ class DvpCameraManager {
 
   // 启动所有相机
   void start_all() {
+    // 按相机数量平分处理线程，总数不超过核心数
+    auto executor_cfg = ProcessingExecutor::instance().get_config();
+    executor_cfg.expected_lanes = std::max<size_t>(1, cameras_.size());
+    ProcessingExecutor::instance().configure(executor_cfg);
+
     for (auto& cam : cameras_) {
       // 我们这里直接启动，我们已经在builder中设置了他们的帧处理器
-      if (!cam->start(cam->get_frame_processor())) {
+      if (!cam->start()) {
         // 可选：记录失败，或抛异常
         std::cerr << "Failed to start camera\n";
       }
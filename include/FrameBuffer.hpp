@@ -0,0 +1,82 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameBuffer.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+/**
+ * @brief 对齐的帧数据缓冲区
+ *
+ * 与 std::vector<uint8_t> 的区别：
+ * - 起始地址按 kAlignment 对齐，容量向上取整到 kAlignment 的倍数，
+ *   SIMD 代码可以安全地读到最后一个完整的向量
+ * - 扩容和 resize_uninitialized() 不会把新内容清零
+ * - clear() 只把 size 置零，容量保留，供帧缓冲池复用
+ */
+class FrameBuffer {
+ public:
+  static constexpr size_t kAlignment = 64;
+
+  FrameBuffer() = default;
+  FrameBuffer(const FrameBuffer& other);
+  FrameBuffer& operator=(const FrameBuffer& other);
+  FrameBuffer(FrameBuffer&& other) noexcept;
+  FrameBuffer& operator=(FrameBuffer&& other) noexcept;
+  ~FrameBuffer() = default;
+
+  // 保证容量至少为 bytes，已有内容保留
+  void reserve(size_t bytes);
+  // 改变 size，新增部分内容未定义
+  void resize_uninitialized(size_t bytes);
+  void clear() noexcept { size_ = 0; }
+
+  void assign(const uint8_t* first, const uint8_t* last);
+  void assign(size_t count, uint8_t value);
+
+  uint8_t* data() noexcept { return storage_.get(); }
+  const uint8_t* data() const noexcept { return storage_.get(); }
+  size_t size() const noexcept { return size_; }
+  size_t capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const uint8_t* begin() const noexcept { return data(); }
+  const uint8_t* end() const noexcept { return data() + size_; }
+
+ private:
+  struct AlignedDelete {
+    void operator()(uint8_t* ptr) const noexcept {
+      ::operator delete(ptr, std::align_val_t{kAlignment});
+    }
+  };
+
+  std::unique_ptr<uint8_t, AlignedDelete> storage_;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+};
@@ -0,0 +1,94 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameBufferPool.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "FrameProcessor.hpp"
+#include "concurrentqueue.h"
+
+/**
+ * @brief 帧缓冲池：以固定大小的 slab 循环复用 CapturedFrame
+ *
+ * 相机回调线程从池中取出一帧，只从 SDK 缓冲区拷贝一次数据，之后以
+ * shared_ptr 的形式在算法路径和原始图像队列之间共享。最后一个引用释放时
+ * 帧自动归还到池中，稳态下不会再有整帧大小的堆分配。
+ *
+ * @note 必须通过 create() 以 shared_ptr 持有；池先于帧析构时，
+ * 帧会在释放时直接 delete，不会访问已经销毁的池。
+ */
+class FrameBufferPool : public std::enable_shared_from_this<FrameBufferPool> {
+ public:
+  struct Stats {
+    size_t slab_bytes = 0;   // 当前 slab 大小（字节）
+    size_t total_slabs = 0;  // 池已创建的 slab 数量
+    size_t free_slabs = 0;   // 空闲 slab 数量（近似值）
+    size_t overflow = 0;     // 超出上限后临时分配（不回收）的帧数
+  };
+
+  // 默认的 slab 上限。按默认容量，处理队列 16 + 原始队列 8 +
+  // 录像队列 16 之外，还有 24 个留给 worker 上正在处理的帧；
+  // 调大这些队列时要同步调大上限
+  static constexpr size_t kDefaultMaxSlabs = 64;
+
+  static std::shared_ptr<FrameBufferPool> create(
+      size_t slab_bytes = 0, size_t max_slabs = kDefaultMaxSlabs);
+
+  ~FrameBufferPool();
+  FrameBufferPool(const FrameBufferPool&) = delete;
+  FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+  /**
+   * @brief 按相机 ROI/格式设定 slab 大小，并可预先分配若干 slab
+   * @param slab_bytes 单帧字节数（宽 x 高 x 每像素字节）
+   * @param prealloc 预分配数量，避免采集刚开始时在回调线程里分配
+   */
+  void reserve(size_t slab_bytes, size_t prealloc = 0);
+
+  /**
+   * @brief 取出一帧，data 的容量至少为 bytes
+   *
+   * data 的内容未定义，调用方负责写入（通常是一次 assign）。
+   */
+  std::shared_ptr<CapturedFrame> acquire(size_t bytes);
+
+  Stats stats() const;
+
+ private:
+  FrameBufferPool(size_t slab_bytes, size_t max_slabs);
+
+  CapturedFrame* make_slab(size_t bytes) const;
+  void recycle(CapturedFrame* frame) noexcept;
+
+  moodycamel::ConcurrentQueue<CapturedFrame*> free_list_;
+  std::atomic<size_t> slab_bytes_;
+  std::atomic<size_t> total_slabs_{0};
+  std::atomic<size_t> overflow_{0};
+  const size_t max_slabs_;
+};
@@ -0,0 +1,161 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameFile.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "FrameProcessor.hpp"
+
+/**
+ * 原始帧录像格式（*.dvpr），每个文件是一个分段：
+ *
+ *   FrameFileHeader                      64 字节
+ *   { FrameRecordHeader | 图像数据 }*    每条记录的起点按 64 字节对齐
+ *
+ * 记录头里直接保存完整的 dvpFrame，回放时帧的元信息与采集时一致。
+ * 记录是自描述的，没有索引也能顺序读出；文件末尾被截断的记录会被忽略。
+ *
+ * 每个分段旁边有一个同名的索引文件（*.dvpi）：
+ *
+ *   FrameIndexHeader                     64 字节
+ *   FrameIndexEntry[count]               每帧 32 字节
+ */
+namespace frame_file {
+
+inline constexpr char kMagic[8] = {'D', 'V', 'P', 'R', 'E', 'C', '\0', '\0'};
+inline constexpr uint32_t kVersion = 1;
+inline constexpr uint32_t kRecordMagic = 0x52465644;  // "DVFR"
+inline constexpr size_t kRecordAlignment = 64;
+inline constexpr const char* kExtension = ".dvpr";
+inline constexpr char kIndexMagic[8] = {'D', 'V', 'P', 'I', 'D', 'X', '\0',
+                                        '\0'};
+inline constexpr const char* kIndexExtension = ".dvpi";
+
+struct FrameFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t meta_bytes;  // sizeof(dvpFrame)，SDK 结构不一致时拒绝读取
+  uint32_t segment;     // 分段序号，从 0 开始
+  uint8_t reserved[44];
+};
+static_assert(sizeof(FrameFileHeader) == kRecordAlignment);
+
+struct FrameRecordHeader {
+  uint32_t magic;
+  uint32_t reserved;
+  uint64_t sequence;       // 采集时的帧序号
+  uint64_t payload_bytes;  // 图像数据字节数（不含对齐填充）
+  dvpFrame meta;
+};
+
+struct FrameIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t segment;
+  uint64_t count;  // 有效的索引项数，写完索引项之后才更新
+  uint8_t reserved[40];
+};
+static_assert(sizeof(FrameIndexHeader) == kRecordAlignment);
+
+struct FrameIndexEntry {
+  uint64_t offset;  // 记录在分段文件中的起始位置
+  uint64_t sequence;
+  uint64_t frame_id;
+  uint64_t timestamp_us;
+};
+static_assert(sizeof(FrameIndexEntry) == 32);
+
+constexpr size_t align_up(size_t bytes) {
+  return (bytes + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+// 记录头占用的字节数（含对齐填充）
+constexpr size_t record_header_bytes() {
+  return align_up(sizeof(FrameRecordHeader));
+}
+
+// 一条记录占用的总字节数
+constexpr size_t record_bytes(size_t payload_bytes) {
+  return record_header_bytes() + align_up(payload_bytes);
+}
+
+FrameFileHeader make_file_header(uint32_t segment);
+FrameIndexHeader make_index_header(uint32_t segment);
+bool is_valid(const FrameFileHeader& header);
+// 记录头的魔数正确，payload_bytes 与 meta 的宽 × 高 × 每像素字节数一致，
+// 并且不超过分段中剩余的字节数
+bool is_valid(const FrameRecordHeader& record, uint64_t remaining_bytes);
+
+// <directory>/<prefix>_000042.dvpr
+std::string segment_path(const std::string& directory,
+                         const std::string& prefix, uint32_t segment);
+// 分段对应的索引文件路径
+std::string index_path(const std::string& segment_path);
+// 读出分段的索引，没有索引或索引无效时返回空
+std::vector<FrameIndexEntry> load_index(const std::string& segment_path);
+
+// 按路径排序列出目录下的录像分段；path 本身是 .dvpr 文件时只返回它
+std::vector<std::string> list_segments(const std::string& path);
+
+}  // namespace frame_file
+
+/**
+ * @brief 顺序读取一个或多个录像分段
+ *
+ * 图像数据直接读进帧的 FrameBuffer，不经过中间缓冲区。
+ */
+class FrameFileReader {
+ public:
+  FrameFileReader() = default;
+  explicit FrameFileReader(std::vector<std::string> segments);
+
+  // 打开一组分段（按给定顺序读取），第一个分段无效时返回 false
+  bool open(std::vector<std::string> segments);
+  void close();
+  bool is_open() const { return file_.is_open(); }
+
+  // 读出下一帧，所有分段都读完时返回 false
+  bool next(CapturedFrame& frame);
+  // 回到第一个分段的第一帧
+  bool rewind();
+
+  const std::vector<std::string>& segments() const { return segments_; }
+
+ private:
+  bool open_segment(size_t index);
+  // 当前分段在读取位置之后还剩的字节数
+  uint64_t remaining_bytes();
+
+  std::vector<std::string> segments_;
+  size_t current_ = 0;
+  uint64_t segment_bytes_ = 0;
+  std::ifstream file_;
+};
@@ -0,0 +1,135 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePipeline.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "BoundedFrameQueue.hpp"
+#include "FrameBufferPool.hpp"
+#include "FrameProcessor.hpp"
+#include "FrameProcessorChain.hpp"
+#include "ProcessingExecutor.hpp"
+#include "concurrentqueue.h"
+
+/**
+ * @brief 与相机品牌无关的帧处理管线
+ *
+ * 帧缓冲池 -> 编号 -> 处理队列（lane 上并行执行处理阶段）
+ *                  -> 原始图像队列（外部消费者）
+ *
+ * 真实相机和回放相机都只负责产生帧，之后的路径完全相同。
+ * acquire()/publish()/submit() 只允许一个生产者线程调用。
+ */
+class FramePipeline {
+ public:
+  FramePipeline();
+  ~FramePipeline();
+
+  FramePipeline(const FramePipeline&) = delete;
+  FramePipeline& operator=(const FramePipeline&) = delete;
+
+  // 采集开始前调用：按单帧字节数预分配缓冲池，并申请处理 lane
+  void prepare(size_t frame_bytes);
+  // 等待已提交的处理任务全部结束（lane 保留）
+  void wait_idle();
+  // 等待已提交的处理任务结束并归还 lane，然后让处理阶段交付剩余结果
+  void shutdown();
+
+  // 从缓冲池取一帧，调用方填写 meta 和 data 后 publish()
+  std::shared_ptr<CapturedFrame> acquire(size_t bytes) {
+    return frame_pool_->acquire(bytes);
+  }
+  // 编号并送入两个队列
+  void publish(std::shared_ptr<CapturedFrame> frame);
+  // acquire + 一次拷贝 + publish
+  void submit(const dvpFrame& meta, const void* buffer);
+
+  // 原始队列进入/离开饱和状态时回调（在生产者线程上）
+  void set_raw_saturation_handler(std::function<void(bool saturated)> handler) {
+    on_raw_saturation_ = std::move(handler);
+  }
+
+  void set_admission_config(const FrameAdmissionConfig& cfg);
+  // 下次 prepare() 时生效
+  void set_worker_budget(const WorkerBudget& budget);
+
+  size_t add_frame_processor(std::shared_ptr<FrameProcessor> processor,
+                             std::string name = {});
+  FrameProcessorChain& processors() { return processors_; }
+  const FrameProcessorChain& processors() const { return processors_; }
+
+  moodycamel::ConcurrentQueue<CapturedFramePtr>& frame_queue() {
+    return raw_queue_.queue();
+  }
+  protocol::QueueStats processing_queue_stats() const {
+    return processing_queue_.stats();
+  }
+  protocol::QueueStats raw_queue_stats() const { return raw_queue_.stats(); }
+  FrameBufferPool::Stats frame_pool_stats() const {
+    return frame_pool_->stats();
+  }
+
+#ifdef SAVE_RESULT_IMAGE_QUEUE
+  moodycamel::ConcurrentQueue<CapturedFramePtr>& result_queue() {
+    return result_queue_;
+  }
+#endif
+
+ private:
+  // lane 任务：从处理队列中取一帧处理，其余阶段提交到同一条 lane
+  void process_pending_frame(ProcessingExecutor::Lane& lane);
+  // 取走 lane_ 并等待其中的任务全部结束，之后才释放
+  void release_lane();
+
+  // 两个队列使用同一套准入策略：处理队列限制线程池积压的任务数，
+  // 原始队列限制外部消费者跟不上时的内存占用
+  BoundedFrameQueue processing_queue_{16, BackpressurePolicy::DropOldest};
+  BoundedFrameQueue raw_queue_{8, BackpressurePolicy::DropOldest};
+  std::atomic<bool> raw_queue_saturated_{false};
+  std::function<void(bool)> on_raw_saturation_;
+  uint64_t next_sequence_ = 0;  // 只在生产者线程中访问
+
+#ifdef SAVE_RESULT_IMAGE_QUEUE
+  moodycamel::ConcurrentQueue<CapturedFramePtr> result_queue_;
+#endif
+
+  std::shared_ptr<FrameBufferPool> frame_pool_ = FrameBufferPool::create();
+  FrameProcessorChain processors_;  // 用户注册的处理阶段
+
+  // 处理线程来自进程级执行器，多个相机共享核心预算。
+  // lane_ 由生产者线程和 shutdown()/set_worker_budget() 的调用线程
+  // 共同访问，用 lane_mutex_ 保护；任务只持有提交时的 lane
+  std::mutex lane_mutex_;
+  WorkerBudget worker_budget_;
+  std::shared_ptr<ProcessingExecutor::Lane> lane_;
+};
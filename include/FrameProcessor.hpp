@@ -26,20 +26,37 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "DvpCamera.h"
+#include "FrameBuffer.hpp"
+#include "PixelFormat.hpp"
 
 struct FrameMetadata {};
 
 // 帧数据结构,无关于相机类型
-struct CapturedFrame {
-  std::vector<uint8_t> data;  // 图像数据
+// 由 shared_ptr 管理时，后续阶段可以通过 shared_from_this() 延长帧的生命周期
+struct CapturedFrame : std::enable_shared_from_this<CapturedFrame> {
+  FrameBuffer data;  // 图像数据（64 字节对齐，不做零初始化）
+
+  // 采集时打上的单调递增序号，丢帧会留下缺口
+  uint64_t sequence = 0;
+
+  // 由 meta 推出的像素格式和每行字节数，见 update_layout()
+  PixelFormat pixel_format = PixelFormat::Unknown;
+  size_t stride = 0;
+
   // TODO 未来需要用union来存储来自不同相机的元信息
-  dvpFrame meta;  // 完整元信息（宽/高/格式/曝光等）
+  dvpFrame meta{};  // 完整元信息（宽/高/格式/曝光等）
+
+  // 基类的构造函数是 protected，需要显式声明才能写 CapturedFrame{}
+  CapturedFrame() = default;
 
   // 便捷访问
   int width() const { return meta.iWidth; }
@@ -47,7 +64,30 @@ struct CapturedFrame {
   int format() const { return meta.format; }
   double exposure_us() const { return meta.fExposure; }
   double timestamp_us() const { return static_cast<double>(meta.uTimestamp); }
+
+  // 根据 meta 填写 pixel_format 和 stride（SDK 输出的行是紧密排列的）
+  void update_layout() {
+    pixel_format = pixel_format_from_frame(meta.format, meta.bits);
+    const size_t packed = static_cast<size_t>(meta.iWidth) *
+                          bytes_per_pixel(pixel_format);
+    const size_t rows = meta.iHeight > 0 ? static_cast<size_t>(meta.iHeight)
+                                         : 1;
+    stride = packed > 0 ? packed : meta.uBytes / rows;
+  }
 };
+
+// 帧在算法路径和原始图像队列之间按引用共享，共享后不允许再修改
+using CapturedFramePtr = std::shared_ptr<const CapturedFrame>;
+
+// 在处理阶段中延长帧的生命周期：帧由 shared_ptr 管理时直接共享，
+// 否则（例如栈上的测试帧）只能拷贝
+inline CapturedFramePtr retain_frame(const CapturedFrame& frame) {
+  if (auto shared = frame.weak_from_this().lock()) {
+    return shared;
+  }
+  return std::make_shared<CapturedFrame>(frame);
+}
+
 // 帧处理器接口
 class FrameProcessor {
  public:
@@ -57,6 +97,21 @@ class FrameProcessor {
     // 默认空实现
   }
 
+  // 一次处理多帧（按到达顺序），默认逐帧调用 process()；
+  // 能在多帧之间分摊准备工作的处理器可以重写
+  virtual void process_batch(std::span<const CapturedFrame* const> frames) {
+    for (const CapturedFrame* frame : frames) {
+      process(*frame);
+    }
+  }
+
+  // 已编号的帧在进入处理器之前被准入控制丢弃（在生产者线程上调用），
+  // 按序号等待结果的处理器据此跳过缺口
+  virtual void on_dropped(uint64_t sequence) {}
+
+  // 采集停止、所有帧都处理完之后调用，交付内部还在等待的结果
+  virtual void flush() {}
+
   // 添加默认构造函数以允许赋值
   FrameProcessor() = default;
   // 添加拷贝构造函数和赋值操作符
@@ -81,3 +136,9 @@ template <typename Func>
 FunctionFrameProcessor<Func> make_function_processor(Func func) {
   return FunctionFrameProcessor<Func>(std::move(func));
 }
+
+// 同上，直接返回可注册为处理阶段的 shared_ptr
+template <typename Func>
+std::shared_ptr<FrameProcessor> make_shared_function_processor(Func func) {
+  return std::make_shared<FunctionFrameProcessor<Func>>(std::move(func));
+}
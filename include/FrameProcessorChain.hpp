@@ -0,0 +1,90 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameProcessorChain.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "FrameProcessor.hpp"
+
+/**
+ * @brief 帧处理阶段列表
+ *
+ * 每个阶段是一个 shared_ptr<FrameProcessor>，保留派生类的真实类型，
+ * 同一帧（只读、共享）可以同时交给多个阶段并行处理，不会重复拷贝。
+ *
+ * 阶段列表采用写时复制：增删阶段、启用/禁用时生成新列表，
+ * 处理线程每帧只取一次快照，不会与修改操作互相阻塞。
+ */
+class FrameProcessorChain {
+ public:
+  struct Stage {
+    std::string name;
+    std::shared_ptr<FrameProcessor> processor;
+    bool enabled = true;
+  };
+  using StageList = std::vector<Stage>;
+  using Spawn = std::function<void(std::function<void()>)>;
+  using Done = std::function<void(const CapturedFramePtr&)>;
+
+  // 追加一个阶段，返回阶段下标
+  size_t add(std::shared_ptr<FrameProcessor> processor, std::string name = {});
+  void clear();
+
+  bool set_enabled(size_t index, bool enabled);
+  bool set_enabled(const std::string& name, bool enabled);
+
+  std::shared_ptr<const StageList> snapshot() const;
+  size_t size() const;
+  bool contains(const std::shared_ptr<FrameProcessor>& processor) const;
+
+  // 在调用线程上依次执行所有启用的阶段
+  void process(const CapturedFrame& frame) const;
+  // 通知所有启用的阶段：该序号的帧被丢弃，不会再到达
+  void notify_dropped(uint64_t sequence) const;
+  // 让所有阶段交付内部等待中的结果
+  void flush() const;
+
+  /**
+   * @brief 把一帧分发给所有启用的阶段
+   * @param spawn 用于把其余阶段提交到其他 worker
+   * @param done  所有阶段都结束后调用一次（在最后结束的线程上）
+   *
+   * 第一个阶段在调用线程上执行，其余阶段通过 spawn 并行执行。
+   */
+  void fan_out(const CapturedFramePtr& frame, const Spawn& spawn,
+               Done done = {}) const;
+
+ private:
+  mutable std::shared_mutex mutex_;
+  std::shared_ptr<const StageList> stages_ = std::make_shared<StageList>();
+};
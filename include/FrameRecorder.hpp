@@ -0,0 +1,117 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameRecorder.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "FrameFile.hpp"
+#include "FrameProcessor.hpp"
+#include "concurrentqueue.h"
+#include "utils/mapped_file.h"
+
+// 录像参数
+struct RecorderConfig {
+  std::string directory;          // 分段文件所在目录，不存在时自动创建
+  std::string prefix = "roll";    // 分段文件名前缀
+  size_t segment_bytes = size_t{1} << 30;  // 单个分段的上限
+  size_t index_capacity = 1 << 16;         // 单个分段最多记录的帧数
+  // 等待写盘的最大帧数，超过时丢帧而不是阻塞。排队的帧占着缓冲池的 slab，
+  // 池满之后相机每帧都要临时分配；默认值计入
+  // FrameBufferPool::kDefaultMaxSlabs 的预算，调大时要同步调大池的上限
+  size_t queue_capacity = 16;
+};
+
+/**
+ * @brief 原始帧录像阶段
+ *
+ * 作为处理阶段注册到相机上：process() 只持有帧的引用并入队，
+ * 由专用的 I/O 线程把图像数据和完整的 dvpFrame 拷进内存映射的分段文件，
+ * 同时写对应的索引文件。分段写满（字节数或帧数）时换到下一个分段。
+ *
+ * 稳态下没有逐帧的内存分配：队列按容量预分配，文件按分段预先扩展并映射。
+ * 写盘跟不上时新帧被丢弃并计数，不会拖慢处理线程。
+ * 多个 worker 并行调用 process() 时，文件中的顺序是入队顺序，
+ * 记录里的 sequence 仍是采集序号。
+ */
+class FrameRecorder : public FrameProcessor {
+ public:
+  struct Stats {
+    uint64_t frames = 0;    // 已写入的帧数
+    uint64_t bytes = 0;     // 已写入的图像数据字节数
+    uint64_t dropped = 0;   // 队列满、单帧超过分段上限或写盘失败而丢弃的帧数
+    uint32_t segments = 0;  // 已创建的分段数
+    bool failed = false;    // 创建分段失败，之后的帧全部丢弃
+  };
+
+  explicit FrameRecorder(RecorderConfig config);
+  ~FrameRecorder() override;
+
+  FrameRecorder(const FrameRecorder&) = delete;
+  FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+  // 启动 I/O 线程，第一帧到达时才创建分段
+  bool start();
+  // 写完队列中剩余的帧，截断并关闭当前分段
+  void stop();
+  bool is_recording() const { return recording_.load(); }
+
+  void process(const CapturedFrame& frame) override;
+
+  Stats stats() const;
+
+ private:
+  void io_loop();
+  void write_record(const CapturedFrame& frame);
+  bool open_segment();
+  void close_segment();
+
+  RecorderConfig config_;
+
+  moodycamel::ConcurrentQueue<CapturedFramePtr> queue_;
+  std::atomic<size_t> queued_{0};
+  // I/O 线程等待的事件计数：入队和 stop() 时递增并唤醒
+  std::atomic<uint32_t> signal_{0};
+  std::atomic<bool> recording_{false};
+  std::thread io_thread_;
+
+  // 以下只在 I/O 线程中访问
+  DvpUtils::MappedFile segment_;
+  DvpUtils::MappedFile index_;
+  size_t offset_ = 0;       // 当前分段已写入的字节数
+  size_t index_count_ = 0;  // 当前分段已写入的帧数
+  uint32_t next_segment_ = 0;
+
+  std::atomic<uint64_t> frames_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint32_t> segments_{0};
+  std::atomic<bool> failed_{false};
+};
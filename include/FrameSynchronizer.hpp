@@ -0,0 +1,128 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameSynchronizer.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FrameProcessor.hpp"
+
+// 多相机帧按什么配对
+enum class SyncKey {
+  Timestamp,  // meta.uTimestamp，容差单位与时间戳相同（us）
+  FrameId,    // meta.uFrameID，适合硬触发、各相机帧号一致的场合
+};
+
+// 超时后仍凑不齐一组时的处理方式
+enum class PartialPolicy {
+  Drop,  // 丢弃已到的帧
+  Emit,  // 用已到的帧交付，缺的位置为空
+};
+
+struct SyncOptions {
+  SyncKey key = SyncKey::Timestamp;
+  uint64_t tolerance = 500;      // 同一组内最大、最小键值之差的上限
+  size_t ring_capacity = 8;     // 每台相机缓存的帧数，满了丢最旧的
+  size_t max_pending_sets = 4;  // 等待融合的组数，满了丢最旧的
+  std::chrono::milliseconds timeout{100};  // 一组中最早的帧最多等多久
+  PartialPolicy partial_policy = PartialPolicy::Drop;
+};
+
+/**
+ * @brief 按时间戳或帧号把多台相机的帧配成一组
+ *
+ * push() 可以在各相机的处理线程上并发调用，只在锁内做入环和配对；
+ * 配好的组由专用线程交给 handler，handler 不持有任何锁，慢融合只会
+ * 让等待融合的组被丢弃，不会阻塞相机。
+ *
+ * 每台相机的帧按到达顺序键值递增：所有相机都有帧时，若队首键值之差
+ * 在容差内就配成一组；否则键值最小的队首不可能再配上，直接丢弃。
+ * 有相机迟迟没有帧时，最早的队首等待超过 timeout 后按 partial_policy 处理。
+ */
+class FrameSynchronizer {
+ public:
+  // 按相机下标排列，部分交付时缺的位置为空
+  using FrameSet = std::vector<CapturedFramePtr>;
+  using SetHandler = std::function<void(FrameSet&& frames)>;
+
+  struct Stats {
+    uint64_t matched = 0;        // 完整配对的组数
+    uint64_t partial = 0;        // 超时后部分交付的组数
+    uint64_t timed_out = 0;      // 超时后丢弃的帧数
+    uint64_t unmatched = 0;      // 找不到同组帧而丢弃的帧数
+    uint64_t ring_overflow = 0;  // 相机缓存满而丢弃的帧数
+    uint64_t set_overflow = 0;   // 融合跟不上而丢弃的组数
+    uint64_t handler_errors = 0;  // 回调抛出异常的组数
+  };
+
+  FrameSynchronizer(size_t num_cams, SyncOptions options, SetHandler handler);
+  // 交付已经配好的组后退出，凑不齐的帧直接丢弃
+  ~FrameSynchronizer();
+
+  FrameSynchronizer(const FrameSynchronizer&) = delete;
+  FrameSynchronizer& operator=(const FrameSynchronizer&) = delete;
+
+  size_t camera_count() const { return rings_.size(); }
+
+  void push(size_t cam_index, CapturedFramePtr frame);
+
+  Stats stats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    CapturedFramePtr frame;
+    uint64_t key = 0;
+    Clock::time_point arrival;
+  };
+
+  uint64_t key_of(const CapturedFrame& frame) const;
+  // 以下在 mutex_ 内调用
+  void match_locked(Clock::time_point now);
+  void expire_locked(Clock::time_point now);
+  void enqueue_set_locked(FrameSet&& set);
+  void run();
+
+  const SyncOptions options_;
+  SetHandler handler_;
+
+  std::vector<std::deque<Entry>> rings_;
+  std::deque<FrameSet> ready_;
+  Stats stats_;
+  bool stopping_ = false;
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::thread worker_;
+};
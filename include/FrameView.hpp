@@ -0,0 +1,59 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameView.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <opencv2/core/mat.hpp>
+
+#include "FrameProcessor.hpp"
+
+// PixelFormat 对应的 OpenCV 类型，Unknown 返回 -1
+int cv_type_of(PixelFormat format);
+
+/**
+ * @brief 帧数据的零拷贝 cv::Mat 视图
+ *
+ * 按 pixel_format 选择类型（MONO/BAYER 为单通道，BGR24 为 CV_8UC3，
+ * BGR32 为 CV_8UC4，16 位格式对应 CV_16U），按 stride 指定行步长。
+ * 视图不持有数据，使用期间必须保证帧存活；格式未知时返回空 Mat。
+ */
+cv::Mat frame_view(const CapturedFrame& frame);
+
+/**
+ * @brief 取 8 位灰度图
+ *
+ * Mono8 直接返回零拷贝视图；其他格式按实际格式做一次转换
+ * （Bayer 去马赛克、BGR/BGRA/RGB/RGBA 转灰度、16 位缩放到 8 位）。
+ */
+cv::Mat frame_to_gray8(const CapturedFrame& frame);
+
+/**
+ * @brief 同上，但需要转换时写入 scratch，尺寸不变时复用它的缓冲区
+ *
+ * 返回值与 scratch 共享数据，下一次转换会覆盖上一次的结果；
+ * 结果被其他地方（例如异步写盘队列）引用时不能复用同一个 scratch。
+ */
+cv::Mat frame_to_gray8(const CapturedFrame& frame, cv::Mat& scratch);
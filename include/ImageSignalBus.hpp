@@ -26,7 +26,11 @@
 
 // ImageSignalBus.hpp
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -35,9 +39,37 @@
 // cv
 #include <opencv2/core/mat.hpp>
 
+#include "SignalMailbox.hpp"
+
+/**
+ * @brief 算法与 UI/通信模块之间的信号总线
+ *
+ * 图像信号每次发送最多深拷贝一次，所有订阅者共享同一份只读图像
+ * （SharedImage）；没有订阅者时不拷贝。订阅者需要修改图像时自己 clone()。
+ *
+ * 每个订阅可以选择送达方式（SubscriptionOptions）：默认 Inline 在发送线程
+ * 上直接回调；写盘、网络这类慢订阅者应当用 Queued 或 LatestOnly，回调在
+ * 订阅者自己的线程上执行，发送方只做一次入队。订阅表按写时复制维护，
+ * 回调期间不持有任何锁。
+ *
+ * 图像信号声明后得到 SignalHandle，按句柄发送只是从平铺数组里取一次
+ * 订阅表快照，不做名字查找，也不碰 mutex_；快照存在 atomic<shared_ptr>
+ * 中，它在 libstdc++ 和 MSVC 上不是无锁的，读取时内部会短暂加锁。
+ * 按名字发送的接口保留，每次多一次带锁的名字查找。
+ *
+ * 取消订阅时被移除的信箱在订阅方线程上关闭（送完已入箱的消息），
+ * 发送方手里的旧快照随后释放，不会在算法线程上等待慢订阅者。
+ *
+ * 预览订阅（subscribe_preview）限速并缩小图像：同一次发送里相同目标尺寸
+ * 的订阅者共享一次缩放的结果，所有订阅者的限速窗口都没到时不生成图像。
+ */
 class ImageSignalBus {
  public:
+  // 发送后不再修改的图像，由所有订阅者共享
+  using SharedImage = std::shared_ptr<const cv::Mat>;
+  // 收到的 Mat 与其他订阅者共享数据，只读；保留 Mat 头即可延长生命周期
   using ImageCallback = std::function<void(const cv::Mat&)>;
+  using SharedImageCallback = std::function<void(const SharedImage&)>;
 
   struct FeatureData {
     std::string roll_id;
@@ -61,29 +93,164 @@ class ImageSignalBus {
     return bus;
   }
 
-  // 算法调用：声明自己能提供哪些信号
-  void declare_signal(const std::string& signal_name);
+  // 图像信号的句柄，同一个名字总是得到同一个句柄，进程内不会失效
+  struct SignalHandle {
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+    uint32_t index = kInvalid;
+
+    bool valid() const { return index != kInvalid; }
+  };
+
+  // 最多可以声明的图像信号数
+  static constexpr size_t kMaxSignals = 256;
+
+  // 算法调用：声明自己能提供哪些信号，已经声明过的直接返回原句柄；
+  // 超过 kMaxSignals 时抛出 std::length_error
+  SignalHandle declare_signal(const std::string& signal_name);
+  // 未声明过的信号返回无效句柄
+  SignalHandle find_signal(const std::string& signal_name) const;
+
+  // 订阅句柄，用于取消订阅和查询统计；回调为空时返回 0
+  using SubscriptionId = uint64_t;
+
+  struct SubscriberStats {
+    SubscriptionId id = 0;
+    std::string signal;
+    DeliveryMode mode = DeliveryMode::Inline;
+    MailboxStats mailbox;
+  };
+
+  // 预览订阅的选项
+  struct PreviewOptions {
+    cv::Size max_size;      // 按宽高比缩小到不超过这个尺寸，空表示原尺寸
+    double max_fps = 15.0;  // 0 表示不限速
+    DeliveryMode mode = DeliveryMode::LatestOnly;
+  };
 
   // UI 或其他模块调用：订阅某个信号
-  void subscribe(const std::string& signal_name, ImageCallback callback);
+  SubscriptionId subscribe(const std::string& signal_name,
+                           ImageCallback callback,
+                           SubscriptionOptions options = {});
+  SubscriptionId subscribe_shared(const std::string& signal_name,
+                                  SharedImageCallback callback,
+                                  SubscriptionOptions options = {});
+  SubscriptionId subscribe(SignalHandle signal, ImageCallback callback,
+                           SubscriptionOptions options = {});
+  SubscriptionId subscribe_shared(SignalHandle signal,
+                                  SharedImageCallback callback,
+                                  SubscriptionOptions options = {});
+
+  // 客户端预览：限速、缩小后的图像
+  SubscriptionId subscribe_preview(const std::string& signal_name,
+                                   ImageCallback callback,
+                                   const PreviewOptions& options);
+  SubscriptionId subscribe_preview(SignalHandle signal, ImageCallback callback,
+                                   const PreviewOptions& options);
+
+  // 取消订阅。Queued/LatestOnly 订阅会先送完已经入箱的消息；
+  // 不要在该订阅自己的回调里取消它
+  bool unsubscribe(SubscriptionId id);
 
-  // 算法内部调用：广播图像（自动深拷贝）
+  // 所有订阅的送达、丢弃和延迟统计
+  std::vector<SubscriberStats> subscriber_stats() const;
+
+  // 信号当前是否有订阅者要图像（限速的订阅者要等窗口到了才算），
+  // 调试图可以据此决定是否生成
+  bool has_subscribers(const std::string& signal_name) const;
+  bool has_subscribers(SignalHandle signal) const;
+
+  // 算法内部调用：广播图像。有订阅者时深拷贝一次，所有订阅者共享
   void emit(const std::string& signal_name, const cv::Mat& img);
+  void emit(SignalHandle signal, const cv::Mat& img);
+  // 调用方保证 img 之后不再被修改，不拷贝
+  void emit(const std::string& signal_name, SharedImage img);
+  void emit(SignalHandle signal, SharedImage img);
+
+  // 有订阅者时才调用 make_image() 生成图像，生成的图像直接共享，不拷贝
+  template <typename MakeImage>
+  void emit_if_subscribed(const std::string& signal_name,
+                          MakeImage&& make_image) {
+    emit_if_subscribed(find_signal(signal_name),
+                       std::forward<MakeImage>(make_image));
+  }
+  template <typename MakeImage>
+  void emit_if_subscribed(SignalHandle signal, MakeImage&& make_image) {
+    if (has_subscribers(signal)) {
+      emit(signal, std::make_shared<const cv::Mat>(
+                       std::forward<MakeImage>(make_image)()));
+    }
+  }
   // 与服务器之间通信：订阅特征和状态
-  void subscribe_feature(const std::string& name, FeatureCallback cb);
-  void subscribe_status(const std::string& name, StatusCallback cb);
+  SubscriptionId subscribe_feature(const std::string& name, FeatureCallback cb,
+                                   SubscriptionOptions options = {});
+  SubscriptionId subscribe_status(const std::string& name, StatusCallback cb,
+                                  SubscriptionOptions options = {});
   void emit_feature(const std::string& name, const FeatureData& data);
   void emit_status(const std::string& name, const StatusData& data);
 
  private:
+  template <typename T>
+  struct Subscription {
+    SubscriptionId id = 0;
+    std::shared_ptr<SignalMailbox<T>> mailbox;
+    cv::Size preview_size;  // 只用于图像信号，空表示原尺寸
+  };
+  // 订阅表的一份只读快照，修改时整体替换
+  template <typename T>
+  using SubscriberList = std::shared_ptr<const std::vector<Subscription<T>>>;
+  template <typename T>
+  using Channel = std::unordered_map<std::string, SubscriberList<T>>;
+
   ImageSignalBus() = default;
-  // 图像信号
-  std::unordered_map<std::string, std::vector<ImageCallback>> subscribers_;
+
+  template <typename T>
+  Subscription<T> make_subscription(
+      typename SignalMailbox<T>::Callback callback,
+      SubscriptionOptions options);
+  template <typename T>
+  static SubscriberList<T> with_subscription(const SubscriberList<T>& list,
+                                             Subscription<T> subscription);
+  // 没有找到 id 时返回空
+  template <typename T>
+  static SubscriberList<T> without_subscription(const SubscriberList<T>& list,
+                                                SubscriptionId id);
+  // 关闭 list 中 id 对应的信箱
+  template <typename T>
+  static void close_subscription(const SubscriberList<T>& list,
+                                 SubscriptionId id);
+  template <typename T>
+  static void append_stats(const std::string& signal_name,
+                           const SubscriberList<T>& list,
+                           std::vector<SubscriberStats>& stats);
+  template <typename T>
+  SubscriptionId add_subscription(Channel<T>& channel,
+                                  const std::string& signal_name,
+                                  typename SignalMailbox<T>::Callback callback,
+                                  SubscriptionOptions options);
+  template <typename T>
+  void post_copy(const std::string& signal_name, const Channel<T>& channel,
+                 const T& data) const;
+
+  SignalHandle declare_signal_locked(const std::string& signal_name);
+  SubscriberList<cv::Mat> image_subscribers(SignalHandle signal) const;
+  SubscriptionId add_image_subscription(SignalHandle signal,
+                                        SharedImageCallback callback,
+                                        SubscriptionOptions options,
+                                        cv::Size preview_size);
+  // full 为空时按需从 img 深拷贝一次
+  static void deliver(const std::vector<Subscription<cv::Mat>>& list,
+                      const cv::Mat& img, SharedImage full);
+
+  // 图像信号按句柄平铺，两种回调统一按 SharedImage 投递；
+  // 发送方只读取快照（不持有 mutex_），修改在 mutex_ 下整体替换
+  std::array<std::atomic<SubscriberList<cv::Mat>>, kMaxSignals> image_slots_;
+  std::unordered_map<std::string, SignalHandle> signal_index_;
+  std::vector<std::string> signal_names_;  // 按句柄索引
   // 数据信号
-  std::unordered_map<std::string, std::vector<FeatureCallback>>
-      feature_subscribers_;
-  std::unordered_map<std::string, std::vector<StatusCallback>>
-      status_subscribers_;
+  Channel<FeatureData> feature_subscribers_;
+  Channel<StatusData> status_subscribers_;
 
+  std::atomic<SubscriptionId> next_id_{1};
+  // 保护名字表和订阅表的修改，发送图像和回调期间不持有
   mutable std::shared_mutex mutex_;
 };
@@ -0,0 +1,126 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ImageWriter.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ImageCodec { Jpeg, Png, Webp, Bmp };
+
+// 什么时候保存证据图
+enum class EvidenceMode {
+  Off,          // 不保存
+  Always,       // 每次都保存
+  DefectsOnly,  // 只在检出缺陷时保存
+};
+
+// 队列满时丢哪一张
+enum class WriteDropPolicy {
+  DropNewest,  // 丢弃新提交的图像
+  DropOldest,  // 丢弃最早排队的图像，保证落盘的是最新的证据
+};
+
+struct ImageWriterConfig {
+  size_t workers = 1;          // 编码 + 写盘线程数
+  size_t queue_capacity = 16;  // 排队等待编码的最大图像数
+  WriteDropPolicy drop_policy = WriteDropPolicy::DropNewest;
+  ImageCodec codec = ImageCodec::Jpeg;
+  int quality = 90;  // JPEG/WebP 质量（0-100）；PNG 时换算为压缩级别
+  EvidenceMode mode = EvidenceMode::Always;
+};
+
+/**
+ * @brief 异步图像保存服务
+ *
+ * 检测线程只把 cv::Mat 的引用放进有界队列，编码和写盘在自己的线程上完成，
+ * 队列满时按策略丢图而不是阻塞检测线程。多个算法可以共享一个实例。
+ *
+ * 提交的图像在写完之前不能再被修改；不拥有数据的 Mat（例如帧缓冲区上的
+ * 零拷贝视图）在提交时会被深拷贝，因为帧可能在写盘之前就被归还到缓冲池。
+ */
+class ImageWriter {
+ public:
+  struct Stats {
+    uint64_t submitted = 0;
+    uint64_t written = 0;
+    uint64_t dropped = 0;  // 队列满时被丢弃的图像数
+    uint64_t failed = 0;   // 编码或写盘失败的图像数
+  };
+
+  explicit ImageWriter(ImageWriterConfig config = {});
+  ~ImageWriter();  // 写完队列中剩余的图像
+
+  ImageWriter(const ImageWriter&) = delete;
+  ImageWriter& operator=(const ImageWriter&) = delete;
+
+  // 按 mode 判断这一次是否需要保存，不需要时调用方可以省掉画图的开销
+  bool should_save(bool defects_found) const;
+
+  // path_stem 不含扩展名，扩展名由 codec 决定；被丢弃时返回 false
+  bool submit(const std::string& path_stem, cv::Mat image);
+
+  // 等待队列中的图像全部写完
+  void flush();
+
+  Stats stats() const;
+  const ImageWriterConfig& config() const { return config_; }
+
+  static const char* extension(ImageCodec codec);
+
+ private:
+  struct Job {
+    std::string path;
+    cv::Mat image;
+  };
+
+  void worker_loop();
+  bool write(const Job& job, std::vector<uint8_t>& buffer) const;
+
+  ImageWriterConfig config_;
+  std::vector<int> encode_params_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable job_cv_;   // 有新任务或正在停止
+  std::condition_variable idle_cv_;  // 队列清空且没有正在写的任务
+  std::deque<Job> jobs_;
+  size_t in_flight_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> failed_{0};
+};
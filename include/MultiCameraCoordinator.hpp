@@ -25,77 +25,109 @@
  */
 
 #pragma once
-#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <memory>
-#include <mutex>
 #include <utility>
 #include <vector>
 
 #include "FrameProcessor.hpp"
+#include "FrameSynchronizer.hpp"
 
 class CapturedFrame;
 
 // MultiCameraCoordinator.hpp
+/**
+ * @brief 多相机融合：各相机的帧按时间戳配组后融合，再交给下游处理器
+ *
+ * 配组由 FrameSynchronizer 完成（见 SyncOptions），融合和下游处理在
+ * 同步器的专用线程上串行执行，不阻塞相机的处理线程。
+ * PartialPolicy::Emit 时缺帧的相机在 frames 中为空（旧接口中是 data 为空的帧）。
+ *
+ * 横向拼接直接传入 StripStitcher，输入帧不拷贝、每个像素只拷贝一次。
+ */
 class MultiCameraCoordinator {
  public:
+  // 旧接口：每一组帧都要先拷贝成 CapturedFrame
   using FusionFunc =
       std::function<CapturedFrame(const std::vector<CapturedFrame>&)>;
+  // 共享输入帧，返回空表示丢弃这一组
+  using SharedFusionFunc =
+      std::function<CapturedFramePtr(const FrameSynchronizer::FrameSet&)>;
 
-  MultiCameraCoordinator(size_t num_cams, FusionFunc fuse_func)
-      : frames_(num_cams),
-        received_(num_cams, false),
-        fuse_func_(std::move(fuse_func)) {}
+  MultiCameraCoordinator(size_t num_cams, FusionFunc fuse_func,
+                         SyncOptions options = {})
+      : MultiCameraCoordinator(num_cams, copying(std::move(fuse_func)),
+                               options) {}
+
+  MultiCameraCoordinator(size_t num_cams, SharedFusionFunc fuse_func,
+                         SyncOptions options = {})
+      : fuse_func_(std::move(fuse_func)),
+        sync_(num_cams, options,
+              [this](FrameSynchronizer::FrameSet&& set) { fuse(set); }) {}
 
   // 返回 FrameProcessor（实际是 FunctionFrameProcessor）
-  FrameProcessor make_processor_for(size_t cam_index) {
+  std::shared_ptr<FrameProcessor> make_processor_for(size_t cam_index) {
     // 创建 lambda
     auto lambda = [this, cam_index](const CapturedFrame& frame) {
       this->on_frame(cam_index, frame);
     };
     // 用工具函数包装成 FrameProcessor
-    return make_function_processor(std::move(lambda));
+    return make_shared_function_processor(std::move(lambda));
   }
 
   // 重载make_processor_for的括号函数
-  FrameProcessor operator[](size_t cam_index) {
+  std::shared_ptr<FrameProcessor> operator[](size_t cam_index) {
     return make_processor_for(cam_index);
   }
 
+  // 配组、超时和丢帧的统计
+  FrameSynchronizer::Stats sync_stats() const { return sync_.stats(); }
+
  private:
   void on_frame(size_t cam_index, const CapturedFrame& frame) {
-    std::lock_guard lock(mutex_);
-    frames_[cam_index] = frame;
-    received_[cam_index] = true;
-
-    if (std::all_of(received_.begin(), received_.end(),
-                    [](bool b) { return b; })) {
-      // 所有帧到齐，执行融合
-      auto fused = fuse_func_(frames_);
-
-      // 融合后做什么？例如：
-      // - 交给算法处理
-      // - 发送到 ImageSignalBus
-      // - 入队供 GUI 显示
-
-      // 处理完后，最后还是要交由通用算法处理
-      if (downstream_processor_) {
-        downstream_processor_->process(fused);
+    // 只持有帧的引用，配组在同步器里完成
+    sync_.push(cam_index, retain_frame(frame));
+  }
+
+  static SharedFusionFunc copying(FusionFunc fuse_func) {
+    return [fuse_func = std::move(fuse_func)](
+               const FrameSynchronizer::FrameSet& set) -> CapturedFramePtr {
+      std::vector<CapturedFrame> frames(set.size());
+      for (size_t i = 0; i < set.size(); ++i) {
+        if (set[i]) {
+          frames[i] = *set[i];
+        }
       }
+      return std::make_shared<CapturedFrame>(fuse_func(frames));
+    };
+  }
+
+  // 同步器线程上调用，不持有任何锁
+  void fuse(const FrameSynchronizer::FrameSet& set) {
+    auto fused = fuse_func_(set);
+    if (!fused) {
+      return;
+    }
+
+    // 融合后做什么？例如：
+    // - 交给算法处理
+    // - 发送到 ImageSignalBus
+    // - 入队供 GUI 显示
 
-      // 重置状态（或加超时机制）
-      std::fill(received_.begin(), received_.end(), false);
+    // 处理完后，最后还是要交由通用算法处理
+    if (downstream_processor_) {
+      downstream_processor_->process(*fused);
     }
   }
 
-  std::vector<CapturedFrame> frames_;
-  std::vector<bool> received_;
-  FusionFunc fuse_func_;
+  SharedFusionFunc fuse_func_;
   std::unique_ptr<FrameProcessor> downstream_processor_;
-  std::mutex mutex_;
+  // 最后声明：析构时先停掉同步器线程，再销毁它用到的成员
+  FrameSynchronizer sync_;
 
  public:
+  // 在相机启动之前设置，之后融合线程会并发读取
   void set_downstream_processor(std::unique_ptr<FrameProcessor> proc) {
     downstream_processor_ = std::move(proc);
   }
@@ -0,0 +1,89 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: OrderedFrameProcessor.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "FrameProcessor.hpp"
+#include "SequenceReorderer.hpp"
+
+/**
+ * @brief 在并行处理之后按采集序号重新排序的处理器
+ *
+ * inner（通常是 AlgoAdapter）仍然在多个 worker 上并行执行，
+ * 只有执行完之后的 sink 调用按 CapturedFrame::sequence 串行、有序。
+ * 适合上报特征、累计卷长这类要求顺序的下游。
+ *
+ * 注册到 FramePipeline 后，处理队列丢弃的帧会通过 on_dropped() 跳过，
+ * 停止采集时 flush() 交付剩余的结果。
+ */
+class OrderedFrameProcessor : public FrameProcessor {
+ public:
+  using Sink = std::function<void(const CapturedFramePtr& frame)>;
+
+  OrderedFrameProcessor(std::shared_ptr<FrameProcessor> inner, Sink sink,
+                        size_t max_pending = 32)
+      : inner_(std::move(inner)),
+        reorderer_(std::make_shared<SequenceReorderer<CapturedFramePtr>>(
+            [sink = std::move(sink)](uint64_t, CapturedFramePtr&& frame) {
+              sink(frame);
+            },
+            max_pending)) {}
+
+  void process(const CapturedFrame& frame) override {
+    if (inner_) {
+      inner_->process(frame);
+    }
+    reorderer_->push(frame.sequence, retain_frame(frame));
+  }
+
+  void on_dropped(uint64_t sequence) override {
+    if (inner_) {
+      inner_->on_dropped(sequence);
+    }
+    reorderer_->skip(sequence);
+  }
+
+  void flush() override {
+    if (inner_) {
+      inner_->flush();
+    }
+    reorderer_->flush();
+  }
+
+  const SequenceReorderer<CapturedFramePtr>& reorderer() const {
+    return *reorderer_;
+  }
+
+ private:
+  std::shared_ptr<FrameProcessor> inner_;
+  // 共享状态，拷贝出来的处理器仍然使用同一个重排窗口
+  std::shared_ptr<SequenceReorderer<CapturedFramePtr>> reorderer_;
+};
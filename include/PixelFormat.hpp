@@ -0,0 +1,73 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: PixelFormat.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "DvpCamera.h"
+
+// 与相机无关的像素格式，算法和显示只依赖这个枚举
+enum class PixelFormat : uint8_t {
+  Unknown,
+  Mono8,
+  Mono16,  // 10/12/14/16 位数据都按 16 位存放
+  BayerBG8,
+  BayerGB8,
+  BayerGR8,
+  BayerRG8,
+  BayerBG16,
+  BayerGB16,
+  BayerGR16,
+  BayerRG16,
+  BGR24,
+  BGR32,  // BGRA
+  BGR48,
+  BGR64,
+  RGB24,
+  RGB32,  // RGBA
+  RGB48,
+  RGB64,
+};
+
+// 由 SDK 帧信息（dvpFrame::format + dvpFrame::bits）得到实际的像素格式
+PixelFormat pixel_format_from_frame(dvpImageFormat format, dvpBits bits);
+
+// 由目标输出格式推断像素格式；RAW 格式的 Bayer 排列要等到首帧才知道，
+// 此时返回 Unknown
+PixelFormat pixel_format_from_stream(dvpStreamFormat format);
+
+// 每像素字节数，Unknown 返回 0
+size_t bytes_per_pixel(PixelFormat format);
+// 目标输出格式每像素字节数，未知格式返回 0
+size_t bytes_per_pixel(dvpStreamFormat format);
+
+int channel_count(PixelFormat format);
+bool is_bayer(PixelFormat format);
+bool is_16bit(PixelFormat format);
+
+const char* pixel_format_name(PixelFormat format);
@@ -0,0 +1,175 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ProcessingExecutor.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "BS_thread_pool.hpp"
+
+// 单个相机的 worker 预算
+struct WorkerBudget {
+  size_t workers = 0;     // 0 表示按 ExecutorConfig::expected_lanes 平分
+  std::vector<int> cpus;  // 显式指定的核心；为空时由执行器顺序分配
+};
+
+// 进程级执行器配置，只影响之后创建的 lane
+struct ExecutorConfig {
+  size_t total_workers = 0;   // 0 表示逻辑核心数
+  size_t expected_lanes = 4;  // 预计的相机数量，用于平分 worker
+  bool pin_threads = false;   // 是否把 worker 绑定到分配的核心上
+  // OpenCV 自身 parallel_for_ 的线程数（全局设置）。
+  // 相机之间已经是并行的，默认 0 关闭 OpenCV 的线程池避免叠加线程，
+  // 小于 0 表示不修改 OpenCV 的设置
+  int opencv_threads = 0;
+};
+
+/**
+ * @brief 进程级的帧处理执行器
+ *
+ * 所有相机共享同一份 worker 预算：每个相机获取一条 lane（独立的小线程池），
+ * lane 的 worker 数量来自 WorkerBudget，总数不超过 total_workers。
+ * 开启绑核时每条 lane 占用一段连续的核心，同一相机的帧始终在同一组核心上
+ * 处理，连续编号的核心通常也位于同一个 NUMA 节点。
+ *
+ * 预算用完后不再创建线程，新 lane 与共用者最少的一组现有 worker 共用；
+ * 显式指定的核心越界或已被占用时不使用，改为顺序分配。
+ */
+class ProcessingExecutor {
+ public:
+  // 一组 worker 线程及其占用的预算，最后一个使用它的 lane 析构时归还
+  class Workers {
+   public:
+    Workers(ProcessingExecutor& owner, size_t count, std::vector<int> cpus,
+            bool pinned);
+    ~Workers();
+
+    Workers(const Workers&) = delete;
+    Workers& operator=(const Workers&) = delete;
+
+    template <typename F>
+    void detach(F&& task) {
+      pool_.detach_task(std::forward<F>(task));
+    }
+
+    size_t count() const { return count_; }
+    const std::vector<int>& cpus() const { return cpus_; }
+    bool pinned() const { return pinned_; }
+
+   private:
+    ProcessingExecutor& owner_;
+    const size_t count_;
+    const std::vector<int> cpus_;
+    const bool pinned_;
+    std::atomic<size_t> next_worker_{0};  // 必须在 pool_ 之前初始化
+    BS::thread_pool<> pool_;
+  };
+
+  // 一个相机使用的任务通道。共享 worker 时 wait() 只等待本 lane 提交的任务
+  class Lane {
+   public:
+    explicit Lane(std::shared_ptr<Workers> workers)
+        : workers_(std::move(workers)) {}
+    ~Lane() { wait(); }
+
+    Lane(const Lane&) = delete;
+    Lane& operator=(const Lane&) = delete;
+
+    template <typename F>
+    void detach(F&& task) {
+      {
+        std::lock_guard lock(mutex_);
+        ++pending_;
+      }
+      workers_->detach([this, task = std::forward<F>(task)]() mutable {
+        struct Finish {
+          Lane* lane;
+          ~Finish() { lane->finish(); }
+        } finish{this};
+        task();
+      });
+    }
+
+    void wait() {
+      std::unique_lock lock(mutex_);
+      idle_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    size_t worker_count() const { return workers_->count(); }
+    const std::vector<int>& cpus() const { return workers_->cpus(); }
+    bool pinned() const { return workers_->pinned(); }
+    // 两条 lane 是否共用同一组 worker
+    bool shares_workers_with(const Lane& other) const {
+      return workers_ == other.workers_;
+    }
+
+   private:
+    void finish() {
+      std::lock_guard lock(mutex_);
+      if (--pending_ == 0) {
+        idle_.notify_all();
+      }
+    }
+
+    std::shared_ptr<Workers> workers_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    size_t pending_ = 0;
+  };
+
+  static ProcessingExecutor& instance();
+
+  void configure(const ExecutorConfig& cfg);
+  ExecutorConfig get_config() const;
+
+  // 按预算创建 lane，lane 析构时归还 worker 和核心。
+  // 预算用完时新 lane 共用已有的 worker，没有可共用的 worker 时抛出
+  // std::runtime_error
+  std::shared_ptr<Lane> acquire_lane(const WorkerBudget& budget = {});
+
+  size_t total_workers() const;
+  size_t workers_in_use() const;
+
+ private:
+  ProcessingExecutor();
+  void release(size_t workers, const std::vector<int>& cpus);
+  bool cpus_available(const std::vector<int>& cpus) const;
+  std::vector<int> take_cpus(size_t count);
+
+  mutable std::mutex mutex_;
+  ExecutorConfig config_;
+  size_t total_workers_ = 1;
+  size_t workers_in_use_ = 0;
+  std::vector<bool> cpu_taken_;
+  // 预算用完时从中挑选共用的 worker
+  std::vector<std::weak_ptr<Workers>> workers_;
+};
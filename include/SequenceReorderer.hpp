@@ -0,0 +1,192 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: SequenceReorderer.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+
+/**
+ * @brief 按序号重排乱序到达的结果
+ *
+ * 多个 worker 并行处理时结果的完成顺序是乱的，push() 可以在任意线程调用，
+ * sink 总是按序号递增的顺序、串行地被调用。sink 在锁外执行：同一时刻只有
+ * 一个线程负责交付，其他线程放下就绪的结果后立即返回，由它顺带交付。
+ *
+ * 被背压丢弃的帧永远不会到达，应当调用 skip() 让后面的结果不必等待；
+ * 漏掉的缺口在等待中的结果超过 max_pending 时也会被跳过。
+ * 已经被跳过的序号如果迟到，会被丢弃并计入 late()。析构时交付剩余的结果。
+ */
+template <typename T>
+class SequenceReorderer {
+ public:
+  using Sink = std::function<void(uint64_t sequence, T&& value)>;
+
+  explicit SequenceReorderer(Sink sink, size_t max_pending = 32,
+                             uint64_t first_sequence = 0)
+      : sink_(std::move(sink)),
+        max_pending_(max_pending == 0 ? 1 : max_pending),
+        next_(first_sequence) {}
+
+  ~SequenceReorderer() { flush(); }
+
+  SequenceReorderer(const SequenceReorderer&) = delete;
+  SequenceReorderer& operator=(const SequenceReorderer&) = delete;
+
+  void push(uint64_t sequence, T value) {
+    std::unique_lock lock(mutex_);
+    if (sequence < next_) {
+      ++late_;
+      return;
+    }
+    pending_.emplace(sequence, std::move(value));
+    drain();
+    deliver(lock);
+  }
+
+  // 标记某个序号不会到达（例如被背压丢弃）
+  void skip(uint64_t sequence) {
+    std::unique_lock lock(mutex_);
+    if (sequence < next_) {
+      return;
+    }
+    if (sequence == next_) {
+      ++next_;
+      ++skipped_;
+    } else {
+      skipped_marks_.insert(sequence);
+    }
+    drain();
+    deliver(lock);
+  }
+
+  // 不再等待缺口，按顺序交付所有等待中的结果
+  void flush() {
+    std::unique_lock lock(mutex_);
+    while (!pending_.empty()) {
+      release_front();
+    }
+    skipped_marks_.clear();
+    deliver(lock);
+  }
+
+  size_t pending() const {
+    std::lock_guard lock(mutex_);
+    return pending_.size();
+  }
+  uint64_t skipped() const {
+    std::lock_guard lock(mutex_);
+    return skipped_;
+  }
+  uint64_t late() const {
+    std::lock_guard lock(mutex_);
+    return late_;
+  }
+
+ private:
+  void drain() {
+    for (;;) {
+      auto mark = skipped_marks_.find(next_);
+      if (mark != skipped_marks_.end()) {
+        skipped_marks_.erase(mark);
+        ++next_;
+        ++skipped_;
+        continue;
+      }
+      if (pending_.empty()) {
+        return;
+      }
+      if (pending_.begin()->first == next_ || pending_.size() > max_pending_) {
+        release_front();
+        continue;
+      }
+      return;
+    }
+  }
+
+  // 取出序号最小的结果等待交付，中间的缺口计为跳过
+  void release_front() {
+    auto it = pending_.begin();
+    const uint64_t sequence = it->first;
+    skipped_ += sequence - next_;
+    T value = std::move(it->second);
+    pending_.erase(it);
+    next_ = sequence + 1;
+    // 缺口之前的 skip 标记已经没有意义
+    skipped_marks_.erase(skipped_marks_.begin(),
+                         skipped_marks_.lower_bound(next_));
+    ready_.emplace_back(sequence, std::move(value));
+  }
+
+  // 在锁外按顺序调用 sink。已经有线程在交付时直接返回，
+  // 新放入 ready_ 的结果由那个线程在下一轮交付，顺序不会被打乱
+  void deliver(std::unique_lock<std::mutex>& lock) {
+    if (delivering_) {
+      return;
+    }
+    delivering_ = true;
+    while (!ready_.empty()) {
+      std::deque<std::pair<uint64_t, T>> batch;
+      batch.swap(ready_);
+      lock.unlock();
+      try {
+        for (; !batch.empty(); batch.pop_front()) {
+          sink_(batch.front().first, std::move(batch.front().second));
+        }
+      } catch (...) {
+        // 抛出异常的结果算作已交付，其余的留给下一次交付
+        lock.lock();
+        if (!batch.empty()) {
+          batch.pop_front();
+        }
+        ready_.insert(ready_.begin(), std::make_move_iterator(batch.begin()),
+                      std::make_move_iterator(batch.end()));
+        delivering_ = false;
+        throw;
+      }
+      lock.lock();
+    }
+    delivering_ = false;
+  }
+
+  Sink sink_;
+  const size_t max_pending_;
+  uint64_t next_;
+  std::map<uint64_t, T> pending_;
+  std::set<uint64_t> skipped_marks_;
+  std::deque<std::pair<uint64_t, T>> ready_;  // 已排好序、等待交付的结果
+  bool delivering_ = false;
+  uint64_t skipped_ = 0;
+  uint64_t late_ = 0;
+  mutable std::mutex mutex_;
+};
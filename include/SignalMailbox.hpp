@@ -0,0 +1,269 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: SignalMailbox.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "concurrentqueue.h"
+
+// 信号送达订阅者的方式
+enum class DeliveryMode {
+  Inline,      // 在发送线程上直接调用（默认）
+  Queued,      // 进入订阅者自己的队列，由它专属的线程按顺序调用，满了丢新的
+  LatestOnly,  // 只保留最新的一条，订阅者来不及处理时旧的被覆盖
+};
+
+struct SubscriptionOptions {
+  DeliveryMode mode = DeliveryMode::Inline;
+  size_t queue_capacity = 16;  // Queued 模式下最多排队的条数
+  double max_rate_hz = 0.0;    // 每秒最多送达的条数，0 表示不限速
+};
+
+// 单个订阅者的投递统计
+struct MailboxStats {
+  uint64_t delivered = 0;  // 已调用回调的次数
+  uint64_t dropped = 0;    // 队列满或被更新的一条覆盖而没有送达的次数
+  uint64_t failed = 0;     // 回调抛出异常的次数
+  uint64_t throttled = 0;  // 限速窗口未到而跳过的次数
+  size_t pending = 0;      // 还未送达的条数
+  double last_lag_us = 0.0;  // 发送到回调开始执行的延迟，Inline 时为 0
+  double max_lag_us = 0.0;
+};
+
+/**
+ * @brief 一个订阅者的信箱
+ *
+ * 发送方调用 post()，Inline 模式直接调用回调；其余模式只做一次入队
+ * （Queued 用无锁的 moodycamel 队列，LatestOnly 用 atomic<shared_ptr> 交换的
+ * 单槽，后者在 libstdc++ 和 MSVC 上内部会短暂加锁），由信箱自己的线程调用
+ * 回调，慢订阅者不会拖慢发送方。回调抛出的异常被吞掉并计数。
+ * close() 或析构时先送完已经入箱的消息再退出线程，之后的 post() 直接丢弃。
+ *
+ * 设置了 max_rate_hz 时，发送方先用 try_claim() 占用本次的送达窗口，
+ * 窗口未到的直接跳过，连消息本身都不必生成。
+ */
+template <typename T>
+class SignalMailbox {
+ public:
+  using Payload = std::shared_ptr<const T>;
+  using Callback = std::function<void(const Payload&)>;
+  using Clock = std::chrono::steady_clock;
+
+  SignalMailbox(Callback callback, SubscriptionOptions options)
+      : callback_(std::move(callback)),
+        mode_(options.mode),
+        capacity_(std::max<size_t>(1, options.queue_capacity)),
+        min_interval_ns_(options.max_rate_hz > 0.0
+                             ? static_cast<int64_t>(1e9 / options.max_rate_hz)
+                             : 0) {
+    if (mode_ != DeliveryMode::Inline) {
+      thread_ = std::thread([this]() { run(); });
+    }
+  }
+
+  ~SignalMailbox() { close(); }
+
+  // 送完已经入箱的消息后停止投递线程，之后的 post() 直接丢弃。
+  // 取消订阅时在订阅方线程上调用，发送方手里残留的引用之后析构时
+  // 不必再等待投递线程；不能在本信箱自己的回调里调用
+  void close() {
+    closed_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+      stopping_.store(true);
+      wake();
+      thread_.join();
+    }
+  }
+
+  SignalMailbox(const SignalMailbox&) = delete;
+  SignalMailbox& operator=(const SignalMailbox&) = delete;
+
+  DeliveryMode mode() const { return mode_; }
+
+  // now 时刻是否在送达窗口内，不限速时总是 true
+  bool accepting(Clock::time_point now) const {
+    return min_interval_ns_ == 0 ||
+           ticks(now) >= next_due_ns_.load(std::memory_order_relaxed);
+  }
+
+  // 占用 now 时刻的送达窗口，多个发送线程同时到达时只有一个成功
+  bool try_claim(Clock::time_point now) {
+    if (min_interval_ns_ == 0) {
+      return true;
+    }
+    const int64_t t = ticks(now);
+    int64_t due = next_due_ns_.load(std::memory_order_relaxed);
+    do {
+      if (t < due) {
+        throttled_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    } while (!next_due_ns_.compare_exchange_weak(
+        due, t + min_interval_ns_, std::memory_order_relaxed));
+    return true;
+  }
+
+  void post(const Payload& payload) {
+    if (closed_.load(std::memory_order_acquire)) {
+      return;
+    }
+    switch (mode_) {
+      case DeliveryMode::Inline:
+        invoke(payload);
+        return;
+      case DeliveryMode::Queued:
+        // 容量按计数判断，允许并发发送时短暂多出几条
+        if (pending_.load(std::memory_order_relaxed) >= capacity_) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        queue_.enqueue(Item{payload, Clock::now()});
+        break;
+      case DeliveryMode::LatestOnly:
+        if (latest_.exchange(std::make_shared<Item>(Item{payload, Clock::now()}))) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          pending_.fetch_add(1, std::memory_order_relaxed);
+        }
+        break;
+    }
+    wake();
+  }
+
+  MailboxStats stats() const {
+    MailboxStats stats;
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    stats.throttled = throttled_.load(std::memory_order_relaxed);
+    stats.pending = pending_.load(std::memory_order_relaxed);
+    stats.last_lag_us =
+        static_cast<double>(last_lag_ns_.load(std::memory_order_relaxed)) /
+        1000.0;
+    stats.max_lag_us =
+        static_cast<double>(max_lag_ns_.load(std::memory_order_relaxed)) /
+        1000.0;
+    return stats;
+  }
+
+ private:
+  struct Item {
+    Payload payload;
+    Clock::time_point posted;
+  };
+
+  static int64_t ticks(Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               t.time_since_epoch())
+        .count();
+  }
+
+  void wake() {
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+  }
+
+  // 投递线程：取空信箱后等待下一次唤醒，停止时先取空再退出
+  void run() {
+    Item item;
+    while (true) {
+      const uint32_t seen = signal_.load(std::memory_order_acquire);
+      bool delivered_any = false;
+      if (mode_ == DeliveryMode::Queued) {
+        while (queue_.try_dequeue(item)) {
+          pending_.fetch_sub(1, std::memory_order_relaxed);
+          deliver(item);
+          delivered_any = true;
+        }
+      } else if (auto latest = latest_.exchange(nullptr)) {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        deliver(*latest);
+        delivered_any = true;
+      }
+      if (delivered_any) {
+        continue;
+      }
+      if (stopping_.load()) {
+        return;
+      }
+      signal_.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  void deliver(Item& item) {
+    const uint64_t lag = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             item.posted)
+            .count());
+    last_lag_ns_.store(lag, std::memory_order_relaxed);
+    if (lag > max_lag_ns_.load(std::memory_order_relaxed)) {
+      max_lag_ns_.store(lag, std::memory_order_relaxed);  // 只有投递线程写
+    }
+    invoke(item.payload);
+    item.payload.reset();  // 尽早释放共享的图像
+  }
+
+  void invoke(const Payload& payload) {
+    try {
+      callback_(payload);
+      delivered_.fetch_add(1, std::memory_order_relaxed);
+    } catch (...) {
+      failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  Callback callback_;
+  const DeliveryMode mode_;
+  const size_t capacity_;
+  const int64_t min_interval_ns_;  // 0 表示不限速
+  std::atomic<int64_t> next_due_ns_{0};
+
+  moodycamel::ConcurrentQueue<Item> queue_;  // Queued
+  std::atomic<std::shared_ptr<Item>> latest_;  // LatestOnly
+  std::atomic<size_t> pending_{0};
+  std::atomic<uint32_t> signal_{0};
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> closed_{false};
+  std::thread thread_;
+
+  std::atomic<uint64_t> delivered_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> failed_{0};
+  std::atomic<uint64_t> throttled_{0};
+  std::atomic<uint64_t> last_lag_ns_{0};
+  std::atomic<uint64_t> max_lag_ns_{0};
+};
@@ -0,0 +1,174 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: StageTimings.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 一个阶段的耗时统计（微秒），分位数的误差在 1/8 个 2 的幂以内
+struct StageTimingStats {
+  std::string stage;
+  uint64_t count = 0;
+  double mean_us = 0.0;
+  double p50_us = 0.0;
+  double p99_us = 0.0;
+  double max_us = 0.0;
+};
+
+/**
+ * @brief 单写者的对数-线性直方图（纳秒）
+ *
+ * 小于 16ns 的值各占一个桶，之后每个 2 的幂分 8 个桶。只允许一个线程
+ * 调用 record()，计数器用 relaxed 的 load + store 更新，不需要锁前缀指令；
+ * 其它线程可以随时读取，读到的是某个时刻附近的近似值。
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBits = 3;
+  static constexpr int kMaxExponent = 40;  // 约 18 分钟，再大的值落在最后一桶
+  static constexpr size_t kBuckets =
+      (1u << (kSubBits + 1)) + (kMaxExponent - kSubBits - 1) * (1u << kSubBits);
+
+  void record(uint64_t ns);
+
+  static size_t bucket_of(uint64_t ns);
+  static uint64_t bucket_upper(size_t bucket);
+
+  // 累加到 counts（大小为 kBuckets）中
+  void accumulate(std::vector<uint64_t>& counts, uint64_t& count,
+                  uint64_t& sum, uint64_t& max) const;
+
+ private:
+  static void bump(std::atomic<uint64_t>& v, uint64_t delta) {
+    v.store(v.load(std::memory_order_relaxed) + delta,
+            std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief 按阶段统计耗时，每个线程写自己的直方图
+ *
+ * 线程第一次记录时创建自己的分片并无锁地挂到链表上，之后的 record()
+ * 只写本线程的分片。snapshot() 汇总所有分片，可以在任意线程调用。
+ * 分片在对象析构时释放，析构时不能再有线程在记录。
+ */
+class StageTimings {
+ public:
+  explicit StageTimings(std::vector<std::string> stage_names);
+  ~StageTimings();
+
+  StageTimings(const StageTimings&) = delete;
+  StageTimings& operator=(const StageTimings&) = delete;
+
+  void record(size_t stage, std::chrono::nanoseconds elapsed);
+
+  std::vector<StageTimingStats> snapshot() const;
+
+  const std::vector<std::string>& stage_names() const { return names_; }
+
+ private:
+  struct Shard {
+    explicit Shard(size_t stages) : stages(stages) {}
+    std::vector<LatencyHistogram> stages;
+    Shard* next = nullptr;
+  };
+
+  Shard* local_shard();
+
+  const uint64_t id_;  // 进程内唯一，线程缓存以它为键，不会因地址复用出错
+  std::vector<std::string> names_;
+  std::atomic<Shard*> shards_{nullptr};
+};
+
+// 作用域计时，timings 为空时什么也不做
+class ScopedStageTimer {
+ public:
+  ScopedStageTimer(StageTimings* timings, size_t stage)
+      : timings_(timings), stage_(stage) {
+    if (timings_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+  ~ScopedStageTimer() {
+    if (timings_) {
+      timings_->record(stage_, std::chrono::steady_clock::now() - start_);
+    }
+  }
+
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  StageTimings* timings_;
+  size_t stage_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief 定期把统计结果交给 sink 的后台线程
+ *
+ * 输出（例如打印到控制台）全部发生在这个线程里，处理线程只写直方图，
+ * 不会因为 stdout 的锁或磁盘 I/O 被阻塞。
+ */
+class StageTimingReporter {
+ public:
+  using Sink = std::function<void(const std::vector<StageTimingStats>&)>;
+
+  StageTimingReporter() = default;
+  ~StageTimingReporter() { stop(); }
+
+  StageTimingReporter(const StageTimingReporter&) = delete;
+  StageTimingReporter& operator=(const StageTimingReporter&) = delete;
+
+  // source 返回要输出的统计，例如 [&] { return algo->get_stage_timings(); }
+  void start(std::function<std::vector<StageTimingStats>()> source, Sink sink,
+             std::chrono::milliseconds interval);
+  void stop();
+
+  // 以一行一个阶段的格式写到 stdout
+  static void print(const std::vector<StageTimingStats>& stats);
+
+ private:
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+};
@@ -0,0 +1,94 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: StripStitcher.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "FrameBufferPool.hpp"
+#include "FrameProcessor.hpp"
+#include "FrameSynchronizer.hpp"
+
+// 一台相机在拼接结果中的位置
+struct StitchSlice {
+  int src_x = 0;  // 从该相机帧的第 src_x 列开始取
+  int width = 0;  // 取的列数
+  int dst_x = 0;  // 写到输出帧的第 dst_x 列
+};
+
+/**
+ * @brief 多相机横向拼接
+ *
+ * 每台相机只取自己的切片（重叠部分已经去掉），逐行直接写进从帧缓冲池
+ * 取出的输出帧，每个像素只拷贝一次，输入帧不做任何拷贝。
+ * 输出帧的格式、高度和元信息取自第一台到达的相机，宽度为各切片之和。
+ * 部分交付的组里缺帧的相机，其切片填 0。
+ *
+ * 可以直接作为 MultiCameraCoordinator 的融合函数；stitch() 可以在
+ * 任意线程并发调用。
+ */
+class StripStitcher {
+ public:
+  /**
+   * @param slices 按相机下标排列，dst 区间必须从 0 开始首尾相接，
+   *        否则抛出 std::invalid_argument
+   * @param pool 输出帧的缓冲池，为空时自己创建一个
+   */
+  explicit StripStitcher(std::vector<StitchSlice> slices,
+                         std::shared_ptr<FrameBufferPool> pool = nullptr);
+
+  /**
+   * @brief 由标定的水平偏移生成切片
+   * @param widths 各相机帧的宽度
+   * @param offsets 各相机第 0 列在拼接坐标系中的位置，按相机从左到右递增
+   *
+   * 相邻相机的重叠部分从中间切开，两边各取一半；相机之间有缝隙、
+   * 偏移不递增或数量不一致时抛出 std::invalid_argument。
+   * 切片的列偏移 src_x - dst_x 等于 offsets[0] - offsets[i]，与切在哪里
+   * 无关；拼接 Bayer 帧时各相机的偏移之差必须是偶数，否则 stitch()
+   * 返回空。
+   */
+  static std::vector<StitchSlice> slices_from_offsets(
+      std::span<const int> widths, std::span<const int> offsets);
+
+  int output_width() const { return output_width_; }
+  const std::vector<StitchSlice>& slices() const { return slices_; }
+
+  // 拼接一组帧；数量、格式、高度不一致、切片越界，或 Bayer 帧的切片
+  // 列偏移为奇数（会打乱 CFA 相位）时返回空
+  CapturedFramePtr stitch(const FrameSynchronizer::FrameSet& frames) const;
+
+  CapturedFramePtr operator()(const FrameSynchronizer::FrameSet& frames) const {
+    return stitch(frames);
+  }
+
+ private:
+  std::vector<StitchSlice> slices_;
+  int output_width_ = 0;
+  std::shared_ptr<FrameBufferPool> pool_;
+};
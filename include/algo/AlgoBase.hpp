@@ -27,14 +27,15 @@
 #pragma once
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "FrameProcessor.hpp"
 #include "ImageSignalBus.hpp"
+#include "StageTimings.hpp"
 
 namespace algo {
 
@@ -44,6 +45,8 @@ struct AlgoParamInfo {
   std::string description;
   std::string default_value;
   std::string current_value;  // 可用于 UI 显示
+  std::string min_value;      // 数值参数的取值范围，空表示不限制
+  std::string max_value;
 };
 
 struct AlgoSignalInfo {
@@ -71,12 +74,15 @@ class AlgoBase {
    * 这里不在基类构造函数中调用是因为此时派生类还没创建完毕，所以要延迟初始化
    * 不过我们简化处理了，直接在adapter中初始化了，所以基本算是隐藏起来了
    * 而且必须用adapter才能使用算法，我们的设计是很完美的，相当于自动defer初始化
+   * 声明时顺便取得各信号的句柄，之后每帧发送不再按名字查找
    */
   void initialize() {
     auto signals = get_signal_info();
+    signal_handles_.clear();
     for (const auto& sig : signals) {
-      ImageSignalBus::instance().declare_signal(sig.name);
-      declared_signals_.insert(sig.name);
+      const auto handle = ImageSignalBus::instance().declare_signal(sig.name);
+      signal_handles_.push_back(handle);
+      declared_signals_.emplace(sig.name, handle);
     }
   }
 
@@ -89,6 +95,19 @@ class AlgoBase {
    */
   virtual void process(const CapturedFrame& frame) = 0;
 
+  /**
+   * @brief 可选：一次处理一批帧
+   * @param frames 按到达顺序排列，调用期间保证存活
+   *
+   * 默认逐帧调用 process()。需要在多帧之间复用配置快照、
+   * 临时缓冲区或查找表的算法可以重写，线程安全要求与 process() 相同。
+   */
+  virtual void process_batch(std::span<const CapturedFrame* const> frames) {
+    for (const CapturedFrame* frame : frames) {
+      process(*frame);
+    }
+  }
+
   /**
    * @brief 可选：动态配置算法参数
    * @param key 参数名
@@ -103,6 +122,20 @@ class AlgoBase {
     }
   }
 
+  /**
+   * @brief 可选：一次修改多个参数
+   * @param updates (参数名, 参数值) 列表，按顺序应用
+   *
+   * 默认逐个调用 configure()。使用 ParamTable 的算法应当重写为
+   * 全部校验通过后一次发布，处理线程不会看到只更新了一半的配置。
+   */
+  virtual void configure_batch(
+      const std::vector<std::pair<std::string, std::string>>& updates) {
+    for (const auto& [key, value] : updates) {
+      configure(key, value);
+    }
+  }
+
   /**
    * @brief 获取参数值
    * @param key 参数名
@@ -145,6 +178,15 @@ class AlgoBase {
    */
   virtual void get_results() {}
 
+  /**
+   * @brief 可选：各处理阶段的耗时统计（p50/p99/max）
+   *
+   * 可以在任意线程调用，不会阻塞正在处理的帧。
+   */
+  virtual std::vector<StageTimingStats> get_stage_timings() const {
+    return {};
+  }
+
  protected:
   /**
    * @brief 发送处理结果
@@ -153,15 +195,58 @@ class AlgoBase {
    */
   void emit_image(const std::string& name, const cv::Mat& img) {
     assert(!declared_signals_.empty() && "AlgoBase::initialize() not called!");
-    if (declared_signals_.count(name)) {
-      ImageSignalBus::instance().emit(name, img);
+    if (auto it = declared_signals_.find(name); it != declared_signals_.end()) {
+      ImageSignalBus::instance().emit(it->second, img);
+    }
+  }
+
+  /**
+   * @brief 按句柄发送，热路径上用这个
+   * @param signal signal_handle() 取得的句柄，无效句柄直接忽略
+   */
+  void emit_image(ImageSignalBus::SignalHandle signal, const cv::Mat& img) {
+    ImageSignalBus::instance().emit(signal, img);
+  }
+
+  /**
+   * @brief 第 index 个信号（按 get_signal_info() 的顺序）的句柄
+   *
+   * initialize() 之前或越界时返回无效句柄，发送到无效句柄什么也不做。
+   */
+  ImageSignalBus::SignalHandle signal_handle(size_t index) const {
+    return index < signal_handles_.size() ? signal_handles_[index]
+                                          : ImageSignalBus::SignalHandle{};
+  }
+
+  /**
+   * @brief 有订阅者时才生成并发送调试图
+   * @param make_image 返回 cv::Mat，发送后不能再修改
+   *
+   * 没有订阅者时 make_image 不会被调用，调试信号不影响正常检测的耗时。
+   */
+  template <typename MakeImage>
+  void emit_image_if_subscribed(const std::string& name,
+                                MakeImage&& make_image) {
+    if (auto it = declared_signals_.find(name); it != declared_signals_.end()) {
+      ImageSignalBus::instance().emit_if_subscribed(
+          it->second, std::forward<MakeImage>(make_image));
     }
   }
+  template <typename MakeImage>
+  void emit_image_if_subscribed(ImageSignalBus::SignalHandle signal,
+                                MakeImage&& make_image) {
+    ImageSignalBus::instance().emit_if_subscribed(
+        signal, std::forward<MakeImage>(make_image));
+  }
 
-  // 配置映射表，将配置键映射到相应的处理函数
+  // 配置映射表，将配置键映射到相应的处理函数；处理函数可能与 process()
+  // 并发执行，由派生类保证线程安全
   std::unordered_map<std::string, std::function<void(const std::string&)>>
       configMap_;
-  std::unordered_set<std::string> declared_signals_;
+  std::unordered_map<std::string, ImageSignalBus::SignalHandle>
+      declared_signals_;
+  // 与 get_signal_info() 顺序一致
+  std::vector<ImageSignalBus::SignalHandle> signal_handles_;
 };
 /*
  * @breief 宏定义，用于定义算法元信息,提供类似静态反射，获取元信息的功能
@@ -196,6 +281,11 @@ class AlgoAdapter : public FrameProcessor {
       algo_->process(frame);
     }
   }
+  void process_batch(std::span<const CapturedFrame* const> frames) override {
+    if (algo_) {
+      algo_->process_batch(frames);
+    }
+  }
 
  private:
   AlgoPtr algo_;  // 智能指针保证生命周期
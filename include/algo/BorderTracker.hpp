@@ -0,0 +1,88 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: BorderTracker.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "algo/ColumnProfile.hpp"
+
+namespace algo {
+
+/**
+ * @brief 连续带材的左右白边跟踪
+ *
+ * 相邻帧之间材料边缘只移动几个像素，没必要每帧都做整幅二分查找。
+ * 有上一帧的边界时，只在其左右 window 列内寻找白边/内容的分界，
+ * 探测的列数与 window 成正比；分界不在窗口内（跳变）、图像宽度变化、
+ * 或者距离上次完整查找已有 refresh_interval 帧时，退回完整查找。
+ * 换卷时调用 reset()。
+ *
+ * 边界的定义与 find_content_bounds() 相同。多个处理线程可以共用一个
+ * 跟踪器：只在读取上一帧边界和发布结果时加锁，列统计和查找都在锁外进行。
+ * 结果按帧序号发布，比已发布的帧更早的帧（乱序完成）只使用、不覆盖
+ * 跟踪状态；查找期间调用了 reset() 的结果也不会发布。
+ */
+class BorderTracker {
+ public:
+  struct Stats {
+    uint64_t tracked = 0;        // 窗口内找到边界的帧数
+    uint64_t full_searches = 0;  // 完整查找的帧数
+  };
+
+  explicit BorderTracker(int window = 64, uint32_t refresh_interval = 256)
+      : window_(window), refresh_interval_(refresh_interval) {}
+
+  // sequence 为帧的采集序号，用来丢弃乱序完成的旧帧的结果
+  std::pair<int, int> update(ColumnProfile& profile, double ratio,
+                             uint64_t sequence = 0);
+
+  // 丢弃上一帧的边界，下一帧做完整查找
+  void reset();
+
+  Stats stats() const;
+
+ private:
+  bool track_left(ColumnProfile& profile, double ratio, int& x) const;
+  bool track_right(ColumnProfile& profile, double ratio, int& x) const;
+
+  const int window_;
+  const uint32_t refresh_interval_;
+
+  mutable std::mutex mutex_;
+  bool valid_ = false;
+  int width_ = 0;
+  int x_min_ = 0;
+  int x_max_ = 0;
+  uint32_t since_full_ = 0;
+  uint64_t sequence_ = 0;    // 已发布边界的帧序号
+  uint64_t generation_ = 0;  // reset() 时递增，作废进行中的查找
+  Stats stats_;
+};
+
+}  // namespace algo
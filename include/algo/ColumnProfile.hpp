@@ -0,0 +1,98 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ColumnProfile.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <utility>
+#include <vector>
+
+namespace algo {
+
+/**
+ * @brief 统计 [x_begin, x_end) 每一列中灰度 > threshold 的采样行数
+ *
+ * 按行优先顺序只扫一遍采样行（第 0, row_step, 2*row_step ... 行），
+ * 每行用 SIMD 比较后累加到 8 位计数器，每 255 行再加宽到 counts，
+ * 避免逐列跨行读取。counts 至少要有 x_end - x_begin 个元素。
+ *
+ * @return 采样的行数
+ */
+int count_bright_columns(const cv::Mat& gray, int row_step, uint8_t threshold,
+                         int x_begin, int x_end, uint32_t* counts);
+
+// 整幅图像的列统计，counts 会被调整为 gray.cols 个元素
+int count_bright_columns(const cv::Mat& gray, int row_step, uint8_t threshold,
+                         std::vector<uint32_t>& counts);
+
+/**
+ * @brief 按需计算的列统计
+ *
+ * 二分查找只访问 log2(width) 列，整幅统计要读完所有采样行，反而比逐列
+ * 读取慢一个数量级。这里按 32 列为一块，第一次访问某列时把整块算出来：
+ * 每个采样行只多读同一缓存行内的相邻字节，计数器全程在寄存器中，
+ * 同一块内后续的探测不再访问图像。
+ * 可以用 reset() 复用内部缓冲区，长期持有（如 thread_local）时
+ * 用完调用 release()，避免一直引用上一帧的图像。
+ */
+class ColumnProfile {
+ public:
+  static constexpr int kBlockColumns = 32;
+
+  ColumnProfile() = default;
+  ColumnProfile(const cv::Mat& gray, int row_step, uint8_t threshold) {
+    reset(gray, row_step, threshold);
+  }
+
+  void reset(const cv::Mat& gray, int row_step, uint8_t threshold);
+  // 放开对图像的引用，保留内部缓冲区；之后要先 reset() 才能再用
+  void release();
+
+  uint32_t count(int x);
+  int width() const { return gray_.cols; }
+  int sampled_rows() const { return sampled_rows_; }
+
+ private:
+  cv::Mat gray_;
+  int row_step_ = 1;
+  uint8_t threshold_ = 0;
+  int sampled_rows_ = 0;
+  std::vector<uint32_t> counts_;
+  std::vector<uint8_t> ready_;  // 每块是否已经计算
+};
+
+/**
+ * @brief 在列统计上二分查找左右内容边界
+ *
+ * 某列的亮像素比例 > ratio 视为白边。只有第一列（最后一列）是白边时
+ * 才查找左（右）边界，否则对应边界为 0（width - 1）。
+ *
+ * @return {x_min, x_max}：左边第一个非白边列，右边最后一个非白边列
+ */
+std::pair<int, int> find_content_bounds(ColumnProfile& profile, double ratio);
+
+}  // namespace algo
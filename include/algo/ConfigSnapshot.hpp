@@ -0,0 +1,99 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ConfigSnapshot.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace algo {
+
+/**
+ * @brief 不可变的配置快照，读者一次加载拿到整份配置
+ *
+ * 写者复制当前快照、修改副本，再原子地发布新快照（RCU 方式）。
+ * 读者持有的 shared_ptr 保证旧快照在用完之前不会被释放，
+ * 处理线程不需要每帧复制配置，也不用等写者复制、修改配置。
+ * 写者之间用互斥锁串行化，避免并发的修改互相覆盖。
+ *
+ * 注意 std::atomic<std::shared_ptr> 在 libstdc++ 和 MSVC 上不是无锁的
+ * （is_lock_free() 为 false），load()/store() 内部会短暂持有一个锁，
+ * 读者与发布新快照的写者之间仍可能有很短的互相等待，但不会等到整个
+ * update() 完成。
+ */
+template <typename T>
+class ConfigSnapshot {
+ public:
+  using Ptr = std::shared_ptr<const T>;
+
+  ConfigSnapshot() : current_(std::make_shared<const T>()) {}
+  explicit ConfigSnapshot(T initial)
+      : current_(std::make_shared<const T>(std::move(initial))) {}
+
+  ConfigSnapshot(const ConfigSnapshot&) = delete;
+  ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+  // 当前快照，不会为空；内部可能短暂加锁（见类注释）
+  Ptr load() const { return current_.load(std::memory_order_acquire); }
+
+  // 发布的次数，可用来判断快照是否变化
+  uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief 在当前快照的副本上执行 modify(T&) 并发布
+   *
+   * modify 抛出异常时不发布，当前快照保持不变。
+   */
+  template <typename Fn>
+  void update(Fn&& modify) {
+    std::lock_guard lock(writer_mutex_);
+    T next = *current_.load(std::memory_order_relaxed);
+    std::forward<Fn>(modify)(next);
+    publish_locked(std::move(next));
+  }
+
+  // 整体替换
+  void store(T value) {
+    std::lock_guard lock(writer_mutex_);
+    publish_locked(std::move(value));
+  }
+
+ private:
+  void publish_locked(T value) {
+    current_.store(std::make_shared<const T>(std::move(value)),
+                   std::memory_order_release);
+    version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  std::atomic<Ptr> current_;
+  std::atomic<uint64_t> version_{0};
+  std::mutex writer_mutex_;
+};
+
+}  // namespace algo
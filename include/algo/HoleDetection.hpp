@@ -26,11 +26,21 @@
 
 #pragma once
 
-#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "AlgoBase.hpp"
+#include "ImageWriter.hpp"
+#include "ProcessingExecutor.hpp"
 #include "algo/AlgorithmConfigTraits.hpp"
+#include "algo/BorderTracker.hpp"
+#include "algo/ConfigSnapshot.hpp"
 #include "config/AlogoParams.hpp"
 #include "config/ConfigObserver.hpp"
 namespace algo {
@@ -52,6 +62,16 @@ struct PartitionConfig {
   int right_thresh = 20;
 };
 
+// 逐帧工作区的统计，工作区每个处理线程一份，跨帧复用
+struct HoleScratchStats {
+  uint64_t frames = 0;  // 处理过的帧数
+  // 处理前后工作区的总容量或灰度缓冲区地址发生变化的帧数。统计的是
+  // 容量变化而不是分配次数：容量不变的临时分配（例如 OpenCV 内部的）
+  // 和工作区之外的分配都不计入
+  uint64_t growth_frames = 0;
+  size_t peak_reserved_bytes = 0;  // 单个线程工作区占用的最大容量
+};
+
 class HoleDetection : public AlgoBase {
  public:
   ALGO_METADATA("HoleDetection", "针孔检测")
@@ -60,19 +80,62 @@ class HoleDetection : public AlgoBase {
   HoleDetection();
   explicit HoleDetection(const Config& cfg);
   void process(const CapturedFrame& frame) override;
+  // 一批帧共用一次配置快照和执行器，未配置证据输出时复用灰度转换缓冲区
+  void process_batch(std::span<const CapturedFrame* const> frames) override;
+
+  // 参数按参数表解析校验，非法值抛出 std::invalid_argument 且配置不变；
+  // 批量修改全部通过后一次发布
+  void configure(const std::string& key, const std::string& value) override;
+  void configure_batch(
+      const std::vector<std::pair<std::string, std::string>>& updates) override;
 
   std::vector<AlgoParamInfo> get_parameter_info() const override;
   std::vector<AlgoSignalInfo> get_signal_info() const override;
+  std::vector<StageTimingStats> get_stage_timings() const override;
 
+  // 帧尺寸稳定后 growth_frames 应当不再增加（配置了证据输出时的
+  // 标注图和 greedy 合并方式除外）
+  HoleScratchStats get_scratch_stats() const;
+
+  // 整体替换配置（ini 热加载），按参数表校验，非法值抛出
+  // std::invalid_argument 且配置不变
   void update_config(const Config& new_cfg);
 
+  // 证据图（processed/contours/bbox）交给 writer 异步保存到 output_dir，
+  // 是否保存由 writer 的 EvidenceMode 决定；writer 为空时关闭
+  void set_evidence_writer(std::shared_ptr<ImageWriter> writer,
+                           std::string output_dir);
+
+  // 换卷或相机视野变化后调用，下一帧重新完整查找左右白边
+  void reset_border_tracking();
+
  private:
-  void parse_partition_params();
+  // 处理一帧需要的全部配置，整体作为一个不可变快照发布
+  struct Settings {
+    Config config;
+    PartitionConfig parsed_params;  // 由 config.partition_params 解析
+    std::shared_ptr<ImageWriter> evidence_writer;
+    std::string evidence_dir;
+  };
+
+  static void parse_partition_params(Settings& settings);
+  void process_frames(std::span<const CapturedFrame* const> frames);
+  std::shared_ptr<ProcessingExecutor::Lane> acquire_band_lane(size_t workers);
 
  private:
-  Config config_;
-  PartitionConfig parsed_params_;
-  mutable std::shared_mutex config_mutex_;
+  ConfigSnapshot<Settings> settings_;  // 处理线程每批加载一次，不复制配置
+  BorderTracker border_tracker_;  // 视频帧的白边跟踪，内部加锁
+  StageTimings stage_timings_;    // 各阶段耗时，阶段见 HoleDetection.cpp
+
+  // 分带并行标记用的 lane（parallel_bands > 1 时按需申请），
+  // worker 计入 ProcessingExecutor 的预算，多个处理线程共用
+  std::mutex band_lane_mutex_;
+  std::shared_ptr<ProcessingExecutor::Lane> band_lane_;
+  size_t band_workers_ = 0;  // 申请 band_lane_ 时请求的 worker 数
+
+  std::atomic<uint64_t> scratch_frames_{0};
+  std::atomic<uint64_t> scratch_growths_{0};
+  std::atomic<size_t> scratch_peak_bytes_{0};
 };
 
 }  // namespace algo
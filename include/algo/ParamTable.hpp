@@ -0,0 +1,290 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ParamTable.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <charconv>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algo/AlgoBase.hpp"
+
+namespace algo {
+
+namespace param_detail {
+
+inline std::string_view trim(std::string_view text) {
+  const auto first = text.find_first_not_of(" \t\r\n");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  const auto last = text.find_last_not_of(" \t\r\n");
+  return text.substr(first, last - first + 1);
+}
+
+// 整个字符串都必须是数字，"12abc" 之类的输入视为错误
+template <typename T>
+bool parse_number(std::string_view text, T& out) {
+  text = trim(text);
+  if (!text.empty() && text.front() == '+') {
+    text.remove_prefix(1);
+  }
+  const char* end = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), end, out);
+  return ec == std::errc() && ptr == end && !text.empty();
+}
+
+inline bool parse_value(std::string_view text, int& out) {
+  return parse_number(text, out);
+}
+
+inline bool parse_value(std::string_view text, float& out) {
+  return parse_number(text, out);
+}
+
+inline bool parse_value(std::string_view text, double& out) {
+  return parse_number(text, out);
+}
+
+inline bool parse_value(std::string_view text, bool& out) {
+  text = trim(text);
+  if (text == "1" || text == "true") {
+    out = true;
+    return true;
+  }
+  if (text == "0" || text == "false") {
+    out = false;
+    return true;
+  }
+  return false;
+}
+
+inline bool parse_value(std::string_view text, std::string& out) {
+  out.assign(trim(text));
+  return true;
+}
+
+// 数值按最短的可往返形式输出，例如 0.05586f -> "0.05586"
+template <typename T>
+std::string format_value(const T& value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return value ? "1" : "0";
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return value;
+  } else {
+    char buffer[64];
+    const auto result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+  }
+}
+
+template <typename T>
+constexpr const char* type_name() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return "bool";
+  } else if constexpr (std::is_integral_v<T>) {
+    return "int";
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return "float";
+  } else {
+    return "string";
+  }
+}
+
+}  // namespace param_detail
+
+/**
+ * @brief 算法参数的描述表：名称、类型、默认值、范围和 Config 中的成员
+ *
+ * 每个参数用成员指针注册一次，表据此生成 get_parameter_info() 的内容、
+ * 解析并校验字符串形式的新值、填充默认配置。字符串解析只发生在
+ * configure() 时，处理线程读到的都是已经解析好的强类型字段。
+ *
+ * 解析失败、超出范围或校验函数返回 false 时抛出 std::invalid_argument；
+ * apply_all() 先在副本上应用全部更新，全部成功后才写回，
+ * 配合 ConfigSnapshot::update() 可以原子地发布一组更新。
+ * 不经过字符串、整体替换的 Config（例如从 ini 热加载）用 validate() 校验。
+ *
+ * 表在运行时构建（通常是函数内的静态变量，只构建一次），校验函数和
+ * 赋值都存成 std::function：字符串参数的校验需要任意的可调用对象，
+ * std::string 默认值也不能放进 constexpr 描述符。每次只在 configure()
+ * 时查表，不在处理线程的热路径上。
+ */
+template <typename Config>
+class ParamTable {
+ public:
+  template <typename T>
+  using Validator = std::function<bool(const T&)>;
+
+  // 数值参数，[min_value, max_value] 为闭区间
+  template <typename T>
+    requires std::is_arithmetic_v<T> && (!std::is_same_v<T, bool>)
+  ParamTable& add(std::string name, T Config::*field, std::string description,
+                  T default_value,
+                  T min_value = std::numeric_limits<T>::lowest(),
+                  T max_value = std::numeric_limits<T>::max()) {
+    AlgoParamInfo info = make_info<T>(std::move(name), std::move(description),
+                                      default_value);
+    if (min_value != std::numeric_limits<T>::lowest()) {
+      info.min_value = param_detail::format_value(min_value);
+    }
+    if (max_value != std::numeric_limits<T>::max()) {
+      info.max_value = param_detail::format_value(max_value);
+    }
+    add_entry<T>(std::move(info), field,
+                 [min_value, max_value](const T& value) {
+                   return value >= min_value && value <= max_value;
+                 });
+    return *this;
+  }
+
+  // 布尔或字符串参数，check 为空时不额外校验
+  template <typename T>
+    requires std::is_same_v<T, bool> || std::is_same_v<T, std::string>
+  ParamTable& add(std::string name, T Config::*field, std::string description,
+                  T default_value, Validator<T> check = {}) {
+    AlgoParamInfo info = make_info<T>(std::move(name), std::move(description),
+                                      default_value);
+    add_entry<T>(std::move(info), field, std::move(check));
+    return *this;
+  }
+
+  bool contains(std::string_view name) const { return find(name) != nullptr; }
+
+  // 解析 value 写入 cfg 的对应字段；未知参数或非法值抛出 std::invalid_argument
+  void apply(Config& cfg, std::string_view name, std::string_view value) const {
+    const Entry* entry = find(name);
+    if (!entry) {
+      throw std::invalid_argument("unknown parameter: " + std::string(name));
+    }
+    entry->assign(cfg, value);
+  }
+
+  // 全部成功才修改 cfg，任何一项失败时 cfg 保持不变
+  void apply_all(
+      Config& cfg,
+      const std::vector<std::pair<std::string, std::string>>& updates) const {
+    Config next = cfg;
+    for (const auto& [name, value] : updates) {
+      apply(next, name, value);
+    }
+    cfg = std::move(next);
+  }
+
+  // 按表中的范围和校验函数检查 cfg 的每个字段，第一个非法值抛出
+  // std::invalid_argument
+  void validate(const Config& cfg) const {
+    for (const Entry& entry : entries_) {
+      entry.validate(cfg);
+    }
+  }
+
+  // 所有参数取默认值
+  void apply_defaults(Config& cfg) const {
+    for (const Entry& entry : entries_) {
+      entry.assign(cfg, entry.info.default_value);
+    }
+  }
+
+  // 按注册顺序生成参数信息，current_value 取自 cfg
+  std::vector<AlgoParamInfo> describe(const Config& cfg) const {
+    std::vector<AlgoParamInfo> infos;
+    infos.reserve(entries_.size());
+    for (const Entry& entry : entries_) {
+      AlgoParamInfo info = entry.info;
+      info.current_value = entry.format(cfg);
+      infos.push_back(std::move(info));
+    }
+    return infos;
+  }
+
+ private:
+  struct Entry {
+    AlgoParamInfo info;
+    std::function<void(Config&, std::string_view)> assign;  // 解析+校验+写入
+    std::function<std::string(const Config&)> format;
+    std::function<void(const Config&)> validate;  // 校验已有字段
+  };
+
+  template <typename T>
+  static AlgoParamInfo make_info(std::string name, std::string description,
+                                 const T& default_value) {
+    AlgoParamInfo info;
+    info.name = std::move(name);
+    info.type = param_detail::type_name<T>();
+    info.description = std::move(description);
+    info.default_value = param_detail::format_value(default_value);
+    return info;
+  }
+
+  template <typename T>
+  void add_entry(AlgoParamInfo info, T Config::*field, Validator<T> check) {
+    Entry entry;
+    entry.assign = [name = info.name, field, check](Config& cfg,
+                                                    std::string_view text) {
+      T value{};
+      if (!param_detail::parse_value(text, value) || (check && !check(value))) {
+        throw std::invalid_argument("invalid value for " + name + ": " +
+                                    std::string(text));
+      }
+      cfg.*field = std::move(value);
+    };
+    entry.validate = [name = info.name, field,
+                      check = std::move(check)](const Config& cfg) {
+      if (check && !check(cfg.*field)) {
+        throw std::invalid_argument(
+            "invalid value for " + name + ": " +
+            param_detail::format_value(cfg.*field));
+      }
+    };
+    entry.format = [field](const Config& cfg) {
+      return param_detail::format_value(cfg.*field);
+    };
+    entry.info = std::move(info);
+    entries_.push_back(std::move(entry));
+  }
+
+  const Entry* find(std::string_view name) const {
+    for (const Entry& entry : entries_) {
+      if (entry.info.name == name) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<Entry> entries_;
+};
+
+}  // namespace algo
@@ -0,0 +1,66 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: PointClustering.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace algo {
+
+/**
+ * @brief 基于均匀网格 + 并查集的距离聚类（single-linkage）
+ *
+ * 距离不超过 distance 的两点属于同一簇，且具有传递性。网格边长取 distance，
+ * 每个点只需要和相邻 3x3 个格子里的点比较（平方距离，不开方），
+ * 点分布不过度密集时接近线性时间。
+ *
+ * 返回每个点的簇编号，编号按簇中最小的点下标从 0 开始连续分配，
+ * 与输入顺序之外的因素无关，结果是确定的。
+ */
+std::vector<int> cluster_points_grid(const std::vector<cv::Point>& points,
+                                     int distance);
+
+// cluster_points_grid() 的临时缓冲区，跨调用复用时不再重复分配
+struct GridClusterScratch {
+  std::vector<std::pair<int64_t, int>> cells;
+  std::vector<int> parent;
+  std::vector<int> root_label;
+
+  size_t reserved_bytes() const {
+    return cells.capacity() * sizeof(cells[0]) +
+           parent.capacity() * sizeof(int) + root_label.capacity() * sizeof(int);
+  }
+};
+
+// 同上，结果写入 labels，临时缓冲区取自 scratch
+void cluster_points_grid(std::span<const cv::Point> points, int distance,
+                         GridClusterScratch& scratch, std::vector<int>& labels);
+
+}  // namespace algo
@@ -0,0 +1,127 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ThresholdComponents.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <span>
+#include <vector>
+
+namespace algo {
+
+// 列区间 [上一段的 end_col, end_col) 内灰度 > thresh 的像素为前景
+struct ColumnThreshold {
+  int end_col;
+  int thresh;
+};
+
+// 与 connectedComponentsWithStats 的一行 stats + centroids 对应
+struct ComponentStats {
+  int left = 0;
+  int top = 0;
+  int width = 0;
+  int height = 0;
+  int area = 0;
+  double cx = 0.0;  // 质心
+  double cy = 0.0;
+};
+
+// 执行 count 个相互独立的任务 task(0) ... task(count - 1)，返回时全部完成
+using BandRunner =
+    std::function<void(size_t count, const std::function<void(size_t)>& task)>;
+
+/**
+ * @brief 分区阈值 + 8 连通标记，一遍扫描完成
+ *
+ * 等价于先按列分区做 THRESH_BINARY 再做 connectedComponentsWithStats，
+ * 但不生成二值图和标签图：每行用 SIMD 比较得到位掩码，提取前景游程，
+ * 与上一行的游程做并查集合并，同时累加面积/外接框/质心。
+ * 内存占用只与每行的游程数和连通域数有关。
+ *
+ * 输出按连通域在光栅扫描中第一次出现的顺序排列（不含背景）。
+ * 最后一个分区的 end_col 之后的列按最后一个分区的阈值处理。
+ */
+std::vector<ComponentStats> threshold_components(
+    const cv::Mat& gray, std::span<const ColumnThreshold> partitions);
+
+/**
+ * @brief 标记过程用到的临时缓冲区（位掩码、游程、并查集、累加量等）
+ *
+ * 跨帧复用同一个对象时容量按见过的最大帧保留，稳定后不再分配。
+ * 不能被多个线程同时使用。
+ */
+class ComponentScratch {
+ public:
+  ComponentScratch();
+  ~ComponentScratch();
+  ComponentScratch(ComponentScratch&&) noexcept;
+  ComponentScratch& operator=(ComponentScratch&&) noexcept;
+
+  // 所有缓冲区当前占用的容量（字节）
+  size_t reserved_bytes() const;
+
+ private:
+  friend void threshold_components(const cv::Mat&,
+                                   std::span<const ColumnThreshold>,
+                                   ComponentScratch&,
+                                   std::vector<ComponentStats>&);
+  friend void threshold_components_banded(const cv::Mat&,
+                                          std::span<const ColumnThreshold>,
+                                          size_t, const BandRunner&,
+                                          ComponentScratch&,
+                                          std::vector<ComponentStats>&);
+  struct Buffers;
+  std::unique_ptr<Buffers> buffers_;
+};
+
+// 同上，临时缓冲区取自 scratch，结果写入 components（先清空，保留容量）
+void threshold_components(const cv::Mat& gray,
+                          std::span<const ColumnThreshold> partitions,
+                          ComponentScratch& scratch,
+                          std::vector<ComponentStats>& components);
+
+/**
+ * @brief threshold_components() 的分带并行版本
+ *
+ * 图像按行切成 bands 个不重叠的行带，由 run 并行标记；每个行带保留首末行
+ * 的游程，接缝两侧 8 邻接的游程所属的连通域再用并查集合并。结果（包括
+ * 顺序）与单线程版本完全一致。bands <= 1 或 run 为空时直接走单线程版本。
+ */
+std::vector<ComponentStats> threshold_components_banded(
+    const cv::Mat& gray, std::span<const ColumnThreshold> partitions,
+    size_t bands, const BandRunner& run);
+
+// 同上，每个行带使用 scratch 中各自的缓冲区
+void threshold_components_banded(const cv::Mat& gray,
+                                 std::span<const ColumnThreshold> partitions,
+                                 size_t bands, const BandRunner& run,
+                                 ComponentScratch& scratch,
+                                 std::vector<ComponentStats>& components);
+
+}  // namespace algo
@@ -33,7 +33,8 @@
 
 struct CameraConfig;
 class CameraCapture;
-enum class CameraBrand { DVP, IK, MIND };
+// Replay 是软件相机，identifier 为录像文件或图片目录的路径
+enum class CameraBrand { DVP, IK, MIND, Replay };
 
 std::unique_ptr<CameraCapture> create_camera(const CameraBrand& brand,
                                              const std::string& identifier,
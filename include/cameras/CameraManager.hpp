@@ -59,7 +59,7 @@ class CameraManager {
 
   // 相机操作
   bool start_camera(const std::string& camera_id,
-                    const FrameProcessor& processor);
+                    std::shared_ptr<FrameProcessor> processor);
   void stop_camera(const std::string& camera_id);
 
  private:
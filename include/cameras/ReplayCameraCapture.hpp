@@ -0,0 +1,143 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReplayCameraCapture.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+#include "BoundedFrameQueue.hpp"
+#include "CameraCapture.hpp"
+#include "FrameBufferPool.hpp"
+#include "FramePipeline.hpp"
+#include "FrameProcessor.hpp"
+#include "FrameProcessorChain.hpp"
+#include "ProcessingExecutor.hpp"
+#include "protocol/messages.hpp"
+
+// 回放参数
+struct ReplayConfig {
+  // 录像文件（.dvpr）、录像分段目录、图片目录或单张图片
+  std::string source;
+  double fps = 0.0;        // 输出帧率，0 表示不限速（尽可能快）
+  double line_rate = 0.0;  // 线扫行频（行/秒），非 0 时按 帧高/行频 出帧
+  bool loop = true;        // 播完后从头开始
+  uint64_t max_frames = 0;  // 最多输出的帧数，0 表示不限制
+};
+
+class ReplaySource;
+
+/**
+ * @brief 软件相机：从录像或图片回放帧
+ *
+ * 帧走与 DvpCameraCapture 完全相同的 FramePipeline（缓冲池、准入策略、
+ * 处理阶段、原始图像队列），用于在没有相机的机器上做性能测试和回归测试。
+ * 录像按分段流式读取；图片目录在 start() 时一次性解码并缓存在内存中。
+ */
+class ReplayCameraCapture : public CameraCapture {
+ public:
+  explicit ReplayCameraCapture(ReplayConfig config);
+  ~ReplayCameraCapture() override;
+
+  bool start() override;
+  // 追加一个处理阶段后启动
+  bool start(std::shared_ptr<FrameProcessor> processor) override;
+  void stop() override;
+  // 使用 acquisition_frame_rate(_enable) 和 roi_*，其余参数对回放无意义
+  void set_config(const CameraConfig& cfg) override;
+  // 在回放的帧上裁剪 ROI，宽或高为 0 表示不裁剪
+  void set_roi(int x, int y, int width, int height) override;
+
+  moodycamel::ConcurrentQueue<CapturedFramePtr>& get_frame_queue() override {
+    return pipeline_.frame_queue();
+  }
+
+  // 采集过程中可修改
+  void set_frame_rate(double fps) { fps_ = fps; }
+  void set_line_rate(double lines_per_second) { line_rate_ = lines_per_second; }
+
+  // 与 DvpCameraCapture 相同的管线接口
+  protocol::FrontendStatus get_status() const;
+  void set_admission_config(const FrameAdmissionConfig& cfg);
+  void set_worker_budget(const WorkerBudget& budget);
+  size_t add_frame_processor(std::shared_ptr<FrameProcessor> processor,
+                             std::string name = {});
+  bool set_frame_processor_enabled(size_t index, bool enabled);
+  bool set_frame_processor_enabled(const std::string& name, bool enabled);
+  const FrameProcessorChain& get_frame_processors() const {
+    return pipeline_.processors();
+  }
+  FrameBufferPool::Stats get_frame_pool_stats() const {
+    return pipeline_.frame_pool_stats();
+  }
+
+  // 已送入管线的帧数
+  uint64_t frames_emitted() const { return frames_emitted_.load(); }
+
+  // 等待回放结束（非循环播放完或达到 max_frames）且处理任务全部完成，
+  // 超时返回 false
+  bool wait_for_finish(std::chrono::milliseconds timeout);
+
+ private:
+  void replay_loop();
+  // 按 ROI 把 source 裁剪进 target，ROI 无效时返回 false
+  struct Roi {
+    int x = 0, y = 0, width = 0, height = 0;
+  };
+  static bool crop_into(const CapturedFrame& source, const Roi& roi,
+                        CapturedFrame& target);
+  std::chrono::nanoseconds frame_interval(int height) const;
+  void update_status(const protocol::FrontendStatus& new_status);
+
+  ReplayConfig config_;
+  std::unique_ptr<ReplaySource> source_;
+
+  std::atomic<double> fps_;
+  std::atomic<double> line_rate_;
+  Roi roi_;
+  mutable std::mutex roi_mutex_;
+
+  std::atomic<bool> running_{false};
+  std::atomic<uint64_t> frames_emitted_{0};
+  std::thread worker_;
+
+  std::mutex finish_mutex_;
+  std::condition_variable finish_cv_;
+  bool finished_ = false;
+
+  protocol::FrontendStatus current_status_;
+  mutable std::shared_mutex status_mutex_;
+
+  // 放在最后：析构时最先等待处理任务结束
+  FramePipeline pipeline_;
+};
@@ -69,6 +69,9 @@ inline std::string get_default_config_path() {
   return get_config_file_path();
 }
 
+// parallel_bands 的上限
+inline constexpr int kMaxParallelBands = 64;
+
 struct HoleDetectionConfig {
   float pixel_per_mm;
   bool enable_real_world_calculation;
@@ -78,6 +81,8 @@ struct HoleDetectionConfig {
   float pixel_to_mm_width;
   float pixel_to_mm_height;
   std::string partition_params;
+  std::string merge_strategy = "grid";  // grid: 网格聚类, greedy: 逐对合并
+  int parallel_bands = 1;  // 大图按行分带并行标记的带数，1 表示不分带
 
   static HoleDetectionConfig load(inicpp::IniManager &ini) {
     try {
@@ -124,6 +129,22 @@ struct HoleDetectionConfig {
               ? "0.3,0.4,0.3,20,23,20"
               : hole_section["partition_params"].String();
 
+      config.merge_strategy =
+          hole_section["merge_strategy"].String().empty()
+              ? "grid"
+              : hole_section["merge_strategy"].String();
+
+      config.parallel_bands =
+          hole_section["parallel_bands"].String().empty()
+              ? 1
+              : static_cast<int>(hole_section["parallel_bands"]);
+      if (config.parallel_bands < 1 ||
+          config.parallel_bands > kMaxParallelBands) {
+        std::cerr << "Invalid parallel_bands " << config.parallel_bands
+                  << ", using 1" << std::endl;
+        config.parallel_bands = 1;
+      }
+
       return config;
     } catch (const std::exception &e) {
       std::cerr << "Exception: " << e.what()
@@ -151,6 +172,10 @@ struct HoleDetectionConfig {
             "像素到毫米高度转换系数");
     ini.set("hole_detection", "partition_params", "0.3,0.4,0.3,20,23,20",
             "分区参数(左中右比例和阈值)");
+    ini.set("hole_detection", "merge_strategy", "grid",
+            "孔洞合并方式(grid: 网格聚类, greedy: 逐对合并)");
+    ini.set("hole_detection", "parallel_bands", 1,
+            "单帧分带并行的带数(1: 不分带)");
   }
 };
 
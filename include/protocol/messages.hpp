@@ -63,6 +63,16 @@ struct FeatureReport {
   std::vector<uint8_t> image_data;                  // 图片数据
 };
 
+/// @brief 帧队列准入统计（本地诊断用，不参与协议编码）
+struct QueueStats {
+  uint64_t admitted = 0;        // 成功入队的帧数
+  uint64_t dropped_oldest = 0;  // drop-oldest：被新帧挤掉的旧帧
+  uint64_t dropped_newest = 0;  // drop-newest：直接丢弃的新帧
+  uint64_t timed_out = 0;       // block-with-timeout：等待超时后丢弃的帧
+  uint64_t decimated = 0;       // keep-every-Nth：抽帧丢弃的帧
+  uint64_t depth = 0;           // 当前队列深度（近似值）
+};
+
 /// @brief 前端机状态（32位）
 struct FrontendStatus {
   bool self_check = false;     // index1: 系统自检状态
@@ -70,6 +80,10 @@ struct FrontendStatus {
   bool file_io = false;        // index3: 文件读写
   bool image_anomaly = false;  // index6: 图像异常
 
+  // 本地诊断信息，不参与 to_uint32() 编码
+  QueueStats processing_queue;  // 算法处理队列
+  QueueStats raw_queue;         // 原始图像队列
+
   /// 转换为 32 位状态整数（按协议要求）
   uint32_t to_uint32() const {
     uint32_t status = 0;
@@ -0,0 +1,192 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: BatchingFrameProcessor.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "BatchingFrameProcessor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class BatchingFrameProcessor::State {
+ public:
+  State(std::shared_ptr<FrameProcessor> inner, BatchingConfig cfg)
+      : inner_(std::move(inner)), cfg_(cfg) {
+    cfg_.max_frames = std::max<size_t>(1, cfg_.max_frames);
+    pending_.reserve(cfg_.max_frames);
+    timer_ = std::thread([this] { timer_loop(); });
+  }
+
+  ~State() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    timer_.join();
+    flush();
+  }
+
+  void add(const CapturedFrame& frame) {
+    std::vector<CapturedFramePtr> ready;
+    {
+      std::lock_guard lock(mutex_);
+      if (pending_.empty()) {
+        // 新批次的第一帧决定截止时间，唤醒定时线程按新的截止时间等待
+        deadline_ = std::chrono::steady_clock::now() + cfg_.max_delay;
+        cv_.notify_one();
+      }
+      pending_.push_back(retain_frame(frame));
+      if (pending_.size() >= cfg_.max_frames) {
+        ready = take_locked();
+      }
+    }
+    run(ready);
+  }
+
+  void flush() {
+    std::vector<CapturedFramePtr> ready;
+    {
+      std::lock_guard lock(mutex_);
+      ready = take_locked();
+    }
+    run(ready);
+  }
+
+  Stats stats() const {
+    Stats s;
+    s.batches = batches_.load();
+    s.frames = frames_.load();
+    s.timed_out = timed_out_.load();
+    return s;
+  }
+
+  const BatchingConfig& config() const { return cfg_; }
+  FrameProcessor* inner() const { return inner_.get(); }
+
+ private:
+  std::vector<CapturedFramePtr> take_locked() {
+    std::vector<CapturedFramePtr> ready;
+    ready.swap(pending_);
+    pending_.reserve(cfg_.max_frames);
+    return ready;
+  }
+
+  void run(const std::vector<CapturedFramePtr>& batch) {
+    if (batch.empty()) {
+      return;
+    }
+    std::vector<const CapturedFrame*> frames;
+    frames.reserve(batch.size());
+    for (const auto& frame : batch) {
+      frames.push_back(frame.get());
+    }
+    if (inner_) {
+      inner_->process_batch(frames);
+    }
+    ++batches_;
+    frames_ += frames.size();
+  }
+
+  void timer_loop() {
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+      if (pending_.empty()) {
+        cv_.wait(lock);
+        continue;
+      }
+      if (std::chrono::steady_clock::now() < deadline_) {
+        cv_.wait_until(lock, deadline_);
+        continue;
+      }
+      auto ready = take_locked();
+      ++timed_out_;
+      lock.unlock();
+      try {
+        run(ready);
+      } catch (const std::exception& e) {
+        // 定时线程上的异常没有调用方可以接住，记录后继续攒批
+        std::cerr << "BatchingFrameProcessor: " << e.what() << std::endl;
+      }
+      lock.lock();
+    }
+  }
+
+  std::shared_ptr<FrameProcessor> inner_;
+  BatchingConfig cfg_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<CapturedFramePtr> pending_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool stopping_ = false;
+  std::thread timer_;
+
+  std::atomic<uint64_t> batches_{0};
+  std::atomic<uint64_t> frames_{0};
+  std::atomic<uint64_t> timed_out_{0};
+};
+
+BatchingFrameProcessor::BatchingFrameProcessor(
+    std::shared_ptr<FrameProcessor> inner, BatchingConfig cfg)
+    : state_(std::make_shared<State>(std::move(inner), cfg)) {}
+
+void BatchingFrameProcessor::process(const CapturedFrame& frame) {
+  state_->add(frame);
+}
+
+void BatchingFrameProcessor::process_batch(
+    std::span<const CapturedFrame* const> frames) {
+  for (const CapturedFrame* frame : frames) {
+    state_->add(*frame);
+  }
+}
+
+void BatchingFrameProcessor::on_dropped(uint64_t sequence) {
+  if (auto* inner = state_->inner()) {
+    inner->on_dropped(sequence);
+  }
+}
+
+void BatchingFrameProcessor::flush() {
+  state_->flush();
+  if (auto* inner = state_->inner()) {
+    inner->flush();
+  }
+}
+
+BatchingFrameProcessor::Stats BatchingFrameProcessor::stats() const {
+  return state_->stats();
+}
+
+const BatchingConfig& BatchingFrameProcessor::config() const {
+  return state_->config();
+}
@@ -0,0 +1,129 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: BoundedFrameQueue.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "BoundedFrameQueue.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+BoundedFrameQueue::BoundedFrameQueue(size_t capacity,
+                                     BackpressurePolicy policy)
+    : queue_(capacity), capacity_(std::max<size_t>(1, capacity)),
+      policy_(policy) {}
+
+void BoundedFrameQueue::configure(size_t capacity,
+                                  const FrameAdmissionConfig& cfg) {
+  capacity_ = std::max<size_t>(1, capacity);
+  policy_ = cfg.policy;
+  block_timeout_us_ = cfg.block_timeout.count();
+  keep_every_n_ = std::max<uint32_t>(1, cfg.keep_every_n);
+}
+
+BoundedFrameQueue::Admission BoundedFrameQueue::push(CapturedFramePtr frame) {
+  if (!full()) {
+    pressure_arrivals_ = 0;
+    queue_.enqueue(std::move(frame));
+    ++admitted_;
+    return Admission::Admitted;
+  }
+
+  switch (policy_.load()) {
+    case BackpressurePolicy::DropOldest:
+      return replace_oldest(std::move(frame));
+
+    case BackpressurePolicy::DropNewest:
+      ++dropped_newest_;
+      return reject(frame);
+
+    case BackpressurePolicy::BlockWithTimeout:
+      if (!wait_for_space()) {
+        ++timed_out_;
+        return reject(frame);
+      }
+      queue_.enqueue(std::move(frame));
+      ++admitted_;
+      return Admission::Admitted;
+
+    case BackpressurePolicy::KeepEveryNth:
+      // 第一帧积压的帧就保留，之后每 N 帧保留一帧
+      if (pressure_arrivals_++ % keep_every_n_.load() == 0) {
+        return replace_oldest(std::move(frame));
+      }
+      ++decimated_;
+      return reject(frame);
+  }
+  return reject(frame);
+}
+
+BoundedFrameQueue::Admission BoundedFrameQueue::replace_oldest(
+    CapturedFramePtr frame) {
+  CapturedFramePtr oldest;
+  const bool evicted = queue_.try_dequeue(oldest);
+  queue_.enqueue(std::move(frame));
+  ++admitted_;
+  if (!evicted) {
+    // 消费者刚好取走了最后一帧，相当于正常入队
+    return Admission::Admitted;
+  }
+  ++dropped_oldest_;
+  if (on_drop_) {
+    on_drop_(oldest);
+  }
+  return Admission::Replaced;
+}
+
+BoundedFrameQueue::Admission BoundedFrameQueue::reject(
+    const CapturedFramePtr& frame) {
+  if (on_drop_) {
+    on_drop_(frame);
+  }
+  return Admission::Rejected;
+}
+
+bool BoundedFrameQueue::wait_for_space() const {
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(block_timeout_us_.load());
+  while (full()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    // 消费者可能在外部直接出队，没有可等待的通知，只能短暂让出
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}
+
+protocol::QueueStats BoundedFrameQueue::stats() const {
+  protocol::QueueStats s;
+  s.admitted = admitted_.load();
+  s.dropped_oldest = dropped_oldest_.load();
+  s.dropped_newest = dropped_newest_.load();
+  s.timed_out = timed_out_.load();
+  s.decimated = decimated_.load();
+  s.depth = queue_.size_approx();
+  return s;
+}
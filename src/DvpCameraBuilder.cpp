@@ -31,6 +31,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "DvpConfig.hpp"
 #include "dvpParam.h"
@@ -466,8 +467,21 @@ DvpCameraBuilder& DvpCameraBuilder::triggerDelay(double us) {
   return *this;
 }
 
-DvpCameraBuilder& DvpCameraBuilder::onFrame(const FrameProcessor& proc) {
-  config_.frame_processors.push_back(proc);
+DvpCameraBuilder& DvpCameraBuilder::backpressure(
+    const FrameAdmissionConfig& admission) {
+  config_.admission = admission;
+  return *this;
+}
+
+DvpCameraBuilder& DvpCameraBuilder::workerBudget(size_t workers,
+                                                const std::vector<int>& cpus) {
+  config_.worker_budget = WorkerBudget{workers, cpus};
+  return *this;
+}
+
+DvpCameraBuilder& DvpCameraBuilder::onFrame(
+    std::shared_ptr<FrameProcessor> proc, std::string name) {
+  config_.frame_processors.emplace_back(std::move(name), std::move(proc));
   return *this;
 }
 
@@ -795,9 +809,17 @@ std::unique_ptr<DvpCameraCapture> DvpCameraBuilder::build() {
   // 将builder的内部配置文件转换成外部可读，并且传递给捕获对象
   capture->set_config(toDvpConfig());
 
-  // 注册帧处理器（我们只使用最后一个）
-  if (!config_.frame_processors.empty()) {
-    capture->add_frame_processor(config_.frame_processors.back());
+  if (config_.admission.has_value()) {
+    capture->set_admission_config(config_.admission.value());
+  }
+
+  if (config_.worker_budget.has_value()) {
+    capture->set_worker_budget(config_.worker_budget.value());
+  }
+
+  // 注册帧处理阶段
+  for (auto& [name, processor] : config_.frame_processors) {
+    capture->add_frame_processor(processor, name);
   }
 
   // 注册事件处理器
@@ -29,13 +29,24 @@
 #include <DVPCamera.h>
 
 #include <cstring>
+#include <functional>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "FrameProcessor.hpp"
+#include "PixelFormat.hpp"
 #include "config/CameraConfig.hpp"
 #include "dvpParam.h"
 
 DvpCameraCapture::DvpCameraCapture(dvpHandle handle) : handle_(handle) {
+  // 原始队列积压说明外部消费者（存图/显示）跟不上，标记 file_io 异常
+  pipeline_.set_raw_saturation_handler([this](bool saturated) {
+    protocol::FrontendStatus status = get_status();
+    status.file_io = !saturated;
+    update_status(status);
+  });
+
   if (handle_) {
     // 初始化配置
     config_ = std::make_shared<DvpConfig>();
@@ -54,29 +65,20 @@ DvpCameraCapture::~DvpCameraCapture() {
     stop();
     dvpClose(handle_);
   }
+  // 先等 lane 中的任务结束，再析构任务里用到的成员
+  pipeline_.shutdown();
 }
 
-bool DvpCameraCapture::start(const FrameProcessor& processor) {
+bool DvpCameraCapture::start(std::shared_ptr<FrameProcessor> processor) {
   if (!handle_) {
     return false;
   }
 
-  user_processor_ = processor;
-  running_ = true;
-
-  dvpStatus status = dvpStart(handle_);
-  if (status != DVP_STATUS_OK) {
-    running_ = false;
-    return false;
+  // 重复 start 同一个处理器时不重复添加
+  if (processor && !pipeline_.processors().contains(processor)) {
+    pipeline_.add_frame_processor(std::move(processor));
   }
-
-  protocol::FrontendStatus initial_status;
-  initial_status.self_check = true;  // TODO 暂时假设启动成功即自检通过
-  initial_status.capture = true;
-  initial_status.file_io = true;
-  update_status(initial_status);
-
-  return true;
+  return start();
 }
 
 bool DvpCameraCapture::start() {
@@ -84,6 +86,7 @@ bool DvpCameraCapture::start() {
     return false;
   }
 
+  pipeline_.prepare(expected_frame_bytes());
   running_ = true;
 
   dvpStatus status = dvpStart(handle_);
@@ -92,6 +95,12 @@ bool DvpCameraCapture::start() {
     return false;
   }
 
+  protocol::FrontendStatus initial_status;
+  initial_status.self_check = true;  // TODO 暂时假设启动成功即自检通过
+  initial_status.capture = true;
+  initial_status.file_io = true;
+  update_status(initial_status);
+
   return true;
 }
 
@@ -122,8 +131,19 @@ void DvpCameraCapture::register_event_handler(DvpEventType event,
                                               DvpEventHandler handler) {
   event_manager_->register_handler(event, handler);
 }
-void DvpCameraCapture::add_frame_processor(const FrameProcessor& processor) {
-  user_processor_ = processor;
+size_t DvpCameraCapture::add_frame_processor(
+    std::shared_ptr<FrameProcessor> processor, std::string name) {
+  return pipeline_.add_frame_processor(std::move(processor), std::move(name));
+}
+
+bool DvpCameraCapture::set_frame_processor_enabled(size_t index,
+                                                   bool enabled) {
+  return pipeline_.processors().set_enabled(index, enabled);
+}
+
+bool DvpCameraCapture::set_frame_processor_enabled(const std::string& name,
+                                                   bool enabled) {
+  return pipeline_.processors().set_enabled(name, enabled);
 }
 DvpEventManager* DvpCameraCapture::get_event_manager() const {
   return event_manager_.get();
@@ -133,35 +153,32 @@ int DvpCameraCapture::OnFrameCallback([[maybe_unused]] dvpHandle handle,
                                       dvpStreamEvent event, void* context,
                                       dvpFrame* frame, void* buffer) {
   auto* capture = static_cast<DvpCameraCapture*>(context);
-  // TODO 检查文件读写状态(示例：如果队列超过200帧了，则标记 file_io 错误)
-  [[unlikely]] if (capture->frame_queue_.size_approx() > 200) {
-    protocol::FrontendStatus status = capture->get_status();
-    status.file_io = false;
-    capture->update_status(status);
-  } else if (capture && capture->running_) {
-    capture->process_frame(*frame, buffer);
+  if (capture && capture->running_) {
+    capture->pipeline_.submit(*frame, buffer);
   }
   return 0;
 }
 
-void DvpCameraCapture::process_frame(const dvpFrame& frame,
-                                     const void* buffer) {
-  CapturedFrame captured_frame;
-  captured_frame.meta = frame;
-  captured_frame.data.assign(
-      static_cast<const uint8_t*>(buffer),
-      static_cast<const uint8_t*>(buffer) + frame.uBytes);
-
-  // 在线程池中处理帧
-  thread_pool_.detach_task([this, captured_frame]() {
-    user_processor_.process(captured_frame);
-#ifdef SAVE_RESULT_IMAGE_QUEUE
-    result_queue_.enqueue(captured);
-#endif
-  });
-  // 提交算法处理之后把原始图像放到队列里面
-  auto captured = std::make_shared<CapturedFrame>(captured_frame);
-  frame_queue_.enqueue(captured);
+void DvpCameraCapture::set_worker_budget(const WorkerBudget& budget) {
+  // 采集中不替换 lane，下次 start() 时按新预算重新申请
+  if (!running_) {
+    pipeline_.set_worker_budget(budget);
+  }
+}
+
+void DvpCameraCapture::set_admission_config(const FrameAdmissionConfig& cfg) {
+  pipeline_.set_admission_config(cfg);
+}
+
+size_t DvpCameraCapture::expected_frame_bytes() const {
+  dvpRegion roi{};
+  dvpStreamFormat format = S_RAW8;
+  if (dvpGetRoi(handle_, &roi) != DVP_STATUS_OK ||
+      dvpGetTargetFormat(handle_, &format) != DVP_STATUS_OK) {
+    return 0;
+  }
+  return static_cast<size_t>(roi.W) * static_cast<size_t>(roi.H) *
+         bytes_per_pixel(format);
 }
 
 void DvpCameraCapture::update_camera_params() {
@@ -412,8 +429,14 @@ void DvpCameraCapture::set_roi(int x, int y, int width, int height) {
 }
 
 protocol::FrontendStatus DvpCameraCapture::get_status() const {
-  std::shared_lock lock(status_mutex_);
-  return current_status_;
+  protocol::FrontendStatus status;
+  {
+    std::shared_lock lock(status_mutex_);
+    status = current_status_;
+  }
+  status.processing_queue = pipeline_.processing_queue_stats();
+  status.raw_queue = pipeline_.raw_queue_stats();
+  return status;
 }
 
 void DvpCameraCapture::update_status(
@@ -0,0 +1,101 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameBuffer.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameBuffer.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+
+size_t round_up(size_t bytes) {
+  return (bytes + FrameBuffer::kAlignment - 1) / FrameBuffer::kAlignment *
+         FrameBuffer::kAlignment;
+}
+
+}  // namespace
+
+FrameBuffer::FrameBuffer(const FrameBuffer& other) {
+  assign(other.begin(), other.end());
+}
+
+FrameBuffer& FrameBuffer::operator=(const FrameBuffer& other) {
+  if (this != &other) {
+    assign(other.begin(), other.end());
+  }
+  return *this;
+}
+
+FrameBuffer::FrameBuffer(FrameBuffer&& other) noexcept
+    : storage_(std::move(other.storage_)),
+      size_(std::exchange(other.size_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)) {}
+
+FrameBuffer& FrameBuffer::operator=(FrameBuffer&& other) noexcept {
+  storage_ = std::move(other.storage_);
+  size_ = std::exchange(other.size_, 0);
+  capacity_ = std::exchange(other.capacity_, 0);
+  return *this;
+}
+
+void FrameBuffer::reserve(size_t bytes) {
+  if (bytes <= capacity_) {
+    return;
+  }
+  const size_t capacity = round_up(bytes);
+  std::unique_ptr<uint8_t, AlignedDelete> storage(static_cast<uint8_t*>(
+      ::operator new(capacity, std::align_val_t{kAlignment})));
+  if (size_ > 0) {
+    std::memcpy(storage.get(), storage_.get(), size_);
+  }
+  storage_ = std::move(storage);
+  capacity_ = capacity;
+}
+
+void FrameBuffer::resize_uninitialized(size_t bytes) {
+  reserve(bytes);
+  size_ = bytes;
+}
+
+void FrameBuffer::assign(const uint8_t* first, const uint8_t* last) {
+  const size_t bytes = static_cast<size_t>(last - first);
+  // 先清空再扩容，扩容时不必拷贝旧内容
+  size_ = 0;
+  reserve(bytes);
+  if (bytes > 0) {
+    std::memcpy(storage_.get(), first, bytes);
+  }
+  size_ = bytes;
+}
+
+void FrameBuffer::assign(size_t count, uint8_t value) {
+  size_ = 0;
+  reserve(count);
+  if (count > 0) {
+    std::memset(storage_.get(), value, count);
+  }
+  size_ = count;
+}
@@ -0,0 +1,107 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameBufferPool.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameBufferPool.hpp"
+
+#include <algorithm>
+#include <memory>
+
+std::shared_ptr<FrameBufferPool> FrameBufferPool::create(size_t slab_bytes,
+                                                         size_t max_slabs) {
+  // 构造函数私有，不能用 make_shared
+  return std::shared_ptr<FrameBufferPool>(
+      new FrameBufferPool(slab_bytes, max_slabs));
+}
+
+FrameBufferPool::FrameBufferPool(size_t slab_bytes, size_t max_slabs)
+    : free_list_(max_slabs), slab_bytes_(slab_bytes), max_slabs_(max_slabs) {}
+
+FrameBufferPool::~FrameBufferPool() {
+  CapturedFrame* frame = nullptr;
+  while (free_list_.try_dequeue(frame)) {
+    delete frame;
+  }
+}
+
+void FrameBufferPool::reserve(size_t slab_bytes, size_t prealloc) {
+  slab_bytes_ = slab_bytes;
+  prealloc = std::min(prealloc, max_slabs_);
+  while (total_slabs_.load() < prealloc) {
+    ++total_slabs_;
+    free_list_.enqueue(make_slab(slab_bytes));
+  }
+}
+
+std::shared_ptr<CapturedFrame> FrameBufferPool::acquire(size_t bytes) {
+  const size_t slab_bytes = std::max(bytes, slab_bytes_.load());
+
+  CapturedFrame* frame = nullptr;
+  if (!free_list_.try_dequeue(frame)) {
+    if (total_slabs_.fetch_add(1) >= max_slabs_) {
+      // 池已满：临时分配一帧，释放时直接删除，不扩大池
+      --total_slabs_;
+      ++overflow_;
+      return std::make_shared<CapturedFrame>();
+    }
+    frame = make_slab(slab_bytes);
+  }
+
+  // ROI 变大之后旧 slab 只扩容一次，之后就稳定了
+  frame->data.reserve(slab_bytes);
+  frame->data.clear();
+
+  std::weak_ptr<FrameBufferPool> weak_pool = weak_from_this();
+  return std::shared_ptr<CapturedFrame>(
+      frame, [weak_pool](CapturedFrame* released) {
+        if (auto pool = weak_pool.lock()) {
+          pool->recycle(released);
+        } else {
+          delete released;
+        }
+      });
+}
+
+FrameBufferPool::Stats FrameBufferPool::stats() const {
+  Stats s;
+  s.slab_bytes = slab_bytes_.load();
+  s.total_slabs = total_slabs_.load();
+  s.free_slabs = free_list_.size_approx();
+  s.overflow = overflow_.load();
+  return s;
+}
+
+CapturedFrame* FrameBufferPool::make_slab(size_t bytes) const {
+  auto* frame = new CapturedFrame();
+  frame->data.reserve(bytes);
+  return frame;
+}
+
+void FrameBufferPool::recycle(CapturedFrame* frame) noexcept {
+  if (!free_list_.enqueue(frame)) {
+    --total_slabs_;
+    delete frame;
+  }
+}
@@ -0,0 +1,210 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameFile.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameFile.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace frame_file {
+
+FrameFileHeader make_file_header(uint32_t segment) {
+  FrameFileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.meta_bytes = sizeof(dvpFrame);
+  header.segment = segment;
+  return header;
+}
+
+FrameIndexHeader make_index_header(uint32_t segment) {
+  FrameIndexHeader header{};
+  std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+  header.version = kVersion;
+  header.segment = segment;
+  return header;
+}
+
+bool is_valid(const FrameFileHeader& header) {
+  return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+         header.version == kVersion && header.meta_bytes == sizeof(dvpFrame);
+}
+
+bool is_valid(const FrameRecordHeader& record, uint64_t remaining_bytes) {
+  if (record.magic != kRecordMagic || record.payload_bytes > remaining_bytes) {
+    return false;
+  }
+  const dvpFrame& meta = record.meta;
+  const size_t bpp = bytes_per_pixel(pixel_format_from_frame(meta.format,
+                                                             meta.bits));
+  if (bpp == 0 || meta.iWidth <= 0 || meta.iHeight <= 0) {
+    // 无法由尺寸推出大小的格式，只能和 SDK 报告的字节数比较
+    return record.payload_bytes == meta.uBytes;
+  }
+  return record.payload_bytes == static_cast<uint64_t>(meta.iWidth) *
+                                     static_cast<uint64_t>(meta.iHeight) * bpp;
+}
+
+std::string segment_path(const std::string& directory,
+                         const std::string& prefix, uint32_t segment) {
+  char name[16];
+  std::snprintf(name, sizeof(name), "_%06u", segment);
+  return (std::filesystem::path(directory) / (prefix + name + kExtension))
+      .string();
+}
+
+std::string index_path(const std::string& segment_path) {
+  return std::filesystem::path(segment_path)
+      .replace_extension(kIndexExtension)
+      .string();
+}
+
+std::vector<FrameIndexEntry> load_index(const std::string& segment_path) {
+  std::vector<FrameIndexEntry> entries;
+  std::ifstream file(index_path(segment_path), std::ios::binary);
+  FrameIndexHeader header{};
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+      header.version != kVersion) {
+    return entries;
+  }
+  entries.resize(header.count);
+  file.read(reinterpret_cast<char*>(entries.data()),
+            static_cast<std::streamsize>(entries.size() * sizeof(entries[0])));
+  // 索引被截断时只保留完整读出的部分
+  entries.resize(static_cast<size_t>(file.gcount()) / sizeof(entries[0]));
+  return entries;
+}
+
+std::vector<std::string> list_segments(const std::string& path) {
+  namespace fs = std::filesystem;
+  std::vector<std::string> segments;
+  std::error_code ec;
+  if (fs::is_regular_file(path, ec)) {
+    segments.push_back(path);
+    return segments;
+  }
+  for (const auto& entry : fs::directory_iterator(path, ec)) {
+    if (entry.is_regular_file() && entry.path().extension() == kExtension) {
+      segments.push_back(entry.path().string());
+    }
+  }
+  // 录像器按零填充的序号命名分段，字典序即时间顺序
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+
+}  // namespace frame_file
+
+FrameFileReader::FrameFileReader(std::vector<std::string> segments) {
+  open(std::move(segments));
+}
+
+bool FrameFileReader::open(std::vector<std::string> segments) {
+  close();
+  segments_ = std::move(segments);
+  return open_segment(0);
+}
+
+void FrameFileReader::close() {
+  if (file_.is_open()) {
+    file_.close();
+  }
+  file_.clear();
+  current_ = 0;
+}
+
+bool FrameFileReader::rewind() {
+  close();
+  return open_segment(0);
+}
+
+bool FrameFileReader::open_segment(size_t index) {
+  if (file_.is_open()) {
+    file_.close();
+  }
+  file_.clear();
+  current_ = index;
+  if (index >= segments_.size()) {
+    return false;
+  }
+
+  std::error_code ec;
+  segment_bytes_ = std::filesystem::file_size(segments_[index], ec);
+  if (ec) {
+    segment_bytes_ = 0;
+  }
+  file_.open(segments_[index], std::ios::binary);
+  frame_file::FrameFileHeader header{};
+  if (!file_.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      !frame_file::is_valid(header)) {
+    file_.close();
+    return false;
+  }
+  return true;
+}
+
+bool FrameFileReader::next(CapturedFrame& frame) {
+  while (file_.is_open()) {
+    frame_file::FrameRecordHeader record{};
+    if (file_.read(reinterpret_cast<char*>(&record), sizeof(record)) &&
+        file_.seekg(frame_file::record_header_bytes() - sizeof(record),
+                    std::ios::cur) &&
+        frame_file::is_valid(record, remaining_bytes())) {
+      frame.data.resize_uninitialized(record.payload_bytes);
+      if (file_.read(reinterpret_cast<char*>(frame.data.data()),
+                     static_cast<std::streamsize>(record.payload_bytes))) {
+        file_.seekg(frame_file::align_up(record.payload_bytes) -
+                        record.payload_bytes,
+                    std::ios::cur);
+        frame.meta = record.meta;
+        frame.sequence = record.sequence;
+        frame.update_layout();
+        return true;
+      }
+    }
+    // 本分段读完，或者记录不完整、大小与 meta 不符（之后的记录位置也不可信），
+    // 继续下一个分段
+    if (!open_segment(current_ + 1)) {
+      return false;
+    }
+  }
+  return false;
+}
+
+uint64_t FrameFileReader::remaining_bytes() {
+  const auto position = file_.tellg();
+  if (position < 0 || static_cast<uint64_t>(position) > segment_bytes_) {
+    return 0;
+  }
+  return segment_bytes_ - static_cast<uint64_t>(position);
+}
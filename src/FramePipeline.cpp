@@ -0,0 +1,173 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePipeline.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FramePipeline.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace {
+
+// 池里预留的 slab 数：算法线程数 + 原始队列中常驻的几帧
+constexpr size_t kPreallocatedFrames = 8;
+
+}  // namespace
+
+FramePipeline::FramePipeline() {
+  // 处理队列丢帧会在序号里留下缺口，通知处理阶段不必再等待
+  processing_queue_.set_drop_handler([this](const CapturedFramePtr& frame) {
+    processors_.notify_dropped(frame->sequence);
+  });
+}
+
+FramePipeline::~FramePipeline() { shutdown(); }
+
+void FramePipeline::prepare(size_t frame_bytes) {
+  if (frame_bytes > 0) {
+    frame_pool_->reserve(frame_bytes, kPreallocatedFrames);
+  }
+  std::lock_guard lock(lane_mutex_);
+  if (!lane_) {
+    lane_ = ProcessingExecutor::instance().acquire_lane(worker_budget_);
+  }
+}
+
+void FramePipeline::wait_idle() {
+  std::shared_ptr<ProcessingExecutor::Lane> lane;
+  {
+    std::lock_guard lock(lane_mutex_);
+    lane = lane_;
+  }
+  if (lane) {
+    lane->wait();
+  }
+}
+
+void FramePipeline::release_lane() {
+  std::shared_ptr<ProcessingExecutor::Lane> lane;
+  {
+    std::lock_guard lock(lane_mutex_);
+    lane = std::move(lane_);
+  }
+  if (lane) {
+    // 任务派生的子任务在父任务结束前已经计入 lane，wait() 返回时
+    // 不会再有任务使用这条 lane
+    lane->wait();
+  }
+}
+
+void FramePipeline::shutdown() {
+  {
+    std::lock_guard lock(lane_mutex_);
+    if (!lane_) {
+      return;
+    }
+  }
+  release_lane();
+  processors_.flush();
+}
+
+void FramePipeline::publish(std::shared_ptr<CapturedFrame> frame) {
+  frame->update_layout();
+  // 在任何丢帧之前编号，下游可以据此发现缺口并恢复顺序
+  frame->sequence = next_sequence_++;
+
+  // 之后算法路径和原始队列共享同一帧，只增加引用计数
+  CapturedFramePtr shared_frame = std::move(frame);
+
+  // 每个入队的帧对应一个 lane 任务；挤掉旧帧时任务数不变，
+  // 所以 lane 里积压的任务数不会超过处理队列的容量
+  if (processing_queue_.push(shared_frame) ==
+      BoundedFrameQueue::Admission::Admitted) {
+    std::shared_ptr<ProcessingExecutor::Lane> lane;
+    {
+      std::lock_guard lock(lane_mutex_);
+      lane = lane_;
+    }
+    // 任务只记住提交时的 lane：释放 lane 的一方会先等它结束。
+    // 这里的引用可能比 lane_ 活得久，析构时同样会先等待
+    if (lane) {
+      lane->detach([this, target = lane.get()]() {
+        process_pending_frame(*target);
+      });
+    }
+  }
+
+  // 原始队列积压说明外部消费者（存图/显示）跟不上
+  raw_queue_.push(std::move(shared_frame));
+  const bool saturated = raw_queue_.full();
+  [[unlikely]] if (saturated != raw_queue_saturated_.exchange(saturated)) {
+    if (on_raw_saturation_) {
+      on_raw_saturation_(saturated);
+    }
+  }
+}
+
+void FramePipeline::submit(const dvpFrame& meta, const void* buffer) {
+  // 唯一的一次拷贝：SDK 缓冲区 -> 池中的 slab
+  auto frame = acquire(meta.uBytes);
+  frame->meta = meta;
+  frame->data.assign(static_cast<const uint8_t*>(buffer),
+                     static_cast<const uint8_t*>(buffer) + meta.uBytes);
+  publish(std::move(frame));
+}
+
+void FramePipeline::process_pending_frame(ProcessingExecutor::Lane& lane) {
+  CapturedFramePtr frame;
+  if (!processing_queue_.try_pop(frame)) {
+    return;
+  }
+  // 多个阶段时，其余阶段提交到同一个 lane 并行执行，共享同一帧
+  processors_.fan_out(
+      frame,
+      [&lane](std::function<void()> task) { lane.detach(std::move(task)); },
+#ifdef SAVE_RESULT_IMAGE_QUEUE
+      [this](const CapturedFramePtr& done) { result_queue_.enqueue(done); }
+#else
+      {}
+#endif
+  );
+}
+
+void FramePipeline::set_admission_config(const FrameAdmissionConfig& cfg) {
+  processing_queue_.configure(cfg.processing_capacity, cfg);
+  raw_queue_.configure(cfg.raw_capacity, cfg);
+}
+
+void FramePipeline::set_worker_budget(const WorkerBudget& budget) {
+  {
+    std::lock_guard lock(lane_mutex_);
+    worker_budget_ = budget;
+  }
+  release_lane();
+}
+
+size_t FramePipeline::add_frame_processor(
+    std::shared_ptr<FrameProcessor> processor, std::string name) {
+  return processors_.add(std::move(processor), std::move(name));
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameProcessorChain.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameProcessorChain.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+size_t FrameProcessorChain::add(std::shared_ptr<FrameProcessor> processor,
+                                std::string name) {
+  std::unique_lock lock(mutex_);
+  auto stages = std::make_shared<StageList>(*stages_);
+  stages->push_back(Stage{std::move(name), std::move(processor), true});
+  const size_t index = stages->size() - 1;
+  stages_ = std::move(stages);
+  return index;
+}
+
+void FrameProcessorChain::clear() {
+  std::unique_lock lock(mutex_);
+  stages_ = std::make_shared<StageList>();
+}
+
+bool FrameProcessorChain::set_enabled(size_t index, bool enabled) {
+  std::unique_lock lock(mutex_);
+  if (index >= stages_->size()) {
+    return false;
+  }
+  auto stages = std::make_shared<StageList>(*stages_);
+  (*stages)[index].enabled = enabled;
+  stages_ = std::move(stages);
+  return true;
+}
+
+bool FrameProcessorChain::set_enabled(const std::string& name, bool enabled) {
+  std::unique_lock lock(mutex_);
+  auto stages = std::make_shared<StageList>(*stages_);
+  bool found = false;
+  for (auto& stage : *stages) {
+    if (stage.name == name) {
+      stage.enabled = enabled;
+      found = true;
+    }
+  }
+  if (found) {
+    stages_ = std::move(stages);
+  }
+  return found;
+}
+
+std::shared_ptr<const FrameProcessorChain::StageList>
+FrameProcessorChain::snapshot() const {
+  std::shared_lock lock(mutex_);
+  return stages_;
+}
+
+size_t FrameProcessorChain::size() const {
+  std::shared_lock lock(mutex_);
+  return stages_->size();
+}
+
+bool FrameProcessorChain::contains(
+    const std::shared_ptr<FrameProcessor>& processor) const {
+  auto stages = snapshot();
+  for (const auto& stage : *stages) {
+    if (stage.processor == processor) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FrameProcessorChain::process(const CapturedFrame& frame) const {
+  auto stages = snapshot();
+  for (const auto& stage : *stages) {
+    if (stage.enabled && stage.processor) {
+      stage.processor->process(frame);
+    }
+  }
+}
+
+void FrameProcessorChain::notify_dropped(uint64_t sequence) const {
+  auto stages = snapshot();
+  for (const auto& stage : *stages) {
+    if (stage.enabled && stage.processor) {
+      stage.processor->on_dropped(sequence);
+    }
+  }
+}
+
+void FrameProcessorChain::flush() const {
+  // 禁用的阶段也可能还有等待中的结果
+  auto stages = snapshot();
+  for (const auto& stage : *stages) {
+    if (stage.processor) {
+      stage.processor->flush();
+    }
+  }
+}
+
+void FrameProcessorChain::fan_out(const CapturedFramePtr& frame,
+                                  const Spawn& spawn, Done done) const {
+  auto stages = snapshot();
+  std::vector<std::shared_ptr<FrameProcessor>> active;
+  active.reserve(stages->size());
+  for (const auto& stage : *stages) {
+    if (stage.enabled && stage.processor) {
+      active.push_back(stage.processor);
+    }
+  }
+
+  if (active.size() <= 1) {
+    // 常见情况：只有一个阶段，不需要额外的计数和任务
+    if (!active.empty()) {
+      active.front()->process(*frame);
+    }
+    if (done) {
+      done(frame);
+    }
+    return;
+  }
+
+  // 每个阶段持有一份帧引用，最后结束的阶段负责调用 done
+  auto remaining = std::make_shared<std::atomic<size_t>>(active.size());
+  auto shared_done = std::make_shared<Done>(std::move(done));
+  auto finish = [remaining, shared_done, frame]() {
+    if (remaining->fetch_sub(1) == 1 && *shared_done) {
+      (*shared_done)(frame);
+    }
+  };
+
+  for (size_t i = 1; i < active.size(); ++i) {
+    spawn([processor = active[i], frame, finish]() {
+      processor->process(*frame);
+      finish();
+    });
+  }
+  active.front()->process(*frame);
+  finish();
+}
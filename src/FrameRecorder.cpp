@@ -0,0 +1,191 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameRecorder.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+FrameRecorder::FrameRecorder(RecorderConfig config)
+    : config_(std::move(config)),
+      queue_(std::max<size_t>(1, config_.queue_capacity)) {
+  config_.queue_capacity = std::max<size_t>(1, config_.queue_capacity);
+  config_.index_capacity = std::max<size_t>(1, config_.index_capacity);
+}
+
+FrameRecorder::~FrameRecorder() { stop(); }
+
+bool FrameRecorder::start() {
+  if (recording_) {
+    return true;
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(config_.directory, ec);
+  if (!std::filesystem::is_directory(config_.directory, ec)) {
+    return false;
+  }
+  failed_ = false;
+  recording_ = true;
+  io_thread_ = std::thread([this]() { io_loop(); });
+  return true;
+}
+
+void FrameRecorder::stop() {
+  recording_ = false;
+  ++signal_;
+  signal_.notify_one();
+  if (io_thread_.joinable()) {
+    io_thread_.join();
+  }
+}
+
+void FrameRecorder::process(const CapturedFrame& frame) {
+  if (!recording_) {
+    return;
+  }
+  // 不拷贝图像：共享池中的帧，写盘完成后才归还
+  if (queued_.fetch_add(1) >= config_.queue_capacity ||
+      !queue_.try_enqueue(retain_frame(frame))) {
+    --queued_;
+    ++dropped_;
+    return;
+  }
+  ++signal_;
+  signal_.notify_one();
+}
+
+void FrameRecorder::io_loop() {
+  CapturedFramePtr frame;
+  while (true) {
+    // 先读事件计数再尝试出队，避免漏掉两者之间到达的帧
+    const uint32_t seen = signal_.load();
+    if (queue_.try_dequeue(frame)) {
+      --queued_;
+      write_record(*frame);
+      frame.reset();
+      continue;
+    }
+    if (!recording_) {
+      break;
+    }
+    signal_.wait(seen);
+  }
+  close_segment();
+}
+
+void FrameRecorder::write_record(const CapturedFrame& frame) {
+  const size_t payload = frame.data.size();
+  const size_t bytes = frame_file::record_bytes(payload);
+  if (failed_ ||
+      bytes + sizeof(frame_file::FrameFileHeader) > config_.segment_bytes) {
+    ++dropped_;
+    return;
+  }
+  if (!segment_.isOpen() || offset_ + bytes > segment_.size() ||
+      index_count_ >= config_.index_capacity) {
+    close_segment();
+    if (!open_segment()) {
+      failed_ = true;
+      ++dropped_;
+      return;
+    }
+  }
+
+  uint8_t* record = segment_.data() + offset_;
+  std::memcpy(record + frame_file::record_header_bytes(), frame.data.data(),
+              payload);
+
+  // 记录头最后写：进程中途退出时，读取端在没有魔数的记录处停下
+  frame_file::FrameRecordHeader header{};
+  header.magic = frame_file::kRecordMagic;
+  header.sequence = frame.sequence;
+  header.payload_bytes = payload;
+  header.meta = frame.meta;
+  std::memcpy(record, &header, sizeof(header));
+
+  frame_file::FrameIndexEntry entry{};
+  entry.offset = offset_;
+  entry.sequence = frame.sequence;
+  entry.frame_id = frame.meta.uFrameID;
+  entry.timestamp_us = frame.meta.uTimestamp;
+  std::memcpy(index_.data() + sizeof(frame_file::FrameIndexHeader) +
+                  index_count_ * sizeof(entry),
+              &entry, sizeof(entry));
+  ++index_count_;
+  auto* index_header =
+      reinterpret_cast<frame_file::FrameIndexHeader*>(index_.data());
+  index_header->count = index_count_;
+
+  offset_ += bytes;
+  ++frames_;
+  bytes_ += payload;
+}
+
+bool FrameRecorder::open_segment() {
+  const uint32_t segment = next_segment_++;
+  const std::string path =
+      frame_file::segment_path(config_.directory, config_.prefix, segment);
+  const size_t index_bytes =
+      sizeof(frame_file::FrameIndexHeader) +
+      config_.index_capacity * sizeof(frame_file::FrameIndexEntry);
+  if (!segment_.create(path, config_.segment_bytes) ||
+      !index_.create(frame_file::index_path(path), index_bytes)) {
+    segment_.close(0);
+    return false;
+  }
+
+  const auto header = frame_file::make_file_header(segment);
+  std::memcpy(segment_.data(), &header, sizeof(header));
+  offset_ = sizeof(header);
+
+  const auto index_header = frame_file::make_index_header(segment);
+  std::memcpy(index_.data(), &index_header, sizeof(index_header));
+  index_count_ = 0;
+
+  ++segments_;
+  return true;
+}
+
+void FrameRecorder::close_segment() {
+  // 分段按上限预先扩展，关闭时截掉没用到的部分
+  segment_.close(offset_);
+  index_.close(sizeof(frame_file::FrameIndexHeader) +
+               index_count_ * sizeof(frame_file::FrameIndexEntry));
+  offset_ = 0;
+  index_count_ = 0;
+}
+
+FrameRecorder::Stats FrameRecorder::stats() const {
+  Stats s;
+  s.frames = frames_.load();
+  s.bytes = bytes_.load();
+  s.dropped = dropped_.load();
+  s.segments = segments_.load();
+  s.failed = failed_.load();
+  return s;
+}
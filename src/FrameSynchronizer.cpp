@@ -0,0 +1,190 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameSynchronizer.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameSynchronizer.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+// timeout 为 0 时检查超时的最短间隔，避免空转
+constexpr std::chrono::milliseconds kMinPoll{1};
+
+}  // namespace
+
+FrameSynchronizer::FrameSynchronizer(size_t num_cams, SyncOptions options,
+                                     SetHandler handler)
+    : options_(options),
+      handler_(std::move(handler)),
+      rings_(num_cams) {
+  worker_ = std::thread([this]() { run(); });
+}
+
+FrameSynchronizer::~FrameSynchronizer() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  worker_.join();
+}
+
+uint64_t FrameSynchronizer::key_of(const CapturedFrame& frame) const {
+  return options_.key == SyncKey::FrameId ? frame.meta.uFrameID
+                                          : frame.meta.uTimestamp;
+}
+
+void FrameSynchronizer::push(size_t cam_index, CapturedFramePtr frame) {
+  if (!frame || cam_index >= rings_.size()) {
+    return;
+  }
+  const auto now = Clock::now();
+  {
+    std::lock_guard lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    auto& ring = rings_[cam_index];
+    if (ring.size() >= std::max<size_t>(1, options_.ring_capacity)) {
+      ring.pop_front();
+      ++stats_.ring_overflow;
+    }
+    const uint64_t key = key_of(*frame);
+    ring.push_back({std::move(frame), key, now});
+    match_locked(now);
+  }
+  wake_.notify_one();
+}
+
+void FrameSynchronizer::match_locked(Clock::time_point now) {
+  while (std::all_of(rings_.begin(), rings_.end(),
+                     [](const auto& ring) { return !ring.empty(); })) {
+    auto [lo, hi] = std::minmax_element(
+        rings_.begin(), rings_.end(), [](const auto& a, const auto& b) {
+          return a.front().key < b.front().key;
+        });
+    if (hi->front().key - lo->front().key <= options_.tolerance) {
+      FrameSet set;
+      set.reserve(rings_.size());
+      for (auto& ring : rings_) {
+        set.push_back(std::move(ring.front().frame));
+        ring.pop_front();
+      }
+      ++stats_.matched;
+      enqueue_set_locked(std::move(set));
+      continue;
+    }
+    // 其他相机的帧只会越来越晚，最早的这一帧不可能再配上
+    lo->pop_front();
+    ++stats_.unmatched;
+  }
+  expire_locked(now);
+}
+
+void FrameSynchronizer::expire_locked(Clock::time_point now) {
+  for (;;) {
+    // 找出等待最久的队首，它所在的组就是最早的一组
+    std::deque<Entry>* oldest = nullptr;
+    for (auto& ring : rings_) {
+      if (!ring.empty() &&
+          (!oldest || ring.front().arrival < oldest->front().arrival)) {
+        oldest = &ring;
+      }
+    }
+    if (!oldest || now - oldest->front().arrival < options_.timeout) {
+      return;
+    }
+    const uint64_t key = oldest->front().key;
+    FrameSet set(rings_.size());
+    for (size_t i = 0; i < rings_.size(); ++i) {
+      auto& ring = rings_[i];
+      if (ring.empty()) {
+        continue;
+      }
+      const uint64_t other = ring.front().key;
+      if ((other > key ? other - key : key - other) <= options_.tolerance) {
+        set[i] = std::move(ring.front().frame);
+        ring.pop_front();
+      }
+    }
+    if (options_.partial_policy == PartialPolicy::Emit) {
+      ++stats_.partial;
+      enqueue_set_locked(std::move(set));
+    } else {
+      stats_.timed_out += static_cast<uint64_t>(
+          std::count_if(set.begin(), set.end(),
+                        [](const auto& frame) { return frame != nullptr; }));
+    }
+  }
+}
+
+void FrameSynchronizer::enqueue_set_locked(FrameSet&& set) {
+  if (ready_.size() >= std::max<size_t>(1, options_.max_pending_sets)) {
+    ready_.pop_front();
+    ++stats_.set_overflow;
+  }
+  ready_.push_back(std::move(set));
+}
+
+void FrameSynchronizer::run() {
+  std::unique_lock lock(mutex_);
+  for (;;) {
+    // 没有新帧时也要定期检查超时，相机掉线不能让其他相机的帧一直挂着
+    wake_.wait_for(lock, std::max(options_.timeout, kMinPoll),
+                   [this]() { return stopping_ || !ready_.empty(); });
+    expire_locked(Clock::now());
+    while (!ready_.empty()) {
+      FrameSet set = std::move(ready_.front());
+      ready_.pop_front();
+      lock.unlock();
+      bool failed = false;
+      try {
+        if (handler_) {
+          handler_(std::move(set));
+        }
+      } catch (const std::exception& e) {
+        // 同步线程上的异常没有调用方可以接住，记录后继续交付下一组
+        std::cerr << "FrameSynchronizer: " << e.what() << std::endl;
+        failed = true;
+      }
+      lock.lock();
+      if (failed) {
+        ++stats_.handler_errors;
+      }
+    }
+    if (stopping_) {
+      return;
+    }
+  }
+}
+
+FrameSynchronizer::Stats FrameSynchronizer::stats() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
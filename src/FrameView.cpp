@@ -0,0 +1,143 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameView.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "FrameView.hpp"
+
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// OpenCV 的 Bayer 命名取自第二行的第二、三个像素，
+// 与相机按左上角 2x2 命名的排列正好对角互换
+int bayer_to_gray_code(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::BayerBG8:
+    case PixelFormat::BayerBG16:
+      return cv::COLOR_BayerRG2GRAY;
+    case PixelFormat::BayerGB8:
+    case PixelFormat::BayerGB16:
+      return cv::COLOR_BayerGR2GRAY;
+    case PixelFormat::BayerGR8:
+    case PixelFormat::BayerGR16:
+      return cv::COLOR_BayerGB2GRAY;
+    case PixelFormat::BayerRG8:
+    case PixelFormat::BayerRG16:
+      return cv::COLOR_BayerBG2GRAY;
+    default:
+      return -1;
+  }
+}
+
+int color_to_gray_code(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::BGR24:
+    case PixelFormat::BGR48:
+      return cv::COLOR_BGR2GRAY;
+    case PixelFormat::BGR32:
+    case PixelFormat::BGR64:
+      return cv::COLOR_BGRA2GRAY;
+    case PixelFormat::RGB24:
+    case PixelFormat::RGB48:
+      return cv::COLOR_RGB2GRAY;
+    case PixelFormat::RGB32:
+    case PixelFormat::RGB64:
+      return cv::COLOR_RGBA2GRAY;
+    default:
+      return -1;
+  }
+}
+
+double significant_scale(dvpBits bits) {
+  switch (bits) {
+    case BITS_10:
+      return 4.0;
+    case BITS_12:
+      return 16.0;
+    case BITS_14:
+      return 64.0;
+    default:
+      return 256.0;
+  }
+}
+
+}  // namespace
+
+int cv_type_of(PixelFormat format) {
+  const int channels = channel_count(format);
+  if (channels == 0) {
+    return -1;
+  }
+  return is_16bit(format) ? CV_16UC(channels) : CV_8UC(channels);
+}
+
+cv::Mat frame_view(const CapturedFrame& frame) {
+  const int type = cv_type_of(frame.pixel_format);
+  if (type < 0 || frame.data.empty() || frame.width() <= 0 ||
+      frame.height() <= 0) {
+    return {};
+  }
+  const size_t stride =
+      frame.stride > 0 ? frame.stride
+                       : static_cast<size_t>(frame.width()) *
+                             bytes_per_pixel(frame.pixel_format);
+  if (stride * static_cast<size_t>(frame.height()) > frame.data.size()) {
+    return {};  // 数据不完整，不能越界访问
+  }
+  return cv::Mat(frame.height(), frame.width(), type,
+                 const_cast<uint8_t*>(frame.data.data()), stride);
+}
+
+cv::Mat frame_to_gray8(const CapturedFrame& frame) {
+  cv::Mat scratch;
+  return frame_to_gray8(frame, scratch);
+}
+
+cv::Mat frame_to_gray8(const CapturedFrame& frame, cv::Mat& scratch) {
+  cv::Mat view = frame_view(frame);
+  if (view.empty() || frame.pixel_format == PixelFormat::Mono8) {
+    return view;
+  }
+
+  // 8 位格式直接转换到 scratch，16 位格式先转成 16 位灰度再缩放到 scratch
+  const bool wide = view.depth() == CV_16U;
+  cv::Mat wide_gray;
+  cv::Mat& gray = wide ? wide_gray : scratch;
+  if (is_bayer(frame.pixel_format)) {
+    cv::cvtColor(view, gray, bayer_to_gray_code(frame.pixel_format));
+  } else if (channel_count(frame.pixel_format) > 1) {
+    cv::cvtColor(view, gray, color_to_gray_code(frame.pixel_format));
+  } else if (wide) {
+    gray = view;
+  } else {
+    return view;
+  }
+
+  if (wide) {
+    // 10/12/14 位数据存放在低位，按实际位宽缩放
+    gray.convertTo(scratch, CV_8U, 1.0 / significant_scale(frame.meta.bits));
+  }
+  return scratch;
+}
@@ -27,78 +27,430 @@
 // ImageSignalBus.cpp
 #include "ImageSignalBus.hpp"  //NOLINT
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 // For mat
 #include <opencv2/core/mat.hpp>
+#include <opencv2/imgproc.hpp>
 
-void ImageSignalBus::declare_signal(const std::string& signal_name) {
+namespace {
+
+// 按宽高比缩小到不超过 bound，bound 为空或已经放得下时原样返回
+cv::Size fit_within(cv::Size size, cv::Size bound) {
+  if (bound.width <= 0 || bound.height <= 0 ||
+      (size.width <= bound.width && size.height <= bound.height)) {
+    return size;
+  }
+  const double scale =
+      std::min(static_cast<double>(bound.width) / size.width,
+               static_cast<double>(bound.height) / size.height);
+  return {std::max(1, static_cast<int>(size.width * scale)),
+          std::max(1, static_cast<int>(size.height * scale))};
+}
+
+}  // namespace
+
+template <typename T>
+ImageSignalBus::Subscription<T> ImageSignalBus::make_subscription(
+    typename SignalMailbox<T>::Callback callback,
+    SubscriptionOptions options) {
+  Subscription<T> subscription;
+  subscription.id = next_id_.fetch_add(1, std::memory_order_relaxed);
+  // 信箱在锁外创建，Queued/LatestOnly 会在这里启动投递线程
+  subscription.mailbox =
+      std::make_shared<SignalMailbox<T>>(std::move(callback), options);
+  return subscription;
+}
+
+template <typename T>
+ImageSignalBus::SubscriberList<T> ImageSignalBus::with_subscription(
+    const SubscriberList<T>& list, Subscription<T> subscription) {
+  auto next = list ? std::make_shared<std::vector<Subscription<T>>>(*list)
+                   : std::make_shared<std::vector<Subscription<T>>>();
+  next->push_back(std::move(subscription));
+  return next;
+}
+
+template <typename T>
+ImageSignalBus::SubscriberList<T> ImageSignalBus::without_subscription(
+    const SubscriberList<T>& list, SubscriptionId id) {
+  if (!list) {
+    return nullptr;
+  }
+  auto it = std::find_if(list->begin(), list->end(),
+                         [id](const auto& s) { return s.id == id; });
+  if (it == list->end()) {
+    return nullptr;
+  }
+  auto next = std::make_shared<std::vector<Subscription<T>>>(*list);
+  next->erase(next->begin() + (it - list->begin()));
+  return next;
+}
+
+template <typename T>
+void ImageSignalBus::close_subscription(const SubscriberList<T>& list,
+                                        SubscriptionId id) {
+  if (!list) {
+    return;
+  }
+  for (const auto& subscription : *list) {
+    if (subscription.id == id) {
+      subscription.mailbox->close();
+    }
+  }
+}
+
+template <typename T>
+void ImageSignalBus::append_stats(const std::string& signal_name,
+                                  const SubscriberList<T>& list,
+                                  std::vector<SubscriberStats>& stats) {
+  if (!list) {
+    return;
+  }
+  for (const auto& subscription : *list) {
+    stats.push_back({subscription.id, signal_name,
+                     subscription.mailbox->mode(),
+                     subscription.mailbox->stats()});
+  }
+}
+
+template <typename T>
+ImageSignalBus::SubscriptionId ImageSignalBus::add_subscription(
+    Channel<T>& channel, const std::string& signal_name,
+    typename SignalMailbox<T>::Callback callback,
+    SubscriptionOptions options) {
+  auto subscription = make_subscription<T>(std::move(callback), options);
+  const SubscriptionId id = subscription.id;
   std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto& list = channel[signal_name];
+  list = with_subscription(list, std::move(subscription));
+  return id;
+}
+
+template <typename T>
+void ImageSignalBus::post_copy(const std::string& signal_name,
+                               const Channel<T>& channel,
+                               const T& data) const {
+  SubscriberList<T> list;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (auto it = channel.find(signal_name); it != channel.end()) {
+      list = it->second;
+    }
+  }
+  if (!list) {
+    return;
+  }
+  // Inline 订阅者在返回前用完数据，借用调用方的对象即可；
+  // 排队的订阅者共享一份拷贝，每次发送最多拷贝一次
+  const std::shared_ptr<const T> borrowed(std::shared_ptr<const T>(), &data);
+  std::shared_ptr<const T> owned;
+  const auto now = SignalMailbox<T>::Clock::now();
+  for (const auto& subscription : *list) {
+    if (!subscription.mailbox->try_claim(now)) {
+      continue;
+    }
+    if (subscription.mailbox->mode() == DeliveryMode::Inline) {
+      subscription.mailbox->post(borrowed);
+      continue;
+    }
+    if (!owned) {
+      owned = std::make_shared<const T>(data);
+    }
+    subscription.mailbox->post(owned);
+  }
+}
+
+ImageSignalBus::SignalHandle ImageSignalBus::declare_signal_locked(
+    const std::string& signal_name) {
+  if (auto it = signal_index_.find(signal_name); it != signal_index_.end()) {
+    return it->second;
+  }
+  if (signal_names_.size() >= kMaxSignals) {
+    throw std::length_error("ImageSignalBus: too many signals, cannot declare " +
+                            signal_name);
+  }
+  const SignalHandle handle{static_cast<uint32_t>(signal_names_.size())};
+  signal_names_.push_back(signal_name);
+  signal_index_.emplace(signal_name, handle);
+  return handle;
+}
+
+ImageSignalBus::SubscriberList<cv::Mat> ImageSignalBus::image_subscribers(
+    SignalHandle signal) const {
+  if (signal.index >= kMaxSignals) {  // 也排除了无效句柄
+    return nullptr;
+  }
+  return image_slots_[signal.index].load(std::memory_order_acquire);
+}
+
+ImageSignalBus::SignalHandle ImageSignalBus::declare_signal(
+    const std::string& signal_name) {
   // 声明信号（即使没有订阅者也要记录，便于 UI 发现）
-  if (subscribers_.find(signal_name) == subscribers_.end()) {
-    subscribers_[signal_name] = std::vector<ImageCallback>();
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  return declare_signal_locked(signal_name);
+}
+
+ImageSignalBus::SignalHandle ImageSignalBus::find_signal(
+    const std::string& signal_name) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = signal_index_.find(signal_name);
+  return it != signal_index_.end() ? it->second : SignalHandle{};
+}
+
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe(
+    const std::string& signal_name, ImageCallback callback,
+    SubscriptionOptions options) {
+  if (!callback) {
+    return 0;
   }
+  return subscribe(declare_signal(signal_name), std::move(callback), options);
 }
 
-void ImageSignalBus::subscribe(const std::string& signal_name,
-                               ImageCallback callback) {
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe_shared(
+    const std::string& signal_name, SharedImageCallback callback,
+    SubscriptionOptions options) {
+  if (!callback) {
+    return 0;
+  }
+  return subscribe_shared(declare_signal(signal_name), std::move(callback),
+                          options);
+}
+
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe(
+    SignalHandle signal, ImageCallback callback, SubscriptionOptions options) {
+  if (!callback) {
+    return 0;
+  }
+  return subscribe_shared(
+      signal,
+      [callback = std::move(callback)](const SharedImage& img) {
+        callback(*img);
+      },
+      options);
+}
+
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe_shared(
+    SignalHandle signal, SharedImageCallback callback,
+    SubscriptionOptions options) {
+  if (!callback) {
+    return 0;
+  }
+  return add_image_subscription(signal, std::move(callback), options, {});
+}
+
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe_preview(
+    const std::string& signal_name, ImageCallback callback,
+    const PreviewOptions& options) {
+  if (!callback) {
+    return 0;
+  }
+  return subscribe_preview(declare_signal(signal_name), std::move(callback),
+                           options);
+}
+
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe_preview(
+    SignalHandle signal, ImageCallback callback,
+    const PreviewOptions& options) {
+  if (!callback) {
+    return 0;
+  }
+  SubscriptionOptions delivery;
+  delivery.mode = options.mode;
+  delivery.queue_capacity = 2;  // 预览只关心最近的几帧
+  delivery.max_rate_hz = options.max_fps;
+  return add_image_subscription(
+      signal,
+      [callback = std::move(callback)](const SharedImage& img) {
+        callback(*img);
+      },
+      delivery, options.max_size);
+}
+
+ImageSignalBus::SubscriptionId ImageSignalBus::add_image_subscription(
+    SignalHandle signal, SharedImageCallback callback,
+    SubscriptionOptions options, cv::Size preview_size) {
+  auto subscription =
+      make_subscription<cv::Mat>(std::move(callback), options);
+  subscription.preview_size = preview_size;
+  const SubscriptionId id = subscription.id;
   std::unique_lock<std::shared_mutex> lock(mutex_);
-  subscribers_[signal_name].push_back(std::move(callback));
+  if (signal.index >= signal_names_.size()) {
+    return 0;  // 句柄不是 declare_signal 给出的
+  }
+  auto& slot = image_slots_[signal.index];
+  slot.store(with_subscription(slot.load(std::memory_order_relaxed),
+                               std::move(subscription)),
+             std::memory_order_release);
+  return id;
+}
+
+bool ImageSignalBus::unsubscribe(SubscriptionId id) {
+  // 被移除的信箱在锁外、在本线程上关闭：关闭时要等投递线程送完。
+  // 发送方可能还拿着旧快照，最后一个引用不一定在这里释放
+  SubscriberList<cv::Mat> old_images;
+  SubscriberList<FeatureData> old_features;
+  SubscriberList<StatusData> old_statuses;
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  for (size_t i = 0; i < signal_names_.size(); ++i) {
+    auto& slot = image_slots_[i];
+    auto current = slot.load(std::memory_order_relaxed);
+    if (auto next = without_subscription(current, id)) {
+      slot.store(std::move(next), std::memory_order_release);
+      old_images = std::move(current);
+      lock.unlock();
+      close_subscription(old_images, id);
+      return true;
+    }
+  }
+  for (auto& [name, list] : feature_subscribers_) {
+    if (auto next = without_subscription(list, id)) {
+      old_features = std::exchange(list, std::move(next));
+      lock.unlock();
+      close_subscription(old_features, id);
+      return true;
+    }
+  }
+  for (auto& [name, list] : status_subscribers_) {
+    if (auto next = without_subscription(list, id)) {
+      old_statuses = std::exchange(list, std::move(next));
+      lock.unlock();
+      close_subscription(old_statuses, id);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<ImageSignalBus::SubscriberStats> ImageSignalBus::subscriber_stats()
+    const {
+  std::vector<SubscriberStats> stats;
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  for (size_t i = 0; i < signal_names_.size(); ++i) {
+    append_stats(signal_names_[i],
+                 image_slots_[i].load(std::memory_order_acquire), stats);
+  }
+  for (const auto& [name, list] : feature_subscribers_) {
+    append_stats(name, list, stats);
+  }
+  for (const auto& [name, list] : status_subscribers_) {
+    append_stats(name, list, stats);
+  }
+  return stats;
+}
+
+bool ImageSignalBus::has_subscribers(const std::string& signal_name) const {
+  return has_subscribers(find_signal(signal_name));
+}
+
+bool ImageSignalBus::has_subscribers(SignalHandle signal) const {
+  const auto list = image_subscribers(signal);
+  if (!list) {
+    return false;
+  }
+  const auto now = SignalMailbox<cv::Mat>::Clock::now();
+  return std::any_of(list->begin(), list->end(), [now](const auto& s) {
+    return s.mailbox->accepting(now);
+  });
 }
 
 void ImageSignalBus::emit(const std::string& signal_name, const cv::Mat& img) {
+  emit(find_signal(signal_name), img);
+}
+
+void ImageSignalBus::emit(SignalHandle signal, const cv::Mat& img) {
   if (img.empty()) {
     return;
   }
+  if (const auto list = image_subscribers(signal)) {
+    deliver(*list, img, nullptr);
+  }
+}
 
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto it = subscribers_.find(signal_name);
-  if (it != subscribers_.end()) {
-    // 对每个订阅者发送**深拷贝**的图像
-    for (const auto& callback : it->second) {
-      if (callback) {
-        callback(img.clone());  // 深拷贝确保生命周期安全
+void ImageSignalBus::emit(const std::string& signal_name, SharedImage img) {
+  emit(find_signal(signal_name), std::move(img));
+}
+
+void ImageSignalBus::emit(SignalHandle signal, SharedImage img) {
+  if (!img || img->empty()) {
+    return;
+  }
+  if (const auto list = image_subscribers(signal)) {
+    deliver(*list, *img, img);
+  }
+}
+
+void ImageSignalBus::deliver(const std::vector<Subscription<cv::Mat>>& list,
+                             const cv::Mat& img, SharedImage full) {
+  const auto now = SignalMailbox<cv::Mat>::Clock::now();
+  const cv::Size source = img.size();
+  // 本次发送里已经生成的缩小图，按目标尺寸共享
+  std::vector<std::pair<cv::Size, SharedImage>> previews;
+  for (const auto& subscription : list) {
+    if (!subscription.mailbox->try_claim(now)) {
+      continue;
+    }
+    const cv::Size target = fit_within(source, subscription.preview_size);
+    if (target == source) {
+      // 只拷贝一次：img 可能是帧缓冲区的视图，回调返回后还可能被保留
+      if (!full) {
+        full = std::make_shared<const cv::Mat>(img.clone());
       }
+      subscription.mailbox->post(full);
+      continue;
     }
+    auto it = std::find_if(previews.begin(), previews.end(),
+                           [&](const auto& p) { return p.first == target; });
+    if (it == previews.end()) {
+      cv::Mat small;
+      cv::resize(img, small, target, 0, 0, cv::INTER_AREA);
+      previews.emplace_back(target,
+                            std::make_shared<const cv::Mat>(std::move(small)));
+      it = std::prev(previews.end());
+    }
+    subscription.mailbox->post(it->second);
   }
 }
 
-void ImageSignalBus::subscribe_feature(const std::string& name,
-                                       FeatureCallback cb) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  feature_subscribers_[name].push_back(std::move(cb));
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe_feature(
+    const std::string& name, FeatureCallback cb, SubscriptionOptions options) {
+  if (!cb) {
+    return 0;
+  }
+  return add_subscription(
+      feature_subscribers_, name,
+      [cb = std::move(cb)](const std::shared_ptr<const FeatureData>& data) {
+        cb(*data);
+      },
+      options);
 }
 
-void ImageSignalBus::subscribe_status(const std::string& name,
-                                      StatusCallback cb) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  status_subscribers_[name].push_back(std::move(cb));
+ImageSignalBus::SubscriptionId ImageSignalBus::subscribe_status(
+    const std::string& name, StatusCallback cb, SubscriptionOptions options) {
+  if (!cb) {
+    return 0;
+  }
+  return add_subscription(
+      status_subscribers_, name,
+      [cb = std::move(cb)](const std::shared_ptr<const StatusData>& data) {
+        cb(*data);
+      },
+      options);
 }
 
 void ImageSignalBus::emit_feature(const std::string& name,
                                   const FeatureData& data) {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  if (auto it = feature_subscribers_.find(name);
-      it != feature_subscribers_.end()) {
-    for (const auto& cb : it->second) {
-      if (cb) {
-        cb(data);
-      }
-    }
-  }
+  post_copy(name, feature_subscribers_, data);
 }
 
 void ImageSignalBus::emit_status(const std::string& name,
                                  const StatusData& data) {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  if (auto it = status_subscribers_.find(name);
-      it != status_subscribers_.end()) {
-    for (const auto& cb : it->second) {
-      if (cb) {
-        cb(data);
-      }
-    }
-  }
+  post_copy(name, status_subscribers_, data);
 }
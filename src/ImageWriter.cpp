@@ -0,0 +1,181 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ImageWriter.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "ImageWriter.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <opencv2/imgcodecs.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+ImageWriter::ImageWriter(ImageWriterConfig config) : config_(config) {
+  config_.workers = std::max<size_t>(1, config_.workers);
+  config_.queue_capacity = std::max<size_t>(1, config_.queue_capacity);
+  const int quality = std::clamp(config_.quality, 0, 100);
+  switch (config_.codec) {
+    case ImageCodec::Jpeg:
+      encode_params_ = {cv::IMWRITE_JPEG_QUALITY, quality};
+      break;
+    case ImageCodec::Webp:
+      encode_params_ = {cv::IMWRITE_WEBP_QUALITY, quality};
+      break;
+    case ImageCodec::Png:
+      // 质量越高压缩级别越低（写得越快）
+      encode_params_ = {cv::IMWRITE_PNG_COMPRESSION, (100 - quality) * 9 / 100};
+      break;
+    case ImageCodec::Bmp:
+      break;
+  }
+
+  workers_.reserve(config_.workers);
+  for (size_t i = 0; i < config_.workers; ++i) {
+    workers_.emplace_back([this]() { worker_loop(); });
+  }
+}
+
+ImageWriter::~ImageWriter() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  job_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+const char* ImageWriter::extension(ImageCodec codec) {
+  switch (codec) {
+    case ImageCodec::Jpeg:
+      return ".jpg";
+    case ImageCodec::Png:
+      return ".png";
+    case ImageCodec::Webp:
+      return ".webp";
+    case ImageCodec::Bmp:
+      return ".bmp";
+  }
+  return ".jpg";
+}
+
+bool ImageWriter::should_save(bool defects_found) const {
+  switch (config_.mode) {
+    case EvidenceMode::Off:
+      return false;
+    case EvidenceMode::Always:
+      return true;
+    case EvidenceMode::DefectsOnly:
+      return defects_found;
+  }
+  return false;
+}
+
+bool ImageWriter::submit(const std::string& path_stem, cv::Mat image) {
+  if (image.empty()) {
+    return false;
+  }
+  ++submitted_;
+  // 引用外部缓冲区的 Mat 不能跨线程持有
+  if (image.u == nullptr) {
+    image = image.clone();
+  }
+
+  Job job{path_stem + extension(config_.codec), std::move(image)};
+  {
+    std::lock_guard lock(mutex_);
+    if (jobs_.size() >= config_.queue_capacity) {
+      ++dropped_;
+      if (config_.drop_policy == WriteDropPolicy::DropNewest) {
+        return false;
+      }
+      jobs_.pop_front();
+    }
+    jobs_.push_back(std::move(job));
+  }
+  job_cv_.notify_one();
+  return true;
+}
+
+void ImageWriter::flush() {
+  std::unique_lock lock(mutex_);
+  idle_cv_.wait(lock, [this]() { return jobs_.empty() && in_flight_ == 0; });
+}
+
+void ImageWriter::worker_loop() {
+  // 每个线程复用自己的编码缓冲区
+  std::vector<uint8_t> buffer;
+  while (true) {
+    Job job;
+    {
+      std::unique_lock lock(mutex_);
+      job_cv_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;  // 正在停止且没有剩余任务
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      ++in_flight_;
+    }
+
+    if (write(job, buffer)) {
+      ++written_;
+    } else {
+      ++failed_;
+    }
+    job.image.release();
+
+    {
+      std::lock_guard lock(mutex_);
+      --in_flight_;
+      if (jobs_.empty() && in_flight_ == 0) {
+        idle_cv_.notify_all();
+      }
+    }
+  }
+}
+
+bool ImageWriter::write(const Job& job, std::vector<uint8_t>& buffer) const {
+  buffer.clear();
+  if (!cv::imencode(extension(config_.codec), job.image, buffer,
+                    encode_params_)) {
+    return false;
+  }
+  std::ofstream file(job.path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(buffer.data()),
+             static_cast<std::streamsize>(buffer.size()));
+  return static_cast<bool>(file);
+}
+
+ImageWriter::Stats ImageWriter::stats() const {
+  Stats s;
+  s.submitted = submitted_.load();
+  s.written = written_.load();
+  s.dropped = dropped_.load();
+  s.failed = failed_.load();
+  return s;
+}
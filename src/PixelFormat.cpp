@@ -0,0 +1,204 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: PixelFormat.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "PixelFormat.hpp"
+
+namespace {
+
+// SDK 的 dvpImageFormat 没有定义 RGB64，但彩色格式的取值与 dvpStreamFormat
+// 一一对应，以 S_RGB64 输出的帧 format 字段就是这个值
+constexpr int kFormatRGB64 = S_RGB64;
+
+}  // namespace
+
+PixelFormat pixel_format_from_frame(dvpImageFormat format, dvpBits bits) {
+  const bool wide = bits != BITS_8;
+  // 按整数比较，才能匹配枚举里没有的 kFormatRGB64
+  switch (static_cast<int>(format)) {
+    case FORMAT_MONO:
+      return wide ? PixelFormat::Mono16 : PixelFormat::Mono8;
+    case FORMAT_BAYER_BG:
+      return wide ? PixelFormat::BayerBG16 : PixelFormat::BayerBG8;
+    case FORMAT_BAYER_GB:
+      return wide ? PixelFormat::BayerGB16 : PixelFormat::BayerGB8;
+    case FORMAT_BAYER_GR:
+      return wide ? PixelFormat::BayerGR16 : PixelFormat::BayerGR8;
+    case FORMAT_BAYER_RG:
+      return wide ? PixelFormat::BayerRG16 : PixelFormat::BayerRG8;
+    case FORMAT_BGR24:
+      return PixelFormat::BGR24;
+    case FORMAT_BGR32:
+      return PixelFormat::BGR32;
+    case FORMAT_BGR48:
+      return PixelFormat::BGR48;
+    case FORMAT_BGR64:
+      return PixelFormat::BGR64;
+    case FORMAT_RGB24:
+      return PixelFormat::RGB24;
+    case FORMAT_RGB32:
+      return PixelFormat::RGB32;
+    case FORMAT_RGB48:
+      return PixelFormat::RGB48;
+    case kFormatRGB64:
+      return PixelFormat::RGB64;
+    default:
+      return PixelFormat::Unknown;
+  }
+}
+
+PixelFormat pixel_format_from_stream(dvpStreamFormat format) {
+  switch (format) {
+    case S_MONO8:
+      return PixelFormat::Mono8;
+    case S_MONO10:
+    case S_MONO12:
+    case S_MONO14:
+    case S_MONO16:
+      return PixelFormat::Mono16;
+    case S_BGR24:
+    case S_B8_G8_R8:
+      return PixelFormat::BGR24;
+    case S_BGR32:
+      return PixelFormat::BGR32;
+    case S_BGR48:
+    case S_B16_G16_R16:
+      return PixelFormat::BGR48;
+    case S_BGR64:
+      return PixelFormat::BGR64;
+    case S_RGB24:
+      return PixelFormat::RGB24;
+    case S_RGB32:
+      return PixelFormat::RGB32;
+    case S_RGB48:
+      return PixelFormat::RGB48;
+    case S_RGB64:
+      return PixelFormat::RGB64;
+    default:
+      return PixelFormat::Unknown;
+  }
+}
+
+size_t bytes_per_pixel(PixelFormat format) {
+  const size_t depth = is_16bit(format) ? 2 : 1;
+  return static_cast<size_t>(channel_count(format)) * depth;
+}
+
+size_t bytes_per_pixel(dvpStreamFormat format) {
+  switch (format) {
+    case S_RAW8:
+      return 1;
+    case S_RAW10:
+    case S_RAW12:
+    case S_RAW14:
+    case S_RAW16:
+      return 2;
+    default:
+      return bytes_per_pixel(pixel_format_from_stream(format));
+  }
+}
+
+int channel_count(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::Unknown:
+      return 0;
+    case PixelFormat::BGR24:
+    case PixelFormat::BGR48:
+    case PixelFormat::RGB24:
+    case PixelFormat::RGB48:
+      return 3;
+    case PixelFormat::BGR32:
+    case PixelFormat::BGR64:
+    case PixelFormat::RGB32:
+    case PixelFormat::RGB64:
+      return 4;
+    default:
+      return 1;  // Mono / Bayer
+  }
+}
+
+bool is_bayer(PixelFormat format) {
+  return format >= PixelFormat::BayerBG8 && format <= PixelFormat::BayerRG16;
+}
+
+bool is_16bit(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::Mono16:
+    case PixelFormat::BayerBG16:
+    case PixelFormat::BayerGB16:
+    case PixelFormat::BayerGR16:
+    case PixelFormat::BayerRG16:
+    case PixelFormat::BGR48:
+    case PixelFormat::BGR64:
+    case PixelFormat::RGB48:
+    case PixelFormat::RGB64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const char* pixel_format_name(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::Mono8:
+      return "Mono8";
+    case PixelFormat::Mono16:
+      return "Mono16";
+    case PixelFormat::BayerBG8:
+      return "BayerBG8";
+    case PixelFormat::BayerGB8:
+      return "BayerGB8";
+    case PixelFormat::BayerGR8:
+      return "BayerGR8";
+    case PixelFormat::BayerRG8:
+      return "BayerRG8";
+    case PixelFormat::BayerBG16:
+      return "BayerBG16";
+    case PixelFormat::BayerGB16:
+      return "BayerGB16";
+    case PixelFormat::BayerGR16:
+      return "BayerGR16";
+    case PixelFormat::BayerRG16:
+      return "BayerRG16";
+    case PixelFormat::BGR24:
+      return "BGR24";
+    case PixelFormat::BGR32:
+      return "BGR32";
+    case PixelFormat::BGR48:
+      return "BGR48";
+    case PixelFormat::BGR64:
+      return "BGR64";
+    case PixelFormat::RGB24:
+      return "RGB24";
+    case PixelFormat::RGB32:
+      return "RGB32";
+    case PixelFormat::RGB48:
+      return "RGB48";
+    case PixelFormat::RGB64:
+      return "RGB64";
+    default:
+      return "Unknown";
+  }
+}
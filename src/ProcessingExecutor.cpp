@@ -0,0 +1,186 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ProcessingExecutor.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "ProcessingExecutor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "utils/thread_affinity.h"
+
+ProcessingExecutor::Workers::Workers(ProcessingExecutor& owner, size_t count,
+                                     std::vector<int> cpus, bool pinned)
+    : owner_(owner),
+      count_(count),
+      cpus_(std::move(cpus)),
+      pinned_(pinned),
+      pool_(count, [this]() {
+        if (pinned_ && !cpus_.empty()) {
+          // 每个 worker 固定在 lane 的一个核心上
+          const size_t index = next_worker_.fetch_add(1) % cpus_.size();
+          DvpUtils::pinCurrentThread({cpus_[index]});
+        }
+      }) {}
+
+ProcessingExecutor::Workers::~Workers() {
+  pool_.wait();
+  owner_.release(count_, cpus_);
+}
+
+ProcessingExecutor& ProcessingExecutor::instance() {
+  static ProcessingExecutor executor;
+  return executor;
+}
+
+ProcessingExecutor::ProcessingExecutor() { configure(ExecutorConfig{}); }
+
+void ProcessingExecutor::configure(const ExecutorConfig& cfg) {
+  std::lock_guard lock(mutex_);
+  config_ = cfg;
+  config_.expected_lanes = std::max<size_t>(1, cfg.expected_lanes);
+
+  const size_t cpu_count = DvpUtils::getLogicalCpuCount();
+  total_workers_ = cfg.total_workers == 0 ? cpu_count : cfg.total_workers;
+  if (cpu_taken_.size() != cpu_count) {
+    cpu_taken_.assign(cpu_count, false);
+  }
+
+  if (cfg.opencv_threads >= 0) {
+    cv::setNumThreads(cfg.opencv_threads);
+  }
+}
+
+ExecutorConfig ProcessingExecutor::get_config() const {
+  std::lock_guard lock(mutex_);
+  return config_;
+}
+
+std::shared_ptr<ProcessingExecutor::Lane> ProcessingExecutor::acquire_lane(
+    const WorkerBudget& budget) {
+  // 声明在锁之前，解锁后才析构：这里的引用可能是最后一个，
+  // 而 Workers 析构时会调用 release() 再次加锁
+  std::vector<std::shared_ptr<Workers>> alive;
+  std::lock_guard lock(mutex_);
+  std::erase_if(workers_, [](const auto& weak) { return weak.expired(); });
+
+  const size_t remaining =
+      total_workers_ > workers_in_use_ ? total_workers_ - workers_in_use_ : 0;
+  if (remaining == 0) {
+    // 预算用完时不再创建线程，与共用者最少的一组现有 worker 共用
+    for (const auto& weak : workers_) {
+      if (auto shared = weak.lock()) {
+        alive.push_back(std::move(shared));
+      }
+    }
+    const auto least_shared = std::min_element(
+        alive.begin(), alive.end(), [](const auto& a, const auto& b) {
+          return a.use_count() < b.use_count();
+        });
+    if (least_shared == alive.end()) {
+      throw std::runtime_error("ProcessingExecutor: worker budget exhausted");
+    }
+    return std::make_shared<Lane>(*least_shared);
+  }
+
+  size_t workers =
+      budget.workers != 0
+          ? budget.workers
+          : std::max<size_t>(1, total_workers_ / config_.expected_lanes);
+  workers = std::min(workers, remaining);
+
+  std::vector<int> cpus;
+  if (config_.pin_threads) {
+    if (!budget.cpus.empty() && cpus_available(budget.cpus)) {
+      cpus = budget.cpus;
+      for (int cpu : cpus) {
+        cpu_taken_[cpu] = true;
+      }
+    } else {
+      // 指定的核心越界或已被其他 lane 占用时，改为顺序分配
+      cpus = take_cpus(workers);
+    }
+  }
+  const bool pinned = !cpus.empty();
+  workers_in_use_ += workers;
+
+  auto shared =
+      std::make_shared<Workers>(*this, workers, std::move(cpus), pinned);
+  workers_.push_back(shared);
+  return std::make_shared<Lane>(std::move(shared));
+}
+
+size_t ProcessingExecutor::total_workers() const {
+  std::lock_guard lock(mutex_);
+  return total_workers_;
+}
+
+size_t ProcessingExecutor::workers_in_use() const {
+  std::lock_guard lock(mutex_);
+  return workers_in_use_;
+}
+
+void ProcessingExecutor::release(size_t workers, const std::vector<int>& cpus) {
+  std::lock_guard lock(mutex_);
+  workers_in_use_ -= std::min(workers, workers_in_use_);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && static_cast<size_t>(cpu) < cpu_taken_.size()) {
+      cpu_taken_[cpu] = false;
+    }
+  }
+}
+
+bool ProcessingExecutor::cpus_available(const std::vector<int>& cpus) const {
+  std::vector<bool> requested(cpu_taken_.size(), false);
+  for (int cpu : cpus) {
+    if (cpu < 0 || static_cast<size_t>(cpu) >= cpu_taken_.size() ||
+        cpu_taken_[cpu] || requested[cpu]) {
+      return false;
+    }
+    requested[cpu] = true;
+  }
+  return true;
+}
+
+std::vector<int> ProcessingExecutor::take_cpus(size_t count) {
+  // 优先找一段连续的空闲核心
+  std::vector<int> cpus;
+  for (size_t start = 0; start + count <= cpu_taken_.size(); ++start) {
+    const auto first = cpu_taken_.begin() + start;
+    if (std::none_of(first, first + count, [](bool taken) { return taken; })) {
+      for (size_t i = 0; i < count; ++i) {
+        cpu_taken_[start + i] = true;
+        cpus.push_back(static_cast<int>(start + i));
+      }
+      return cpus;
+    }
+  }
+  // 没有连续空间时不绑核，交给操作系统调度
+  return cpus;
+}
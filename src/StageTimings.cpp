@@ -0,0 +1,208 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: StageTimings.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "StageTimings.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <utility>
+
+namespace {
+
+std::atomic<uint64_t> next_timings_id{1};
+
+// 线程到分片的缓存，键为 StageTimings::id_
+struct ShardCacheEntry {
+  uint64_t id;
+  void* shard;
+};
+thread_local std::vector<ShardCacheEntry> shard_cache;
+
+}  // namespace
+
+size_t LatencyHistogram::bucket_of(uint64_t ns) {
+  constexpr uint64_t kLinear = uint64_t{1} << (kSubBits + 1);
+  if (ns < kLinear) {
+    return static_cast<size_t>(ns);
+  }
+  const int exponent = std::bit_width(ns) - 1;  // >= kSubBits + 1
+  if (exponent >= kMaxExponent) {
+    return kBuckets - 1;
+  }
+  const uint64_t sub = (ns >> (exponent - kSubBits)) & ((1u << kSubBits) - 1);
+  return static_cast<size_t>(kLinear +
+                             (exponent - kSubBits - 1) * (1u << kSubBits) +
+                             sub);
+}
+
+uint64_t LatencyHistogram::bucket_upper(size_t bucket) {
+  constexpr uint64_t kLinear = uint64_t{1} << (kSubBits + 1);
+  if (bucket < kLinear) {
+    return bucket;
+  }
+  const size_t offset = bucket - kLinear;
+  const int exponent = static_cast<int>(offset >> kSubBits) + kSubBits + 1;
+  const uint64_t sub = offset & ((1u << kSubBits) - 1);
+  const uint64_t base = uint64_t{1} << exponent;
+  const uint64_t width = uint64_t{1} << (exponent - kSubBits);
+  return base + (sub + 1) * width - 1;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+  bump(buckets_[bucket_of(ns)], 1);
+  bump(count_, 1);
+  bump(sum_, ns);
+  if (ns > max_.load(std::memory_order_relaxed)) {
+    max_.store(ns, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::accumulate(std::vector<uint64_t>& counts,
+                                  uint64_t& count, uint64_t& sum,
+                                  uint64_t& max) const {
+  for (size_t i = 0; i < kBuckets; ++i) {
+    counts[i] += buckets_[i].load(std::memory_order_relaxed);
+  }
+  count += count_.load(std::memory_order_relaxed);
+  sum += sum_.load(std::memory_order_relaxed);
+  max = std::max(max, max_.load(std::memory_order_relaxed));
+}
+
+StageTimings::StageTimings(std::vector<std::string> stage_names)
+    : id_(next_timings_id.fetch_add(1)), names_(std::move(stage_names)) {}
+
+StageTimings::~StageTimings() {
+  Shard* shard = shards_.load(std::memory_order_acquire);
+  while (shard) {
+    Shard* next = shard->next;
+    delete shard;
+    shard = next;
+  }
+}
+
+StageTimings::Shard* StageTimings::local_shard() {
+  for (const auto& entry : shard_cache) {
+    if (entry.id == id_) {
+      return static_cast<Shard*>(entry.shard);
+    }
+  }
+  auto* shard = new Shard(names_.size());
+  shard->next = shards_.load(std::memory_order_relaxed);
+  while (!shards_.compare_exchange_weak(shard->next, shard,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+  }
+  shard_cache.push_back({id_, shard});
+  return shard;
+}
+
+void StageTimings::record(size_t stage, std::chrono::nanoseconds elapsed) {
+  if (stage >= names_.size()) {
+    return;
+  }
+  const int64_t ns = elapsed.count();
+  local_shard()->stages[stage].record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+}
+
+std::vector<StageTimingStats> StageTimings::snapshot() const {
+  std::vector<StageTimingStats> result;
+  result.reserve(names_.size());
+  std::vector<uint64_t> counts(LatencyHistogram::kBuckets);
+  for (size_t stage = 0; stage < names_.size(); ++stage) {
+    std::fill(counts.begin(), counts.end(), 0);
+    uint64_t count = 0, sum = 0, max = 0;
+    for (Shard* shard = shards_.load(std::memory_order_acquire); shard;
+         shard = shard->next) {
+      shard->stages[stage].accumulate(counts, count, sum, max);
+    }
+
+    StageTimingStats stats;
+    stats.stage = names_[stage];
+    stats.count = count;
+    if (count > 0) {
+      // 分位数取所在桶的上界，不超过观测到的最大值
+      auto percentile = [&](double q) {
+        const uint64_t rank =
+            std::max<uint64_t>(1, static_cast<uint64_t>(q * count + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+          seen += counts[i];
+          if (seen >= rank) {
+            return std::min(LatencyHistogram::bucket_upper(i), max) / 1000.0;
+          }
+        }
+        return max / 1000.0;
+      };
+      stats.mean_us = static_cast<double>(sum) / count / 1000.0;
+      stats.p50_us = percentile(0.50);
+      stats.p99_us = percentile(0.99);
+      stats.max_us = max / 1000.0;
+    }
+    result.push_back(std::move(stats));
+  }
+  return result;
+}
+
+void StageTimingReporter::start(
+    std::function<std::vector<StageTimingStats>()> source, Sink sink,
+    std::chrono::milliseconds interval) {
+  stop();
+  stopping_ = false;
+  thread_ = std::thread([this, source = std::move(source),
+                         sink = std::move(sink), interval] {
+    std::unique_lock lock(mutex_);
+    while (!cv_.wait_for(lock, interval, [this] { return stopping_; })) {
+      lock.unlock();
+      sink(source());
+      lock.lock();
+    }
+  });
+}
+
+void StageTimingReporter::stop() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void StageTimingReporter::print(const std::vector<StageTimingStats>& stats) {
+  for (const auto& s : stats) {
+    if (s.count == 0) {
+      continue;
+    }
+    std::printf("%-14s n=%-8llu mean=%9.1fus p50=%9.1fus p99=%9.1fus "
+                "max=%9.1fus\n",
+                s.stage.c_str(), static_cast<unsigned long long>(s.count),
+                s.mean_us, s.p50_us, s.p99_us, s.max_us);
+  }
+  std::fflush(stdout);
+}
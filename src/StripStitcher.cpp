@@ -0,0 +1,162 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: StripStitcher.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "StripStitcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+StripStitcher::StripStitcher(std::vector<StitchSlice> slices,
+                             std::shared_ptr<FrameBufferPool> pool)
+    : slices_(std::move(slices)), pool_(std::move(pool)) {
+  if (slices_.empty()) {
+    throw std::invalid_argument("StripStitcher: no slices");
+  }
+  std::vector<size_t> order(slices_.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return slices_[a].dst_x < slices_[b].dst_x;
+  });
+  for (size_t i : order) {
+    const StitchSlice& slice = slices_[i];
+    if (slice.src_x < 0 || slice.width <= 0 || slice.dst_x != output_width_) {
+      throw std::invalid_argument(
+          "StripStitcher: slices must tile the output from column 0");
+    }
+    output_width_ += slice.width;
+  }
+  if (!pool_) {
+    pool_ = FrameBufferPool::create(0, 4);
+  }
+}
+
+std::vector<StitchSlice> StripStitcher::slices_from_offsets(
+    std::span<const int> widths, std::span<const int> offsets) {
+  if (widths.empty() || widths.size() != offsets.size()) {
+    throw std::invalid_argument("StripStitcher: widths/offsets mismatch");
+  }
+  const size_t count = widths.size();
+  // 第 i 台相机负责拼接坐标 [cuts[i], cuts[i + 1])
+  std::vector<int> cuts(count + 1);
+  cuts[0] = offsets[0];
+  cuts[count] = offsets[count - 1] + widths[count - 1];
+  for (size_t i = 1; i < count; ++i) {
+    const int prev_end = offsets[i - 1] + widths[i - 1];
+    if (offsets[i] <= offsets[i - 1] || offsets[i] > prev_end) {
+      throw std::invalid_argument(
+          "StripStitcher: cameras must overlap or touch, left to right");
+    }
+    cuts[i] = (offsets[i] + prev_end) / 2;  // 重叠区的中线
+  }
+
+  std::vector<StitchSlice> slices(count);
+  for (size_t i = 0; i < count; ++i) {
+    slices[i].src_x = cuts[i] - offsets[i];
+    slices[i].width = cuts[i + 1] - cuts[i];
+    slices[i].dst_x = cuts[i] - cuts[0];
+  }
+  return slices;
+}
+
+CapturedFramePtr StripStitcher::stitch(
+    const FrameSynchronizer::FrameSet& frames) const {
+  if (frames.size() != slices_.size()) {
+    return nullptr;
+  }
+  auto reference = std::find_if(frames.begin(), frames.end(),
+                                [](const auto& f) { return f != nullptr; });
+  if (reference == frames.end()) {
+    return nullptr;
+  }
+  const CapturedFrame& ref = **reference;
+  const size_t bpp = bytes_per_pixel(ref.pixel_format);
+  const int height = ref.height();
+  if (bpp == 0 || height <= 0) {
+    return nullptr;
+  }
+  // Bayer 帧按奇数列平移会错开 CFA 相位，输出沿用参考帧的排列，
+  // 每个切片的列偏移必须是偶数
+  if (is_bayer(ref.pixel_format)) {
+    for (const StitchSlice& slice : slices_) {
+      if ((slice.src_x - slice.dst_x) % 2 != 0) {
+        return nullptr;
+      }
+    }
+  }
+  for (size_t i = 0; i < frames.size(); ++i) {
+    const CapturedFrame* frame = frames[i].get();
+    if (!frame) {
+      continue;
+    }
+    const size_t stride =
+        frame->stride > 0 ? frame->stride
+                          : static_cast<size_t>(frame->width()) * bpp;
+    if (frame->pixel_format != ref.pixel_format ||
+        frame->height() != height ||
+        slices_[i].src_x + slices_[i].width > frame->width() ||
+        stride * static_cast<size_t>(height) > frame->data.size()) {
+      return nullptr;
+    }
+  }
+
+  const size_t out_stride = static_cast<size_t>(output_width_) * bpp;
+  const size_t bytes = out_stride * static_cast<size_t>(height);
+  auto out = pool_->acquire(bytes);
+  out->data.resize_uninitialized(bytes);
+  uint8_t* dst_base = out->data.data();
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    const StitchSlice& slice = slices_[i];
+    const size_t row_bytes = static_cast<size_t>(slice.width) * bpp;
+    uint8_t* dst = dst_base + static_cast<size_t>(slice.dst_x) * bpp;
+    const CapturedFrame* frame = frames[i].get();
+    if (!frame) {
+      for (int y = 0; y < height; ++y) {
+        std::memset(dst + y * out_stride, 0, row_bytes);
+      }
+      continue;
+    }
+    const size_t stride =
+        frame->stride > 0 ? frame->stride
+                          : static_cast<size_t>(frame->width()) * bpp;
+    const uint8_t* src =
+        frame->data.data() + static_cast<size_t>(slice.src_x) * bpp;
+    for (int y = 0; y < height; ++y) {
+      std::memcpy(dst + y * out_stride, src + y * stride, row_bytes);
+    }
+  }
+
+  out->sequence = ref.sequence;
+  out->meta = ref.meta;
+  out->meta.iWidth = output_width_;
+  out->meta.uBytes = static_cast<decltype(out->meta.uBytes)>(bytes);
+  out->pixel_format = ref.pixel_format;
+  out->stride = out_stride;
+  return out;
+}
@@ -0,0 +1,158 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: BorderTracker.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/BorderTracker.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace algo {
+
+namespace {
+
+bool is_white(ColumnProfile& profile, int x, double ratio) {
+  return static_cast<double>(profile.count(x)) / profile.sampled_rows() >
+         ratio;
+}
+
+}  // namespace
+
+std::pair<int, int> BorderTracker::update(ColumnProfile& profile,
+                                          double ratio, uint64_t sequence) {
+  const int width = profile.width();
+  if (width <= 0 || profile.sampled_rows() <= 0) {
+    return {0, width - 1};
+  }
+
+  // 只在锁内取上一帧的边界，查找本身不持锁
+  int x_min = 0;
+  int x_max = 0;
+  bool can_track = false;
+  uint64_t generation = 0;
+  {
+    std::lock_guard lock(mutex_);
+    x_min = x_min_;
+    x_max = x_max_;
+    can_track = valid_ && width == width_ && width >= 2 &&
+                since_full_ < refresh_interval_;
+    generation = generation_;
+  }
+
+  const bool tracked = can_track && track_left(profile, ratio, x_min) &&
+                       track_right(profile, ratio, x_max);
+  if (!tracked) {
+    std::tie(x_min, x_max) = find_content_bounds(profile, ratio);
+  }
+
+  std::lock_guard lock(mutex_);
+  if (tracked) {
+    ++stats_.tracked;
+  } else {
+    ++stats_.full_searches;
+  }
+  if (generation == generation_ && (!valid_ || sequence >= sequence_)) {
+    since_full_ = tracked ? since_full_ + 1 : 0;
+    valid_ = true;
+    width_ = width;
+    x_min_ = x_min;
+    x_max_ = x_max;
+    sequence_ = sequence;
+  }
+  return {x_min, x_max};
+}
+
+// 左边界是白边之后的第一个非白边列，从上一帧的位置向两侧找分界
+bool BorderTracker::track_left(ColumnProfile& profile, double ratio,
+                               int& x) const {
+  const int width = profile.width();
+  if (!is_white(profile, 0, ratio)) {
+    x = 0;
+    return true;
+  }
+  x = std::clamp(x, 1, width - 1);
+  const int lo = std::max(1, x - window_);
+  const int hi = std::min(width - 1, x + window_);
+  if (is_white(profile, x, ratio)) {
+    while (is_white(profile, x, ratio)) {
+      if (x >= hi) {
+        // 整行都是白边时与完整查找一样返回最后一列
+        return x == width - 1;
+      }
+      ++x;
+    }
+    return true;
+  }
+  while (!is_white(profile, x - 1, ratio)) {
+    if (x - 1 <= lo) {
+      return false;
+    }
+    --x;
+  }
+  return true;
+}
+
+// 右边界是白边之前的最后一个非白边列
+bool BorderTracker::track_right(ColumnProfile& profile, double ratio,
+                                int& x) const {
+  const int width = profile.width();
+  if (!is_white(profile, width - 1, ratio)) {
+    x = width - 1;
+    return true;
+  }
+  x = std::clamp(x, 0, width - 2);
+  const int lo = std::max(0, x - window_);
+  const int hi = std::min(width - 2, x + window_);
+  if (is_white(profile, x, ratio)) {
+    while (is_white(profile, x, ratio)) {
+      if (x <= lo) {
+        return x == 0;
+      }
+      --x;
+    }
+    return true;
+  }
+  while (!is_white(profile, x + 1, ratio)) {
+    if (x + 1 >= hi) {
+      return false;
+    }
+    ++x;
+  }
+  return true;
+}
+
+void BorderTracker::reset() {
+  std::lock_guard lock(mutex_);
+  valid_ = false;
+  ++generation_;
+}
+
+BorderTracker::Stats BorderTracker::stats() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+}  // namespace algo
@@ -0,0 +1,266 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ColumnProfile.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/ColumnProfile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COLUMN_PROFILE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLUMN_PROFILE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COLUMN_PROFILE_NEON 1
+#endif
+
+namespace algo {
+
+namespace {
+
+// 8 位计数器最多累加 255 行后必须加宽
+constexpr int kBatchRows = 255;
+
+// acc[x] += (row[x] > threshold)，threshold < 255
+void accumulate_row(const uint8_t* row, int width, uint8_t threshold,
+                    uint8_t* acc) {
+  int x = 0;
+  // 无符号 a > t 等价于 max(a, t + 1) == a；比较结果为 0xFF，减去即 +1
+#if defined(COLUMN_PROFILE_AVX2)
+  const __m256i t = _mm256_set1_epi8(static_cast<char>(threshold + 1));
+  for (; x + 32 <= width; x += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x));
+    const __m256i bright = _mm256_cmpeq_epi8(_mm256_max_epu8(v, t), v);
+    __m256i* dst = reinterpret_cast<__m256i*>(acc + x);
+    _mm256_storeu_si256(dst,
+                        _mm256_sub_epi8(_mm256_loadu_si256(dst), bright));
+  }
+#elif defined(COLUMN_PROFILE_SSE2)
+  const __m128i t = _mm_set1_epi8(static_cast<char>(threshold + 1));
+  for (; x + 16 <= width; x += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+    const __m128i bright = _mm_cmpeq_epi8(_mm_max_epu8(v, t), v);
+    __m128i* dst = reinterpret_cast<__m128i*>(acc + x);
+    _mm_storeu_si128(dst, _mm_sub_epi8(_mm_loadu_si128(dst), bright));
+  }
+#elif defined(COLUMN_PROFILE_NEON)
+  const uint8x16_t t = vdupq_n_u8(threshold);
+  for (; x + 16 <= width; x += 16) {
+    const uint8x16_t bright = vcgtq_u8(vld1q_u8(row + x), t);
+    vst1q_u8(acc + x, vsubq_u8(vld1q_u8(acc + x), bright));
+  }
+#endif
+  for (; x < width; ++x) {
+    acc[x] += row[x] > threshold ? 1 : 0;
+  }
+}
+
+// 对正好一块（32 列）的 [y, y_end) 采样行做同样的累加，计数器全程放在
+// 寄存器中，每行只有一次加载
+void accumulate_block(const cv::Mat& gray, int x, int y, int y_end,
+                      int row_step, uint8_t threshold, uint8_t* acc) {
+  static_assert(ColumnProfile::kBlockColumns == 32);
+#if defined(COLUMN_PROFILE_AVX2)
+  const __m256i t = _mm256_set1_epi8(static_cast<char>(threshold + 1));
+  __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+  for (; y < y_end; y += row_step) {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(gray.ptr<uint8_t>(y) + x));
+    sum = _mm256_sub_epi8(sum, _mm256_cmpeq_epi8(_mm256_max_epu8(v, t), v));
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), sum);
+#elif defined(COLUMN_PROFILE_SSE2)
+  const __m128i t = _mm_set1_epi8(static_cast<char>(threshold + 1));
+  __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc));
+  __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 16));
+  for (; y < y_end; y += row_step) {
+    const uint8_t* row = gray.ptr<uint8_t>(y) + x;
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+    const __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 16));
+    lo = _mm_sub_epi8(lo, _mm_cmpeq_epi8(_mm_max_epu8(a, t), a));
+    hi = _mm_sub_epi8(hi, _mm_cmpeq_epi8(_mm_max_epu8(b, t), b));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(acc), lo);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 16), hi);
+#elif defined(COLUMN_PROFILE_NEON)
+  const uint8x16_t t = vdupq_n_u8(threshold);
+  uint8x16_t lo = vld1q_u8(acc);
+  uint8x16_t hi = vld1q_u8(acc + 16);
+  for (; y < y_end; y += row_step) {
+    const uint8_t* row = gray.ptr<uint8_t>(y) + x;
+    lo = vsubq_u8(lo, vcgtq_u8(vld1q_u8(row), t));
+    hi = vsubq_u8(hi, vcgtq_u8(vld1q_u8(row + 16), t));
+  }
+  vst1q_u8(acc, lo);
+  vst1q_u8(acc + 16, hi);
+#else
+  for (; y < y_end; y += row_step) {
+    accumulate_row(gray.ptr<uint8_t>(y) + x, ColumnProfile::kBlockColumns,
+                   threshold, acc);
+  }
+#endif
+}
+
+}  // namespace
+
+int count_bright_columns(const cv::Mat& gray, int row_step, uint8_t threshold,
+                         int x_begin, int x_end, uint32_t* counts) {
+  row_step = std::max(row_step, 1);
+  x_begin = std::max(x_begin, 0);
+  x_end = std::min(x_end, gray.cols);
+  const int width = x_end - x_begin;
+  if (width <= 0) {
+    return 0;
+  }
+  std::fill(counts, counts + width, 0u);
+  if (gray.empty() || gray.type() != CV_8UC1) {
+    return 0;
+  }
+  const int height = gray.rows;
+  const int sampled_rows = (height + row_step - 1) / row_step;
+  if (threshold == 255) {
+    return sampled_rows;  // 没有像素能大于 255
+  }
+
+  // 单块时计数器放在栈上，整幅统计时才需要堆内存
+  uint8_t local[ColumnProfile::kBlockColumns];
+  std::vector<uint8_t> heap;
+  uint8_t* acc = local;
+  if (width > ColumnProfile::kBlockColumns) {
+    heap.resize(width);
+    acc = heap.data();
+  }
+
+  int y = 0;
+  while (y < height) {
+    std::fill(acc, acc + width, 0);
+    const int batch_end =
+        static_cast<int>(std::min<int64_t>(
+            height, y + static_cast<int64_t>(kBatchRows) * row_step));
+    if (width == ColumnProfile::kBlockColumns) {
+      accumulate_block(gray, x_begin, y, batch_end, row_step, threshold, acc);
+    } else {
+      for (int r = y; r < batch_end; r += row_step) {
+        accumulate_row(gray.ptr<uint8_t>(r) + x_begin, width, threshold, acc);
+      }
+    }
+    // 下一批从本批最后一个采样行之后的采样行开始
+    y += ((batch_end - y + row_step - 1) / row_step) * row_step;
+    for (int x = 0; x < width; ++x) {
+      counts[x] += acc[x];
+    }
+  }
+  return sampled_rows;
+}
+
+int count_bright_columns(const cv::Mat& gray, int row_step, uint8_t threshold,
+                         std::vector<uint32_t>& counts) {
+  counts.assign(std::max(gray.cols, 0), 0);
+  if (counts.empty()) {
+    return 0;
+  }
+  return count_bright_columns(gray, row_step, threshold, 0, gray.cols,
+                              counts.data());
+}
+
+void ColumnProfile::reset(const cv::Mat& gray, int row_step,
+                          uint8_t threshold) {
+  gray_ = gray;
+  row_step_ = std::max(row_step, 1);
+  threshold_ = threshold;
+  sampled_rows_ = gray.empty() ? 0 : (gray.rows + row_step_ - 1) / row_step_;
+  counts_.resize(std::max(gray.cols, 0));
+  ready_.assign((counts_.size() + kBlockColumns - 1) / kBlockColumns, 0);
+}
+
+void ColumnProfile::release() {
+  gray_.release();
+  sampled_rows_ = 0;
+  ready_.clear();
+}
+
+uint32_t ColumnProfile::count(int x) {
+  const int block = x / kBlockColumns;
+  if (!ready_[block]) {
+    const int begin = block * kBlockColumns;
+    const int end = std::min(begin + kBlockColumns, gray_.cols);
+    count_bright_columns(gray_, row_step_, threshold_, begin, end,
+                         counts_.data() + begin);
+    ready_[block] = 1;
+  }
+  return counts_[x];
+}
+
+std::pair<int, int> find_content_bounds(ColumnProfile& profile, double ratio) {
+  const int width = profile.width();
+  const int sampled_rows = profile.sampled_rows();
+  if (width == 0 || sampled_rows <= 0) {
+    return {0, width - 1};
+  }
+  auto is_white = [&](int x) {
+    return static_cast<double>(profile.count(x)) / sampled_rows > ratio;
+  };
+  // 二分查左边界
+  int x_min = 0;
+  if (is_white(0)) {
+    int left = 0, right = width - 1;
+    while (left < right) {
+      int mid = (left + right) / 2;
+      if (is_white(mid)) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    x_min = left;
+  }
+
+  // 二分查找右边界
+  int x_max = width - 1;
+  if (is_white(width - 1)) {
+    int left = 0, right = width - 1;
+    while (left < right) {
+      int mid = (left + right + 1) / 2;
+      if (is_white(mid)) {
+        right = mid - 1;
+      } else {
+        left = mid;
+      }
+    }
+    x_max = left;
+  }
+  return {x_min, x_max};
+}
+
+}  // namespace algo
@@ -44,37 +44,57 @@
  *    a. Preprocessing:
  *       - preprocess_for_hole_detection() -> preprocess_image_fast()
  *         * Convert to grayscale if needed
- *         * Crop image to remove mostly white borders
- *    b. Thresholding:
- *       - threshold_image() -> apply_partitioned_threshold_parallel()
+ *         * Crop image to remove mostly white borders (video frames track
+ *           the borders from the previous frame, see BorderTracker)
+ *    b. Thresholding + connected components:
+ *       - find_components() -> algo::threshold_components()
  *         * Apply different thresholds to different image partitions
- *         * Uses parallel processing for large images
+ *         * Label 8-connected runs in the same pass, no binary image
+ *         * With parallel_bands > 1, big frames are split into row bands
+ *           that are labelled in parallel and stitched at the seams
  *    c. Hole extraction:
- *       - extract_holes() -> connectedComponentsWithStats()
- *         * Identify connected components
- *         * Filter by minimum area and edge margins
+ *       - extract_holes()
+ *         * Filter components by minimum area and edge margins
  *         * Calculate hole properties (center, diameter, area, etc.)
  *    d. Hole merging:
- *       - merge_holes() -> merge_close_holes()
+ *       - merge_holes() -> cluster_close_holes() (or merge_close_holes())
  *         * Combine nearby holes based on distance threshold
  *    e. Visualization and output:
- *       - For file processing: create_visualizations() and save_results()
+ *       - When an evidence writer is set: create_visualizations() and
+ *         save_results(), which only queue images for ImageWriter
  *       - For video frames: Just output statistics
+ *
+ * 4. Intermediate buffers (thresholds, components, holes, clustering) live in
+ *    a thread_local HoleScratch that keeps its capacity across frames, see
+ *    HoleDetection::get_scratch_stats()
  */
 
-// 是否启用详细日志输出和计时功能的编译期开关
+// 是否启用逐帧的控制台日志（调试用）。输出在处理线程上同步进行，
+// 会在 stdout 的锁上串行化，产线上保持关闭
 #ifndef ENABLE_HOLE_DETECTION_LOGGING
-#define ENABLE_HOLE_DETECTION_LOGGING 1
+#define ENABLE_HOLE_DETECTION_LOGGING 0
+#endif
+
+// 是否把各阶段耗时记录到直方图（get_stage_timings()），开销是每阶段
+// 两次取时钟和几次无锁写入
+#ifndef ENABLE_HOLE_DETECTION_TIMING
+#define ENABLE_HOLE_DETECTION_TIMING 1
 #endif
 
 #include "algo/HoleDetection.hpp"
 //
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <exception>
 #include <filesystem>  //NOLINT
 #include <ios>
 #include <iostream>
+#include <latch>
+#include <mutex>
+#include <numeric>
 #include <ratio>  //NOLINT
+#include <span>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -83,6 +103,12 @@
 // for opencv
 #include <opencv2/opencv.hpp>
 // utils
+#include "FrameView.hpp"
+#include "algo/BorderTracker.hpp"
+#include "algo/ColumnProfile.hpp"
+#include "algo/ParamTable.hpp"
+#include "algo/PointClustering.hpp"
+#include "algo/ThresholdComponents.hpp"
 
 using namespace algo;         // NOLINT
 using namespace cv;           // NOLINT
@@ -114,6 +140,66 @@ namespace fs = std::filesystem;
 #define HOLE_DETECTION_TIMING_ONLY(name)
 #endif
 
+// HoleDetection::stage_timings_ 的阶段下标，与 hole_stage_names() 对应
+enum HoleStage : size_t {
+  kStagePreprocess,
+  kStageBounds,
+  kStageThresholdCC,
+  kStageExtract,
+  kStageMerge,
+  kStageVisualize,
+  kStageSave,
+  kStageTotal,
+};
+
+static std::vector<std::string> hole_stage_names() {
+  return {"preprocess", "bounds", "threshold_cc", "extract",
+          "merge",      "visualize", "save",       "total"};
+}
+
+// 当前线程正在处理的帧所属的统计对象，由 HoleDetection::process() 设置；
+// 从文件加载图像的调试路径不统计
+static thread_local StageTimings* current_stage_timings = nullptr;
+
+#if ENABLE_HOLE_DETECTION_TIMING
+#define HOLE_DETECTION_STAGE(stage) \
+  ScopedStageTimer stage##_timer(current_stage_timings, stage)
+#else
+#define HOLE_DETECTION_STAGE(stage)
+#endif
+
+// 输出的图像信号，顺序与 get_signal_info() 一致
+enum HoleSignal : size_t {
+  kSignalRaw,
+  kSignalPreprocessed,
+  kSignalBinary,
+  kSignalDefectMap,
+  kSignalCount
+};
+
+static constexpr const char* kHoleSignalNames[kSignalCount] = {
+    "raw", "preprocessed", "binary", "defect_map"};
+
+using HoleSignalHandles =
+    std::array<ImageSignalBus::SignalHandle, kSignalCount>;
+
+// 没有经过 initialize() 的场合（文件调试路径、直接调用 process()）按名字查句柄
+static HoleSignalHandles find_hole_signals() {
+  HoleSignalHandles handles;
+  for (size_t i = 0; i < kSignalCount; ++i) {
+    handles[i] = ImageSignalBus::instance().find_signal(kHoleSignalNames[i]);
+  }
+  return handles;
+}
+
+// 处理视频帧时用到的、属于 HoleDetection 实例的运行时对象，都可以为空
+struct DetectionContext {
+  ImageWriter* writer = nullptr;
+  BorderTracker* tracker = nullptr;        // 白边跟踪
+  const algo::BandRunner* bands = nullptr;  // 分带并行标记的执行器
+  HoleSignalHandles signals{};              // 调试信号，无效句柄不发送
+};
+
 constexpr double M_PI{3.1415926535897932384626433832795};
 
 __forceinline static bool is_big_image(const Mat& image) noexcept {
@@ -132,13 +218,9 @@ __forceinline double euclidean_distance(const Point& a,
   return std::sqrt(dx * dx + dy * dy);
 }
 
+// 按帧的实际像素格式取灰度图，Mono8 时是零拷贝视图
 static cv::Mat CapturedFrame2Mat(const CapturedFrame& frame) {
-  // 可选：校验数据大小（根据 CV_8UC3 假设）
-  // assert(frame.data.size() ==
-  //        static_cast<size_t>(frame.width() * frame.height() * 3));
-
-  return cv::Mat(frame.height(), frame.width(), CV_8UC3,
-                 const_cast<uint8_t*>(frame.data.data()));
+  return frame_to_gray8(frame);
 }
 
 static std::vector<std::string> get_image_files(const std::string& dir) {
@@ -158,8 +240,11 @@ static std::vector<std::string> get_image_files(const std::string& dir) {
   return files;
 }
 
+// tracker 非空时从上一帧的边界开始做窗口查找（连续视频帧），
+// sequence 为帧序号，乱序完成的旧帧不会覆盖跟踪状态
 static std::pair<int, int> find_horizontal_content_bounds_gray(
-    const Mat& gray_image, double threshold_ratio = 0.1) noexcept {
+    const Mat& gray_image, BorderTracker* tracker, uint64_t sequence,
+    double threshold_ratio = 0.1) noexcept {
   int height = gray_image.rows;
   int width = gray_image.cols;
   if (!is_big_image(gray_image)) {
@@ -167,80 +252,18 @@ static std::pair<int, int> find_horizontal_content_bounds_gray(
   }
   // 采样行数（For 2600行，sample 325行）
   const int SAMPLE_STEP = height > 1000 ? 8 : 1;
-  const int SAMPLED_HEIGHT = (height + SAMPLE_STEP - 1) / SAMPLE_STEP;
-
-  // 预计算采样行的指针
-  std::vector<const uchar*> row_ptrs;
-  row_ptrs.reserve(SAMPLED_HEIGHT);
-  for (int y = 0; y < height; y += SAMPLE_STEP) {
-    row_ptrs.push_back(gray_image.ptr<uchar>(y));
-  }
 
   // 白色边的阈值
   const uchar WHITE_THRESHOLD = 200;
-  const double threshold_count = SAMPLED_HEIGHT * threshold_ratio;
-
-  // 检查左边是否需要裁剪
-  int x_min = 0;
-  int left_white_count = 0;
-  for (const auto* row : row_ptrs) {
-    if (row[0] > WHITE_THRESHOLD) {
-      ++left_white_count;
-    }
-  }
-
-  if (static_cast<double>(left_white_count) / SAMPLED_HEIGHT >
-      threshold_ratio) {
-    // 二分查左边界
-    int left = 0, right = width - 1;
-    while (left < right) {
-      int mid = (left + right) / 2;
-      int white_count = 0;
-      for (const auto* row : row_ptrs) {
-        if (row[mid] > WHITE_THRESHOLD) {
-          ++white_count;
-        }
-      }
-
-      if (static_cast<double>(white_count) / SAMPLED_HEIGHT > threshold_ratio) {
-        left = mid + 1;
-      } else {
-        right = mid;
-      }
-    }
-    x_min = left;
-  }
-
-  // 检查右边是否需要裁剪
-  int x_max = width - 1;
-  int right_white_count = 0;
-  for (const auto* row : row_ptrs) {
-    if (row[width - 1] > WHITE_THRESHOLD) {
-      ++right_white_count;
-    }
-  }
-
-  if (static_cast<double>(right_white_count) / SAMPLED_HEIGHT >
-      threshold_ratio) {
-    // 二分查找右边界
-    int left = 0, right = width - 1;
-    while (left < right) {
-      int mid = (left + right + 1) / 2;
-      int white_count = 0;
-      for (const auto* row : row_ptrs) {
-        if (row[mid] > WHITE_THRESHOLD) {
-          ++white_count;
-        }
-      }
 
-      if (static_cast<double>(white_count) / SAMPLED_HEIGHT > threshold_ratio) {
-        right = mid - 1;
-      } else {
-        left = mid;
-      }
-    }
-    x_max = left;
-  }
+  // 二分查找（或跟踪）左右边界，探测到的列按 32 列一块做 SIMD 统计
+  thread_local algo::ColumnProfile white_profile;
+  white_profile.reset(gray_image, SAMPLE_STEP, WHITE_THRESHOLD);
+  auto [x_min, x_max] =
+      tracker ? tracker->update(white_profile, threshold_ratio, sequence)
+              : algo::find_content_bounds(white_profile, threshold_ratio);
+  // thread_local 的统计对象不应该一直持有这一帧
+  white_profile.release();
 
   if (x_min == 0 && x_max >= width - 5) {
     return {-1, -1};
@@ -257,7 +280,8 @@ static std::pair<int, int> find_horizontal_content_bounds_gray(
   return {x_min, x_max};
 }
 
-static Mat preprocess_image_fast(const Mat& image) noexcept {
+static Mat preprocess_image_fast(const Mat& image, BorderTracker* tracker,
+                                 uint64_t sequence) noexcept {
   HOLE_DETECTION_TIMING_START(total);
 
   // 直接获取灰度图（如果是彩色才转换）
@@ -272,14 +296,17 @@ static Mat preprocess_image_fast(const Mat& image) noexcept {
 
   // 直接在灰度图上找边界（跳过二值化！）
   HOLE_DETECTION_TIMING_START(bounds);
-  auto [x_min, x_max] = find_horizontal_content_bounds_gray(gray);
+  auto [x_min, x_max] = [&] {
+    HOLE_DETECTION_STAGE(kStageBounds);
+    return find_horizontal_content_bounds_gray(gray, tracker, sequence);
+  }();
   HOLE_DETECTION_TIMING_END(bounds, "    Bounds search: ");
 
   if (x_min == -1 || x_max == -1) {
     HOLE_DETECTION_TIMING_END(total, "    Total preprocessing: ");
     HOLE_DETECTION_LOG("    Total preprocessing: " << total_ms
                                                    << " ms (no crop)" << endl);
-    return image;
+    return gray;
   }
 
   constexpr int margin = 10;
@@ -287,7 +314,7 @@ static Mat preprocess_image_fast(const Mat& image) noexcept {
   x_max = min(gray.cols - 1, x_max + margin);
 
   HOLE_DETECTION_TIMING_START(crop);
-  Mat cropped = image(Range::all(), Range(x_min, x_max + 1));
+  Mat cropped = gray(Range::all(), Range(x_min, x_max + 1));
   HOLE_DETECTION_TIMING_END(crop, "    Cropping:      ");
 
   HOLE_DETECTION_TIMING_END(total, "    Total preprocessing: ");
@@ -298,60 +325,25 @@ static Mat preprocess_image_fast(const Mat& image) noexcept {
   return cropped;
 }
 
-// ==================== PARALLEL THRESHOLDING ====================
-struct ParallelThresholdTask : public cv::ParallelLoopBody {
-  const Mat& src;
-  Mat& dst;
-  int start_col, end_col;
-  int thresh;
-
-  ParallelThresholdTask(const Mat& src_, Mat& dst_, int s, int e, int t)
-      : src(src_), dst(dst_), start_col(s), end_col(e), thresh(t) {}
-
-  void operator()(const cv::Range& rowRange) const override {
-    for (int r = rowRange.start; r < rowRange.end; ++r) {
-      Mat src_row = src.row(r).colRange(start_col, end_col);
-      Mat dst_row = dst.row(r).colRange(start_col, end_col);
-      threshold(src_row, dst_row, thresh, 255, THRESH_BINARY);
-    }
-  }
-};
-
-static Mat apply_partitioned_threshold_parallel(
-    const cv::Mat& image, const PartitionConfig& params) noexcept {
+// ==================== PARTITIONED THRESHOLD ====================
+// 大图按列分为左/中/右三段，各用各的阈值；其余图像整体使用中间阈值
+static void make_column_thresholds(
+    const cv::Mat& image, const PartitionConfig& params,
+    std::vector<algo::ColumnThreshold>& partitions) noexcept {
+  partitions.clear();
   if (!is_big_image(image)) {
-    // 处理整个图像，使用中间阈值（参数中为7.0）
-    Mat binary;
-    cv::threshold(image, binary, params.mid_thresh, 255, cv::THRESH_BINARY);
-    return binary;
+    partitions.push_back({image.cols, params.mid_thresh});
+    return;
   }
 
   int width = image.cols;
-  Mat binary = Mat::zeros(image.size(), CV_8UC1);
-
   int left_end = static_cast<int>(width * params.left_ratio);
   int mid_end =
       static_cast<int>(width * (params.left_ratio + params.mid_ratio));
 
-  int rows = image.rows;
-
-  if (left_end > 0) {
-    cv::parallel_for_(
-        cv::Range(0, rows),
-        ParallelThresholdTask(image, binary, 0, left_end, params.left_thresh));
-  }
-  if (mid_end > left_end) {
-    cv::parallel_for_(cv::Range(0, rows),
-                      ParallelThresholdTask(image, binary, left_end, mid_end,
-                                            params.mid_thresh));
-  }
-  if (width > mid_end) {
-    cv::parallel_for_(cv::Range(0, rows),
-                      ParallelThresholdTask(image, binary, mid_end, width,
-                                            params.right_thresh));
-  }
-
-  return binary;
+  partitions.push_back({left_end, params.left_thresh});
+  partitions.push_back({mid_end, params.mid_thresh});
+  partitions.push_back({width, params.right_thresh});
 }
 // =======================================================
 
@@ -372,6 +364,95 @@ struct HoleInfo {
   int bottom_y;               // 添加下边界Y坐标
 };
 
+// 每个处理线程一份的工作区，逐帧的中间结果都放在这里，容量按见过的
+// 最大帧保留，稳定后处理一帧不再分配堆内存（证据图除外）
+struct HoleScratch {
+  cv::Mat gray;  // 非 Mono8 帧的灰度转换结果，未配置证据输出时使用
+  std::vector<algo::ColumnThreshold> partitions;
+  algo::ComponentScratch component_scratch;
+  std::vector<algo::ComponentStats> components;
+  std::vector<HoleInfo> holes;
+  std::vector<HoleInfo> merged_holes;
+  // 网格聚类
+  std::vector<Point> centers;
+  std::vector<int> labels;
+  algo::GridClusterScratch grid;
+  std::vector<size_t> offsets;
+  std::vector<size_t> members;
+  std::vector<size_t> cursor;
+
+  size_t reserved_bytes() const {
+    auto bytes = [](const auto& v) { return v.capacity() * sizeof(v[0]); };
+    return static_cast<size_t>(gray.dataend - gray.datastart) +
+           bytes(partitions) + component_scratch.reserved_bytes() +
+           bytes(components) + bytes(holes) + bytes(merged_holes) +
+           bytes(centers) + bytes(labels) + grid.reserved_bytes() +
+           bytes(offsets) + bytes(members) + bytes(cursor);
+  }
+};
+
+static thread_local HoleScratch hole_scratch;
+
+// 把一组孔洞合并成一个：面积加权质心、外接框、等效直径
+static HoleInfo merge_hole_group(const std::vector<HoleInfo>& holes,
+                                 std::span<const size_t> group,
+                                 const HoleDetection::Config& config) noexcept {
+  double total_area = 0;
+  double total_cx = 0, total_cy = 0;
+  // 计算边界框
+  int min_x = INT_MAX, min_y = INT_MAX;
+  int max_x = INT_MIN, max_y = INT_MIN;
+
+  for (size_t idx : group) {
+    total_area += holes[idx].area;
+    total_cx += holes[idx].center.x * holes[idx].area;
+    total_cy += holes[idx].center.y * holes[idx].area;
+
+    // 更新边界框
+    min_x = std::min(min_x, holes[idx].center.x - holes[idx].width / 2);
+    min_y = std::min(min_y, holes[idx].center.y - holes[idx].height / 2);
+    max_x = std::max(max_x, holes[idx].center.x + holes[idx].width / 2);
+    max_y = std::max(max_y, holes[idx].center.y + holes[idx].height / 2);
+  }
+  int avg_cx = static_cast<int>(std::round(total_cx / total_area));
+  int avg_cy = static_cast<int>(std::round(total_cy / total_area));
+  double equiv_diam = 2.0 * std::sqrt(total_area / M_PI);
+
+  // 计算合并后的宽度和高度
+  int merged_width = max_x - min_x;
+  int merged_height = max_y - min_y;
+
+  HoleInfo merged_hole;
+  merged_hole.index = 0;  // 由调用方统一编号
+  merged_hole.center = Point(avg_cx, avg_cy);
+  merged_hole.pixel_diameter = equiv_diam;
+  merged_hole.area = static_cast<int>(total_area);
+  merged_hole.width = merged_width;    // 设置合并后的宽度
+  merged_hole.height = merged_height;  // 设置合并后的高度
+  merged_hole.merged = true;
+  merged_hole.merged_count = static_cast<int>(group.size());
+  merged_hole.top_y = min_y;     // 设置上边界Y坐标
+  merged_hole.bottom_y = max_y;  // 设置下边界Y坐标
+
+  // 计算实际尺寸
+  if (config.enable_real_world_calculation) {
+    merged_hole.real_width = merged_width * config.pixel_to_mm_width;
+    merged_hole.real_height = merged_height * config.pixel_to_mm_height;
+    merged_hole.real_area =
+        total_area * config.pixel_to_mm_width * config.pixel_to_mm_height;
+    for (size_t idx : group) {
+      if (holes[idx].real_diameter > 0) {
+        merged_hole.real_diameter =
+            holes[idx].real_diameter * (total_area / holes[idx].area);
+        break;
+      }
+    }
+  }
+  return merged_hole;
+}
+
+// 旧的合并方式：以每个未合并的孔为中心吸收距离内的孔，O(n^2) 且与顺序有关。
+// 保留用于和网格聚类的结果对比（merge_strategy = greedy）
 static std::vector<HoleInfo> merge_close_holes(
     std::vector<HoleInfo>& holes, int distance_threshold,
     const HoleDetection::Config& config) noexcept {
@@ -399,59 +480,7 @@ static std::vector<HoleInfo> merge_close_holes(
     if (close_indices.size() == 1) {
       merged_holes.push_back(holes[close_indices[0]]);
     } else {
-      double total_area = 0;
-      double total_cx = 0, total_cy = 0;
-      // 计算边界框
-      int min_x = INT_MAX, min_y = INT_MAX;
-      int max_x = INT_MIN, max_y = INT_MIN;
-
-      for (size_t idx : close_indices) {
-        total_area += holes[idx].area;
-        total_cx += holes[idx].center.x * holes[idx].area;
-        total_cy += holes[idx].center.y * holes[idx].area;
-
-        // 更新边界框
-        min_x = std::min(min_x, holes[idx].center.x - holes[idx].width / 2);
-        min_y = std::min(min_y, holes[idx].center.y - holes[idx].height / 2);
-        max_x = std::max(max_x, holes[idx].center.x + holes[idx].width / 2);
-        max_y = std::max(max_y, holes[idx].center.y + holes[idx].height / 2);
-      }
-      int avg_cx = static_cast<int>(std::round(total_cx / total_area));
-      int avg_cy = static_cast<int>(std::round(total_cy / total_area));
-      double equiv_diam = 2.0 * std::sqrt(total_area / M_PI);
-
-      // 计算合并后的宽度和高度
-      int merged_width = max_x - min_x;
-      int merged_height = max_y - min_y;
-
-      HoleInfo merged_hole;
-      merged_hole.index = static_cast<int>(merged_holes.size()) + 1;
-      merged_hole.center = Point(avg_cx, avg_cy);
-      merged_hole.pixel_diameter = equiv_diam;
-      merged_hole.area = static_cast<int>(total_area);
-      merged_hole.width = merged_width;    // 设置合并后的宽度
-      merged_hole.height = merged_height;  // 设置合并后的高度
-      merged_hole.merged = true;
-      merged_hole.merged_count = static_cast<int>(close_indices.size());
-      merged_hole.top_y = min_y;     // 设置上边界Y坐标
-      merged_hole.bottom_y = max_y;  // 设置下边界Y坐标
-
-      // 计算实际尺寸
-      if (config.enable_real_world_calculation) {
-        merged_hole.real_width = merged_width * config.pixel_to_mm_width;
-        merged_hole.real_height = merged_height * config.pixel_to_mm_height;
-        merged_hole.real_area =
-            total_area * config.pixel_to_mm_width * config.pixel_to_mm_height;
-        for (size_t idx : close_indices) {
-          if (holes[idx].real_diameter > 0) {
-            merged_hole.real_diameter =
-                holes[idx].real_diameter * (total_area / holes[idx].area);
-            break;
-          }
-        }
-      }
-
-      merged_holes.push_back(merged_hole);
+      merged_holes.push_back(merge_hole_group(holes, close_indices, config));
     }
   }
 
@@ -461,18 +490,115 @@ static std::vector<HoleInfo> merge_close_holes(
   return merged_holes;
 }
 
+// 网格 + 并查集聚类：距离不超过阈值的孔传递地合并，接近线性时间，
+// 输出按每簇最小的孔下标排序，结果确定
+// 结果写入 scratch.merged_holes，中间缓冲区也取自 scratch
+static void cluster_close_holes(const std::vector<HoleInfo>& holes,
+                                int distance_threshold,
+                                const HoleDetection::Config& config,
+                                HoleScratch& scratch) noexcept {
+  std::vector<HoleInfo>& merged_holes = scratch.merged_holes;
+  if (holes.size() <= 1) {
+    merged_holes.assign(holes.begin(), holes.end());
+    return;
+  }
+
+  std::vector<Point>& centers = scratch.centers;
+  centers.clear();
+  for (const auto& hole : holes) {
+    centers.push_back(hole.center);
+  }
+  std::vector<int>& labels = scratch.labels;
+  cluster_points_grid(centers, distance_threshold, scratch.grid, labels);
+  const int cluster_count =
+      *std::max_element(labels.begin(), labels.end()) + 1;
+
+  // 按簇分组（计数排序），组内保持孔的原始顺序
+  std::vector<size_t>& offsets = scratch.offsets;
+  offsets.assign(cluster_count + 1, 0);
+  for (int label : labels) {
+    ++offsets[label + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<size_t>& members = scratch.members;
+  members.resize(holes.size());
+  std::vector<size_t>& cursor = scratch.cursor;
+  cursor.assign(offsets.begin(), offsets.end() - 1);
+  for (size_t i = 0; i < holes.size(); ++i) {
+    members[cursor[labels[i]]++] = i;
+  }
+
+  merged_holes.clear();
+  for (int c = 0; c < cluster_count; ++c) {
+    const std::span<const size_t> group(members.data() + offsets[c],
+                                        offsets[c + 1] - offsets[c]);
+    if (group.size() == 1) {
+      merged_holes.push_back(holes[group[0]]);
+    } else {
+      merged_holes.push_back(merge_hole_group(holes, group, config));
+    }
+    merged_holes.back().index = c + 1;
+  }
+}
+
 // Preprocess image for hole detection
-static Mat preprocess_for_hole_detection(const Mat& processed_image) noexcept {
+static Mat preprocess_for_hole_detection(const Mat& processed_image,
+                                         BorderTracker* tracker,
+                                         uint64_t sequence) noexcept {
+  HOLE_DETECTION_STAGE(kStagePreprocess);
   HOLE_DETECTION_TIMING_START(prep);
-  Mat image = preprocess_image_fast(processed_image);
+  Mat image = preprocess_image_fast(processed_image, tracker, sequence);
   HOLE_DETECTION_TIMING_END(prep, "    Preprocessing:    ");
   return image;
 }
 
-// Apply threshold to image
-static Mat threshold_image(const Mat& image, bool is_small_image,
-                           const HoleDetection::Config& config,
-                           const PartitionConfig& parsed_params) noexcept {
+// Threshold and label connected components in one pass (no binary image)
+// 调用线程和 lane 的 worker 按下标领取行带，直到全部领完。调用线程只等待
+// 已经被领取的行带，lane 与处理线程共用 worker（预算用完时）也不会互相等待。
+// 某一带抛出的异常在所有行带结束后才重新抛出，不会留下引用栈上数据的任务
+static void run_bands(ProcessingExecutor::Lane& lane, size_t count,
+                      const std::function<void(size_t)>& task) {
+  struct Shared {
+    explicit Shared(size_t n) : count(n), done(static_cast<std::ptrdiff_t>(n)) {}
+    const size_t count;
+    std::atomic<size_t> next{0};
+    std::latch done;
+    std::mutex mutex;
+    std::exception_ptr error;
+  };
+  // 晚到的 worker 领不到下标，不会再调用 task
+  const auto claim = [](Shared& s, const std::function<void(size_t)>& run) {
+    for (size_t i = s.next++; i < s.count; i = s.next++) {
+      try {
+        run(i);
+      } catch (...) {
+        std::lock_guard lock(s.mutex);
+        if (!s.error) {
+          s.error = std::current_exception();
+        }
+      }
+      s.done.count_down();
+    }
+  };
+
+  auto shared = std::make_shared<Shared>(count);
+  for (size_t i = 1; i < count; ++i) {
+    lane.detach([shared, &task, claim] { claim(*shared, task); });
+  }
+  claim(*shared, task);
+  shared->done.wait();
+  if (shared->error) {
+    std::rethrow_exception(shared->error);
+  }
+}
+
+// band_runner 非空且 bands > 1 时大图按行分带并行标记，分带失败时退回
+// 单线程标记；结果写入 scratch.components
+static void find_components(const Mat& image, bool is_small_image,
+                            const PartitionConfig& parsed_params, int bands,
+                            const algo::BandRunner* band_runner,
+                            HoleScratch& scratch) noexcept {
+  HOLE_DETECTION_STAGE(kStageThresholdCC);
   // --- Adjust parameters for small images (like Python) ---
   PartitionConfig params = parsed_params;  // 使用解析后的参数
   if (is_small_image) {
@@ -481,52 +607,77 @@ static Mat threshold_image(const Mat& image, bool is_small_image,
     params.right_thresh = params.mid_thresh;
   }
 
-  // --- Partitioned Threshold ---
-  HOLE_DETECTION_TIMING_START(thresh);
-  Mat binary = apply_partitioned_threshold_parallel(image, params);
-  HOLE_DETECTION_TIMING_END(thresh, "    Thresholding:     ");
-  return binary;
+  // --- Partitioned Threshold + Connected Components ---
+  HOLE_DETECTION_TIMING_START(cc);
+  make_column_thresholds(image, params, scratch.partitions);
+  bool labelled = false;
+  if (band_runner && bands > 1 && is_big_image(image)) {
+    try {
+      algo::threshold_components_banded(image, scratch.partitions, bands,
+                                        *band_runner, scratch.component_scratch,
+                                        scratch.components);
+      labelled = true;
+    } catch (const std::exception& e) {
+      // run_bands 在所有行带结束后才重新抛出，这里可以安全地改为单线程
+      // 重新标记整幅图
+      HOLE_DETECTION_LOG("Banded labelling failed, using single pass: "
+                         << e.what() << endl);
+    }
+  }
+  if (!labelled) {
+    algo::threshold_components(image, scratch.partitions,
+                               scratch.component_scratch, scratch.components);
+  }
+  HOLE_DETECTION_TIMING_END(cc, "    Threshold+CC:     ");
 }
 
-// Extract hole information from binary image
-static std::vector<HoleInfo> extract_holes(
-    const Mat& image, const Mat& binary, bool is_small_image,
-    bool skip_edge_detection, const HoleDetection::Config& config) noexcept {
-  // --- Connected Components ---
-  HOLE_DETECTION_TIMING_START(cc);
-  Mat labels, stats, centroids;
-  int num_labels =
-      connectedComponentsWithStats(binary, labels, stats, centroids, 8, CV_32S);
-  HOLE_DETECTION_TIMING_END(cc, "    ConnectedComps:   ");
+// 调试用的二值图，与 threshold_components() 的分区规则一致，
+// 只在 "binary" 信号有订阅者时生成
+static Mat make_binary_image(
+    const Mat& image, std::span<const algo::ColumnThreshold> partitions) {
+  Mat binary(image.rows, image.cols, CV_8UC1, Scalar(0));
+  int begin = 0;
+  for (size_t p = 0; p < partitions.size() && begin < image.cols; ++p) {
+    const int end = p + 1 == partitions.size()
+                        ? image.cols
+                        : std::clamp(partitions[p].end_col, begin, image.cols);
+    if (end > begin) {
+      Mat dst = binary.colRange(begin, end);
+      threshold(image.colRange(begin, end), dst, partitions[p].thresh, 255,
+                THRESH_BINARY);
+    }
+    begin = end;
+  }
+  return binary;
+}
 
+// Extract hole information from connected components
+// 结果写入 hole_data（先清空，保留容量）
+static void extract_holes(const Mat& image,
+                          const std::vector<algo::ComponentStats>& components,
+                          bool is_small_image, bool skip_edge_detection,
+                          const HoleDetection::Config& config,
+                          std::vector<HoleInfo>& hole_data) noexcept {
+  HOLE_DETECTION_STAGE(kStageExtract);
   // --- Adjust parameters for small images (like Python) ---
   int current_min_area = is_small_image ? 1 : config.min_defect_area;
 
   // --- Collect holes ---
-  std::vector<HoleInfo> hole_data;
+  hole_data.clear();
   int edge_count = 0;
   int height = image.rows;
   int width = image.cols;
 
-  if (num_labels > 1) {
-    hole_data.reserve(num_labels - 1);
-  }
-
-  const int* stats_ptr = stats.ptr<int>(0);
-  const double* centroids_ptr = centroids.ptr<double>(0);
-  int stats_cols = stats.cols;
-  int centroids_cols = centroids.cols;
-
-  for (int i = 1; i < num_labels; ++i) {
-    int area = stats_ptr[i * stats_cols + CC_STAT_AREA];
+  for (const auto& component : components) {
+    int area = component.area;
     if (area < current_min_area) {
       continue;
     }
 
-    int x = stats_ptr[i * stats_cols + CC_STAT_LEFT];
-    int y = stats_ptr[i * stats_cols + CC_STAT_TOP];
-    int w = stats_ptr[i * stats_cols + CC_STAT_WIDTH];
-    int h = stats_ptr[i * stats_cols + CC_STAT_HEIGHT];
+    int x = component.left;
+    int y = component.top;
+    int w = component.width;
+    int h = component.height;
 
     // --- Edge filtering: only for large images ---
     bool near_edge = false;
@@ -544,11 +695,9 @@ static std::vector<HoleInfo> extract_holes(
       continue;
     }
 
-    // Get centroid (x, y) - note: centroids[i][0] = x, [1] = y
-    double cx_d = centroids_ptr[i * centroids_cols + 0];
-    double cy_d = centroids_ptr[i * centroids_cols + 1];
-    int cx = static_cast<int>(cx_d + 0.5);  // Round properly
-    int cy = static_cast<int>(cy_d + 0.5);
+    // Get centroid (x, y)
+    int cx = static_cast<int>(component.cx + 0.5);  // Round properly
+    int cy = static_cast<int>(component.cy + 0.5);
 
     double equiv_diam = 2.0 * std::sqrt(static_cast<double>(area) / M_PI);
     HoleInfo hole;
@@ -572,38 +721,39 @@ static std::vector<HoleInfo> extract_holes(
     }
     hole_data.emplace_back(hole);
   }
-
-  return hole_data;
 }
 
-// Merge nearby holes
-static std::vector<HoleInfo> merge_holes(
-    std::vector<HoleInfo>& hole_data, bool is_small_image,
-    const HoleDetection::Config& config) noexcept {
+// Merge nearby holes，结果写入 scratch.merged_holes
+static void merge_holes(std::vector<HoleInfo>& hole_data, bool is_small_image,
+                        const HoleDetection::Config& config,
+                        HoleScratch& scratch) noexcept {
+  HOLE_DETECTION_STAGE(kStageMerge);
   int current_merge_distance =
       is_small_image ? 5 : config.merge_distance_threshold;
 
   // --- Merge close holes ---
   HOLE_DETECTION_TIMING_START(merge);
-  auto merged_hole_data =
-      merge_close_holes(hole_data, current_merge_distance, config);
+  if (config.merge_strategy == "greedy") {
+    scratch.merged_holes =
+        merge_close_holes(hole_data, current_merge_distance, config);
+  } else {
+    cluster_close_holes(hole_data, current_merge_distance, config, scratch);
+  }
   HOLE_DETECTION_TIMING_END(merge, "    Merging:          ");
-
-  return merged_hole_data;
 }
 
 // Create visualization images
 static std::pair<Mat, Mat> create_visualizations(
     const Mat& image, std::vector<HoleInfo>& merged_hole_data,
     const HoleDetection::Config& config) noexcept {
+  HOLE_DETECTION_STAGE(kStageVisualize);
   // --- Visualization (with adaptive radius for small images) ---
   HOLE_DETECTION_TIMING_START(vis);
-  Mat result_image;
-  cvtColor(image, result_image, COLOR_GRAY2BGR);
-
-  // 创建两个用于可视化的图像副本
-  Mat contour_visualization = result_image.clone();  // 显示质心和轮廓
-  Mat bbox_visualization = result_image.clone();     // 显示边界框
+  // 两张标注图各自需要一份数据（异步保存时会被不同线程读取），
+  // 灰度转彩色只做一次，第二份直接拷贝
+  Mat contour_visualization;  // 显示质心和轮廓
+  cvtColor(image, contour_visualization, COLOR_GRAY2BGR);
+  Mat bbox_visualization = contour_visualization.clone();  // 显示边界框
 
   int img_min_dim = std::min(image.rows, image.cols);
   double max_radius_ratio = 0.1;  // Default for very小 images
@@ -789,74 +939,99 @@ static std::pair<Mat, Mat> create_visualizations(
   return std::make_pair(contour_visualization, bbox_visualization);
 }
 
-// Save result images
+// Queue result images for the async writer
 static void save_results(const Mat& result_image,
                          const Mat& contour_visualization,
                          const Mat& bbox_visualization,
-                         const std::string& image_path,
-                         const std::string& output_dir) noexcept {
+                         const std::string& base_name,
+                         const std::string& output_dir,
+                         ImageWriter& writer) noexcept {
+  HOLE_DETECTION_STAGE(kStageSave);
   // --- Save results ---
-  fs::path img_path(image_path);
-  std::string base_name = img_path.stem().string();
-  std::string original_result_path =
-      output_dir + "/processed_" + base_name + ".jpg";
-  std::string contour_result_path =
-      output_dir + "/contours_" + base_name + ".jpg";
-  std::string bbox_result_path = output_dir + "/bbox_" + base_name + ".jpg";
+  const std::string original_result_path =
+      output_dir + "/processed_" + base_name;
+  const std::string contour_result_path = output_dir + "/contours_" + base_name;
+  const std::string bbox_result_path = output_dir + "/bbox_" + base_name;
 
+  // 只是入队，编码和写盘在 writer 的线程上完成
   HOLE_DETECTION_TIMING_START(save);
-  // 保存原始处理图像（无标注）
-  imwrite(original_result_path, result_image);
+  // 保存原始处理图像（无标注，灰度）
+  writer.submit(original_result_path, result_image);
   // 保存显示质心和轮廓的图像
-  imwrite(contour_result_path, contour_visualization);
+  writer.submit(contour_result_path, contour_visualization);
   // 保存显示边界框的图像
-  imwrite(bbox_result_path, bbox_visualization);
-  HOLE_DETECTION_TIMING_END(save, "    Image saving:     ");
+  writer.submit(bbox_result_path, bbox_visualization);
+  HOLE_DETECTION_TIMING_END(save, "    Image queueing:   ");
 
-  HOLE_DETECTION_LOG("  Results saved to: " << endl);
+  HOLE_DETECTION_LOG("  Results queued to: " << endl);
   HOLE_DETECTION_LOG("    Original:   " << original_result_path << endl);
   HOLE_DETECTION_LOG("    Contours:   " << contour_result_path << endl);
   HOLE_DETECTION_LOG("    Bounding boxes: " << bbox_result_path << endl);
 }
 
 // load from local directory for debug
+// image_path 为空表示视频帧，base_name 用于证据图的文件名，sequence 为帧序号；
+// writer 为空或 output_dir 为空时不保存；tracker 为空时每帧完整查找白边
 static void process_single_image_impl(
     const Mat& processed_image, const std::string& image_path,
-    const std::string& output_dir, const HoleDetection::Config& config,
-    const PartitionConfig& parsed_params) noexcept {
+    const std::string& base_name, uint64_t sequence,
+    const std::string& output_dir,
+    const HoleDetection::Config& config, const PartitionConfig& parsed_params,
+    const DetectionContext& context) noexcept {
+  ImageWriter* writer = context.writer;
+  HOLE_DETECTION_STAGE(kStageTotal);
   HOLE_DETECTION_TIMING_START(total);
 
   // --- Preprocessing ---
-  Mat image = preprocess_for_hole_detection(processed_image);
+  Mat image =
+      preprocess_for_hole_detection(processed_image, context.tracker, sequence);
+  // 调试信号没有订阅者时既不拷贝也不生成
+  ImageSignalBus& bus = ImageSignalBus::instance();
+  bus.emit(context.signals[kSignalPreprocessed], image);
 
   // --- Check image size ---
   bool is_small_image = (image.rows <= 100 && image.cols <= 100);
   bool skip_edge_detection = (image.rows < 1000 || image.cols < 1000);
 
-  // --- Threshold ---
-  Mat binary = threshold_image(image, is_small_image, config, parsed_params);
+  // --- Threshold + connected components ---
+  HoleScratch& scratch = hole_scratch;
+  find_components(image, is_small_image, parsed_params,
+                  std::clamp(config.parallel_bands, 1, config::kMaxParallelBands),
+                  context.bands, scratch);
+  bus.emit_if_subscribed(context.signals[kSignalBinary], [&] {
+    return make_binary_image(image, scratch.partitions);
+  });
 
   // --- Extract holes ---
-  auto hole_data =
-      extract_holes(image, binary, is_small_image, skip_edge_detection, config);
+  extract_holes(image, scratch.components, is_small_image, skip_edge_detection,
+                config, scratch.holes);
 
   // --- Merge holes ---
-  auto merged_hole_data = merge_holes(hole_data, is_small_image, config);
+  merge_holes(scratch.holes, is_small_image, config, scratch);
+  std::vector<HoleInfo>& merged_hole_data = scratch.merged_holes;
 
-  // 如果是视频帧处理，则不需要保存结果图像
-  if (!image_path.empty() && !output_dir.empty()) {
+  // 不需要保存时连标注图也不画
+  if (writer && !output_dir.empty() &&
+      writer->should_save(!merged_hole_data.empty())) {
     // --- Create visualizations ---
     auto [contour_visualization, bbox_visualization] =
         create_visualizations(image, merged_hole_data, config);
 
-    // Create base result image
-    Mat result_image;
-    cvtColor(image, result_image, COLOR_GRAY2BGR);
-
     // --- Save results ---
-    save_results(result_image, contour_visualization, bbox_visualization,
-                 image_path, output_dir);
+    save_results(image, contour_visualization, bbox_visualization, base_name,
+                 output_dir, *writer);
+    // 标注图交给 writer 后不再修改，直接共享
+    if (bus.has_subscribers(context.signals[kSignalDefectMap])) {
+      bus.emit(context.signals[kSignalDefectMap],
+               std::make_shared<const Mat>(contour_visualization));
+    }
+  } else {
+    bus.emit_if_subscribed(context.signals[kSignalDefectMap], [&] {
+      return create_visualizations(image, merged_hole_data, config).first;
+    });
+  }
 
+  if (!image_path.empty()) {
     // --- Timing & output ---
     HOLE_DETECTION_TIMING_END(total, "  Total time:         ");
 
@@ -877,8 +1052,8 @@ static void process_single_image_impl(
 // 从文件路径加载图像并处理的接口
 static void process_single_image(
     const std::string& image_path, const std::string& output_dir,
-    const HoleDetection::Config& config,
-    const PartitionConfig& parsed_params) noexcept {
+    const HoleDetection::Config& config, const PartitionConfig& parsed_params,
+    ImageWriter& writer) noexcept {
   // --- Load image ---
   HOLE_DETECTION_TIMING_START(load);
   Mat image = imread(image_path, IMREAD_GRAYSCALE);
@@ -890,99 +1065,156 @@ static void process_single_image(
   }
 
   // 调用公共实现函数
-  process_single_image_impl(image, image_path, output_dir, config,
-                            parsed_params);
+  process_single_image_impl(image, image_path,
+                            fs::path(image_path).stem().string(), 0,
+                            output_dir, config, parsed_params,
+                            DetectionContext{&writer, nullptr, nullptr,
+                                             find_hole_signals()});
 }
 
 // 从Mat对象处理图像的接口（用于视频帧处理）
-static void process_single_image(
-    const Mat& frame, const HoleDetection::Config& config,
-    const PartitionConfig& parsed_params) noexcept {
-  // 对于视频帧，我们不需要文件路径和输出目录
-  std::string dummy_path = "";
-  std::string dummy_output_dir = "";
-  process_single_image_impl(frame, dummy_path, dummy_output_dir, config,
-                            parsed_params);
+// 配置了证据输出时，证据图以 frame_<序号> 命名
+static void process_single_image(const Mat& frame, uint64_t sequence,
+                                 const HoleDetection::Config& config,
+                                 const PartitionConfig& parsed_params,
+                                 const std::string& output_dir,
+                                 const DetectionContext& context) noexcept {
+  std::string base_name;
+  if (context.writer && !output_dir.empty()) {
+    base_name = "frame_" + std::to_string(sequence);
+  }
+  process_single_image_impl(frame, "", base_name, sequence, output_dir,
+                            config, parsed_params, context);
 }
 
-// 新增：从CapturedFrame处理图像的接口，这是process()函数实际调用的版本
-static void process_single_image(
-    const CapturedFrame& frame, const HoleDetection::Config& config,
-    const PartitionConfig& parsed_params) noexcept {
-  // 转换为Mat并调用通用实现
-  std::string dummy_path = "";
-  std::string dummy_output_dir = "";
-  Mat image = CapturedFrame2Mat(frame);
-  process_single_image_impl(image, dummy_path, dummy_output_dir, config,
-                            parsed_params);
+// "left_ratio,mid_ratio,right_ratio,left_thresh,mid_thresh,right_thresh"，
+// 逗号或空白分隔，必须正好 6 项
+static bool parse_partition_string(const std::string& text,
+                                   PartitionConfig& out) {
+  std::string normalized = text;
+  std::replace(normalized.begin(), normalized.end(), ',', ' ');
+  std::istringstream ss(normalized);
+  PartitionConfig parsed;
+  if (!(ss >> parsed.left_ratio >> parsed.mid_ratio >> parsed.right_ratio >>
+        parsed.left_thresh >> parsed.mid_thresh >> parsed.right_thresh)) {
+    return false;
+  }
+  std::string extra;
+  if (ss >> extra) {
+    return false;
+  }
+  const auto valid_ratio = [](double r) { return r >= 0.0 && r <= 1.0; };
+  const auto valid_thresh = [](int t) { return t >= 0 && t <= 255; };
+  if (!valid_ratio(parsed.left_ratio) || !valid_ratio(parsed.mid_ratio) ||
+      !valid_ratio(parsed.right_ratio) || !valid_thresh(parsed.left_thresh) ||
+      !valid_thresh(parsed.mid_thresh) || !valid_thresh(parsed.right_thresh)) {
+    return false;
+  }
+  out = parsed;
+  return true;
 }
 
-void HoleDetection::parse_partition_params() {
-  std::stringstream ss(config_.partition_params);
-  ss >> parsed_params_.left_ratio >> parsed_params_.mid_ratio >>
-      parsed_params_.right_ratio >> parsed_params_.left_thresh >>
-      parsed_params_.mid_thresh >> parsed_params_.right_thresh;
+// 参数表：get_parameter_info()、configure() 的解析校验和默认配置都由它生成
+static const ParamTable<HoleDetection::Config>& hole_param_table() {
+  using Config = HoleDetection::Config;
+  static const ParamTable<Config> table = [] {
+    ParamTable<Config> t;
+    t.add("pixel_per_mm", &Config::pixel_per_mm, "像素/毫米转换因子", 50.0f,
+          0.0f);
+    t.add("enable_real_world_calculation",
+          &Config::enable_real_world_calculation, "是否启用真实尺寸计算",
+          true);
+    t.add("min_defect_area", &Config::min_defect_area, "最小缺陷面积（像素）",
+          1, 0);
+    t.add("edge_margin", &Config::edge_margin, "边缘过滤边距（像素）", 10, 0);
+    t.add("merge_distance_threshold", &Config::merge_distance_threshold,
+          "孔洞合并距离阈值（像素）", 20, 0);
+    t.add("pixel_to_mm_width", &Config::pixel_to_mm_width,
+          "水平方向像素/毫米", 0.05586f, 0.0f);
+    t.add("pixel_to_mm_height", &Config::pixel_to_mm_height,
+          "垂直方向像素/毫米", 0.061f, 0.0f);
+    t.add<std::string>(
+        "partition_params", &Config::partition_params,
+        "分区配置（left_ratio,mid_ratio,right_ratio,left_thresh,mid_thresh,"
+        "right_thresh）",
+        "0.3,0.4,0.3,20,23,20", [](const std::string& value) {
+          PartitionConfig parsed;
+          return parse_partition_string(value, parsed);
+        });
+    t.add<std::string>(
+        "merge_strategy", &Config::merge_strategy,
+        "孔洞合并方式（grid: 网格聚类, greedy: 旧的逐对合并）", "grid",
+        [](const std::string& value) {
+          return value == "grid" || value == "greedy";
+        });
+    t.add("parallel_bands", &Config::parallel_bands,
+          "大图按行分带并行标记的带数（1 表示不分带）", 1, 1,
+          config::kMaxParallelBands);
+    return t;
+  }();
+  return table;
 }
 
-HoleDetection::HoleDetection() {
-  config_.pixel_to_mm_height = 0.061;  // 修正默认值
-  config_.partition_params = "0.3,0.4,0.3,20,23,20";
-  parse_partition_params();  // 初始化时解析
-
-  // 初始化配置映射表
-  configMap_ = {
-      {"pixel_per_mm",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.pixel_per_mm = std::stof(value);
-       }},
-      {"enable_real_world_calculation",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.enable_real_world_calculation = std::stoi(value) != 0;
-       }},
-      {"min_defect_area",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.min_defect_area = std::stoi(value);
-       }},
-      {"edge_margin",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.edge_margin = std::stoi(value);
-       }},
-      {"merge_distance_threshold",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.merge_distance_threshold = std::stoi(value);
-       }},
-      {"pixel_to_mm_width",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.pixel_to_mm_width = std::stof(value);
-       }},
-      {"pixel_to_mm_height",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.pixel_to_mm_height = std::stof(value);
-       }},
-      {"partition_params",
-       [this](const std::string& value) {
-         std::unique_lock lock(config_mutex_);
-         config_.partition_params = value;
-         parse_partition_params();
-       }},
-  };
+// 无法解析时保留上一次的结果（例如从 ini 读入的非法配置）
+void HoleDetection::parse_partition_params(Settings& settings) {
+  parse_partition_string(settings.config.partition_params,
+                         settings.parsed_params);
 }
 
-HoleDetection::HoleDetection(const Config& cfg) : config_(cfg) {
-  parse_partition_params();  // 初始化时解析
+HoleDetection::HoleDetection() : stage_timings_(hole_stage_names()) {
+  Settings settings;
+  hole_param_table().apply_defaults(settings.config);
+  parse_partition_params(settings);  // 初始化时解析
+  settings_.store(std::move(settings));
+}
+
+HoleDetection::HoleDetection(const Config& cfg)
+    : stage_timings_(hole_stage_names()) {
+  Settings settings;
+  settings.config = cfg;
+  parse_partition_params(settings);  // 初始化时解析
+  settings_.store(std::move(settings));
+}
+
+void HoleDetection::set_evidence_writer(std::shared_ptr<ImageWriter> writer,
+                                        std::string output_dir) {
+  if (writer && !output_dir.empty()) {
+    std::error_code ec;
+    fs::create_directories(output_dir, ec);
+  }
+  settings_.update([&](Settings& s) {
+    s.evidence_writer = std::move(writer);
+    s.evidence_dir = std::move(output_dir);
+  });
+}
+
+void HoleDetection::reset_border_tracking() { border_tracker_.reset(); }
+
+std::shared_ptr<ProcessingExecutor::Lane> HoleDetection::acquire_band_lane(
+    size_t workers) {
+  std::lock_guard lock(band_lane_mutex_);
+  // 带数改变时换一条新 lane，旧 lane 由还在使用它的帧持有到处理结束
+  if (!band_lane_ || band_workers_ != workers) {
+    band_lane_.reset();  // 先归还旧 lane 的预算
+    try {
+      band_lane_ = ProcessingExecutor::instance().acquire_lane(
+          WorkerBudget{workers, {}});
+    } catch (const std::exception& e) {
+      // 没有可用的 worker 时退回单线程标记
+      HOLE_DETECTION_LOG("parallel_bands disabled: " << e.what() << endl);
+    }
+    band_workers_ = workers;
+  }
+  return band_lane_;
 }
 
 void HoleDetection::update_config(const Config& new_cfg) {
-  std::unique_lock lock(config_mutex_);
-  config_ = new_cfg;
-  parse_partition_params();  // 热更新时重新解析
+  // 与 configure() 使用同一张参数表校验，非法时不发布
+  hole_param_table().validate(new_cfg);
+  settings_.update([&](Settings& s) {
+    s.config = new_cfg;
+    parse_partition_params(s);  // 热更新时重新解析
+  });
 }
 
 // TODO(cmx) 在此处发送特征数据
@@ -1008,20 +1240,24 @@ void HoleDetection::update_config(const Config& new_cfg) {
   ImageSignalBus::instance().emit("hole_debug", debug_img);
 */
 void HoleDetection::process(const CapturedFrame& frame) {
-  if (frame.data.empty()) {
-    cout << "Image is empty" << "with function" << __func__ << "in file"
-         << __FILE__ << ",at line" << __LINE__ << std::endl;
-    return;
-  }
+  const CapturedFrame* frames[] = {&frame};
+  process_frames(frames);
+}
 
-  // 获取配置的本地副本以保证线程安全
-  Config local_config;
-  PartitionConfig local_parsed_params;
-  {
-    std::shared_lock lock(config_mutex_);
-    local_config = config_;
-    local_parsed_params = parsed_params_;  // 使用解析后的结构体
-  }
+void HoleDetection::process_batch(
+    std::span<const CapturedFrame* const> frames) {
+  process_frames(frames);
+}
+
+// 配置快照、分带线程池和执行器在整批帧之间只准备一次
+void HoleDetection::process_frames(
+    std::span<const CapturedFrame* const> frames) {
+  // 整批帧使用同一份配置快照，热更新只影响之后的批次
+  const auto settings = settings_.load();
+  const Config& local_config = settings->config;
+  const PartitionConfig& local_parsed_params = settings->parsed_params;
+  ImageWriter* writer = settings->evidence_writer.get();
+  const std::string& evidence_dir = settings->evidence_dir;
 
   double pixel_per_mm = local_config.enable_real_world_calculation
                             ? local_config.pixel_per_mm
@@ -1032,46 +1268,122 @@ void HoleDetection::process(const CapturedFrame& frame) {
                        << " pixels/mm" << endl);
   }
 
-  HOLE_DETECTION_TIMING_START(total);
-  // 直接处理CapturedFrame，不再需要保存结果到文件
-  process_single_image(CapturedFrame2Mat(frame), local_config,
-                       local_parsed_params);
+  // 分带并行：本线程和 band_lane_ 的 worker 一起处理各个行带
+  const int bands =
+      std::clamp(local_config.parallel_bands, 1, config::kMaxParallelBands);
+  std::shared_ptr<ProcessingExecutor::Lane> band_lane;
+  if (bands > 1) {
+    band_lane = acquire_band_lane(static_cast<size_t>(bands - 1));
+  }
+  const algo::BandRunner band_runner =
+      [&band_lane](size_t count, const std::function<void(size_t)>& task) {
+        run_bands(*band_lane, count, task);
+      };
+
+  DetectionContext context;
+  context.writer = writer;
+  context.tracker = &border_tracker_;
+  context.bands = band_lane ? &band_runner : nullptr;
+  // 句柄在 initialize() 时已经解析好，每批只取一次
+  if (signal_handle(kSignalRaw).valid()) {
+    for (size_t i = 0; i < kSignalCount; ++i) {
+      context.signals[i] = signal_handle(i);
+    }
+  } else {
+    context.signals = find_hole_signals();
+  }
 
-  HOLE_DETECTION_TIMING_END(total, "Total time: ");
+  // 非 Mono8 格式的灰度转换结果复用本线程工作区的缓冲区；
+  // 证据图会异步引用灰度图，配置了 writer 时每帧单独分配
+  HoleScratch& scratch = hole_scratch;
+
+  current_stage_timings = &stage_timings_;
+  for (const CapturedFrame* frame : frames) {
+    if (frame->data.empty()) {
+      cout << "Image is empty" << "with function" << __func__ << "in file"
+           << __FILE__ << ",at line" << __LINE__ << std::endl;
+      continue;
+    }
+
+    HOLE_DETECTION_TIMING_START(total);
+    // 直接处理CapturedFrame，不再需要保存结果到文件
+    const size_t reserved_before = scratch.reserved_bytes();
+    const uchar* gray_before = scratch.gray.datastart;
+    Mat image = writer ? CapturedFrame2Mat(*frame)
+                       : frame_to_gray8(*frame, scratch.gray);
+    if (image.empty()) {
+      HOLE_DETECTION_LOG("Unsupported pixel format: "
+                         << pixel_format_name(frame->pixel_format) << endl);
+      continue;
+    }
+    emit_image(context.signals[kSignalRaw], image);
+    process_single_image(image, frame->sequence, local_config,
+                         local_parsed_params, evidence_dir, context);
+    HOLE_DETECTION_TIMING_END(total, "Total time: ");
+
+    // 工作区有缓冲区扩容或重新分配就算一次增长，稳定后应当不再增加
+    const size_t reserved_after = scratch.reserved_bytes();
+    scratch_frames_.fetch_add(1, std::memory_order_relaxed);
+    if (reserved_after != reserved_before ||
+        scratch.gray.datastart != gray_before) {
+      scratch_growths_.fetch_add(1, std::memory_order_relaxed);
+    }
+    size_t peak = scratch_peak_bytes_.load(std::memory_order_relaxed);
+    while (reserved_after > peak &&
+           !scratch_peak_bytes_.compare_exchange_weak(
+               peak, reserved_after, std::memory_order_relaxed)) {
+    }
+  }
+  current_stage_timings = nullptr;
 }
 
-std::vector<AlgoParamInfo> HoleDetection::get_parameter_info() const {
-  // 获取配置的本地副本以保证线程安全
-  Config local_config;
-  {
-    std::shared_lock lock(config_mutex_);
-    local_config = config_;  // 返回原始字符串（用于 UI 显示和保存）
+void HoleDetection::configure(const std::string& key,
+                              const std::string& value) {
+  if (!hole_param_table().contains(key)) {
+    return;  // 与 AlgoBase::configure() 一致，忽略未知参数
   }
+  settings_.update([&](Settings& s) {
+    hole_param_table().apply(s.config, key, value);
+    parse_partition_params(s);
+  });
+}
+
+void HoleDetection::configure_batch(
+    const std::vector<std::pair<std::string, std::string>>& updates) {
+  std::vector<std::pair<std::string, std::string>> known;
+  for (const auto& update : updates) {
+    if (hole_param_table().contains(update.first)) {
+      known.push_back(update);
+    }
+  }
+  settings_.update([&](Settings& s) {
+    hole_param_table().apply_all(s.config, known);
+    parse_partition_params(s);
+  });
+}
+
+std::vector<AlgoParamInfo> HoleDetection::get_parameter_info() const {
+  // 返回原始字符串（用于 UI 显示和保存）
+  return hole_param_table().describe(settings_.load()->config);
+}
+
+std::vector<StageTimingStats> HoleDetection::get_stage_timings() const {
+  return stage_timings_.snapshot();
+}
 
-  return {{"pixel_per_mm", "float", "像素/毫米转换因子", "50.0",
-           std::to_string(local_config.pixel_per_mm)},
-          {"enable_real_world_calculation", "bool", "是否启用真实尺寸计算", "1",
-           local_config.enable_real_world_calculation ? "1" : "0"},
-          {"min_defect_area", "int", "最小缺陷面积（像素）", "1",
-           std::to_string(local_config.min_defect_area)},
-          {"edge_margin", "int", "边缘过滤边距（像素）", "10",
-           std::to_string(local_config.edge_margin)},
-          {"merge_distance_threshold", "int", "孔洞合并距离阈值（像素）", "20",
-           std::to_string(local_config.merge_distance_threshold)},
-          {"pixel_to_mm_width", "float", "水平方向像素/毫米", "0.05586",
-           std::to_string(local_config.pixel_to_mm_width)},
-          {"pixel_to_mm_height", "float", "垂直方向像素/毫米", "0.061",
-           std::to_string(local_config.pixel_to_mm_height)},
-          {"partition_params", "string",
-           "分区配置（left_ratio,mid_ratio,right_ratio,left_thresh,mid_thresh,"
-           "right_thresh）",
-           "0.3,0.4,0.3,20,23,20",
-           local_config.partition_params}};  // 直接返回字符串
+HoleScratchStats HoleDetection::get_scratch_stats() const {
+  HoleScratchStats stats;
+  stats.frames = scratch_frames_.load(std::memory_order_relaxed);
+  stats.growth_frames = scratch_growths_.load(std::memory_order_relaxed);
+  stats.peak_reserved_bytes =
+      scratch_peak_bytes_.load(std::memory_order_relaxed);
+  return stats;
 }
 
 std::vector<AlgoSignalInfo> HoleDetection::get_signal_info() const {
-  return {{"raw", "原始灰度图像"},
-          {"preprocessed", "预处理后图像（裁剪+去噪）"},
-          {"binary", "二值化结果（分区阈值）"},
-          {"defect_map", "缺陷标注图（含合并孔洞）"}};
+  // 顺序与 HoleSignal 一致，initialize() 按这个顺序给出句柄
+  return {{kHoleSignalNames[kSignalRaw], "原始灰度图像"},
+          {kHoleSignalNames[kSignalPreprocessed], "预处理后图像（裁剪+去噪）"},
+          {kHoleSignalNames[kSignalBinary], "二值化结果（分区阈值）"},
+          {kHoleSignalNames[kSignalDefectMap], "缺陷标注图（含合并孔洞）"}};
 }
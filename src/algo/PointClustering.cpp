@@ -0,0 +1,154 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: PointClustering.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/PointClustering.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace algo {
+
+namespace {
+
+// 并查集：总是把下标大的根挂到下标小的根上，每个簇的根就是最小下标
+// 节点数组由调用方提供，便于复用
+class DisjointSet {
+ public:
+  DisjointSet(std::vector<int>& parent, size_t n) : parent_(parent) {
+    parent_.resize(n);
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  int find(int x) {
+    while (parent_[x] != x) {
+      parent_[x] = parent_[parent_[x]];  // 路径减半
+      x = parent_[x];
+    }
+    return x;
+  }
+
+  void unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+      return;
+    }
+    if (a > b) {
+      std::swap(a, b);
+    }
+    parent_[b] = a;
+  }
+
+ private:
+  std::vector<int>& parent_;
+};
+
+// 向下取整的整数除法（坐标可能为负）
+inline int floor_div(int value, int divisor) {
+  const int q = value / divisor;
+  return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? q - 1 : q;
+}
+
+inline int64_t cell_key(int cx, int cy) {
+  return (static_cast<int64_t>(cy) << 32) |
+         static_cast<int64_t>(static_cast<uint32_t>(cx));
+}
+
+}  // namespace
+
+std::vector<int> cluster_points_grid(const std::vector<cv::Point>& points,
+                                     int distance) {
+  GridClusterScratch scratch;
+  std::vector<int> labels;
+  cluster_points_grid(points, distance, scratch, labels);
+  return labels;
+}
+
+void cluster_points_grid(std::span<const cv::Point> points, int distance,
+                         GridClusterScratch& scratch, std::vector<int>& labels) {
+  const size_t n = points.size();
+  labels.assign(n, 0);
+  if (n <= 1) {
+    return;
+  }
+
+  distance = std::max(distance, 0);
+  const int cell = std::max(distance, 1);
+  const int64_t limit = static_cast<int64_t>(distance) * distance;
+
+  // 按格子排序的 (格子, 点下标)，同一格子的点连续存放
+  auto& cells = scratch.cells;
+  cells.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    cells[i] = {cell_key(floor_div(points[i].x, cell),
+                         floor_div(points[i].y, cell)),
+                static_cast<int>(i)};
+  }
+  std::sort(cells.begin(), cells.end());
+
+  DisjointSet sets(scratch.parent, n);
+  for (size_t i = 0; i < n; ++i) {
+    const cv::Point& p = points[i];
+    const int cx = floor_div(p.x, cell);
+    const int cy = floor_div(p.y, cell);
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const int64_t key = cell_key(cx + dx, cy + dy);
+        auto it = std::lower_bound(
+            cells.begin(), cells.end(), std::make_pair(key, 0),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (; it != cells.end() && it->first == key; ++it) {
+          const int j = it->second;
+          if (j <= static_cast<int>(i)) {
+            continue;  // 每对点只比较一次
+          }
+          const int64_t ddx = points[j].x - p.x;
+          const int64_t ddy = points[j].y - p.y;
+          if (ddx * ddx + ddy * ddy <= limit) {
+            sets.unite(static_cast<int>(i), j);
+          }
+        }
+      }
+    }
+  }
+
+  // 根是簇内最小下标，按下标顺序遇到的新根依次编号
+  auto& root_label = scratch.root_label;
+  root_label.assign(n, -1);
+  int next_label = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const int root = sets.find(static_cast<int>(i));
+    if (root_label[root] < 0) {
+      root_label[root] = next_label++;
+    }
+    labels[i] = root_label[root];
+  }
+}
+
+}  // namespace algo
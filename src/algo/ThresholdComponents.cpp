@@ -0,0 +1,471 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ThresholdComponents.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/ThresholdComponents.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define THRESHOLD_COMPONENTS_SSE2 1
+#endif
+
+namespace algo {
+
+namespace {
+
+// 前景游程 [begin, end)
+struct Run {
+  int begin;
+  int end;
+  int label;
+};
+
+// 每个临时标签的累加量，合并到根之后再输出
+struct Accumulator {
+  int64_t area = 0;
+  int64_t sum_x = 0;
+  int64_t sum_y = 0;
+  int min_x = INT32_MAX;
+  int min_y = INT32_MAX;
+  int max_x = -1;
+  int max_y = -1;
+  int first_x = 0;  // 光栅扫描中第一个像素的 x（位于 min_y 行）
+
+  void add_run(int y, int begin, int end) {
+    if (area == 0) {
+      first_x = begin;
+    }
+    const int64_t n = end - begin;
+    area += n;
+    sum_x += (static_cast<int64_t>(begin) + end - 1) * n / 2;
+    sum_y += static_cast<int64_t>(y) * n;
+    min_x = std::min(min_x, begin);
+    max_x = std::max(max_x, end - 1);
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+  }
+
+  // 合并后第一个像素取两者中光栅顺序靠前的
+  void merge(const Accumulator& other) {
+    if (other.min_y < min_y ||
+        (other.min_y == min_y && other.first_x < first_x)) {
+      first_x = other.first_x;
+    }
+    area += other.area;
+    sum_x += other.sum_x;
+    sum_y += other.sum_y;
+    min_x = std::min(min_x, other.min_x);
+    max_x = std::max(max_x, other.max_x);
+    min_y = std::min(min_y, other.min_y);
+    max_y = std::max(max_y, other.max_y);
+  }
+};
+
+// 标签小的作为根，根就是光栅扫描中最早出现的游程
+int find_root(std::vector<int>& parent, int x) {
+  while (parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+  }
+  return x;
+}
+
+void unite(std::vector<int>& parent, int a, int b) {
+  a = find_root(parent, a);
+  b = find_root(parent, b);
+  if (a != b) {
+    parent[std::max(a, b)] = std::min(a, b);
+  }
+}
+
+// 把 16 个像素的比较结果写进位掩码的第 x 位起
+inline void or_bits(uint64_t* words, int x, uint64_t bits16) {
+  const int word = x >> 6;
+  const int offset = x & 63;
+  words[word] |= bits16 << offset;
+  if (offset > 48) {
+    words[word + 1] |= bits16 >> (64 - offset);
+  }
+}
+
+// row[x] > thresh 的像素在 words 中置位，x ∈ [begin, end)
+void compare_segment(const uint8_t* row, int begin, int end, int thresh,
+                     uint64_t* words) {
+  if (thresh >= 255) {
+    return;  // 没有像素能大于 255
+  }
+  int x = begin;
+  if (thresh < 0) {
+    for (; x < end; ++x) {
+      words[x >> 6] |= uint64_t{1} << (x & 63);
+    }
+    return;
+  }
+#ifdef THRESHOLD_COMPONENTS_SSE2
+  // 无符号 a > t 等价于饱和减法 a - t 非零
+  const __m128i t = _mm_set1_epi8(static_cast<char>(thresh));
+  const __m128i zero = _mm_setzero_si128();
+  for (; x + 16 <= end; x += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+    const __m128i is_zero = _mm_cmpeq_epi8(_mm_subs_epu8(v, t), zero);
+    const uint32_t mask =
+        ~static_cast<uint32_t>(_mm_movemask_epi8(is_zero)) & 0xffffu;
+    if (mask != 0) {
+      or_bits(words, x, mask);
+    }
+  }
+#endif
+  for (; x < end; ++x) {
+    if (row[x] > thresh) {
+      words[x >> 6] |= uint64_t{1} << (x & 63);
+    }
+  }
+}
+
+inline int count_trailing_zeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index = 0;
+  _BitScanForward64(&index, value);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctzll(value);
+#endif
+}
+
+// 从位掩码中提取前景游程
+void extract_runs(const uint64_t* words, int word_count, int width,
+                  std::vector<Run>& runs) {
+  runs.clear();
+  int x = 0;
+  while (x < width) {
+    // 找下一个置位
+    int word = x >> 6;
+    uint64_t bits = words[word] & (~uint64_t{0} << (x & 63));
+    while (bits == 0 && ++word < word_count) {
+      bits = words[word];
+    }
+    if (bits == 0) {
+      return;
+    }
+    const int begin = (word << 6) + count_trailing_zeros(bits);
+    if (begin >= width) {
+      return;
+    }
+    // 找之后的第一个清零位
+    uint64_t holes = ~words[word] & (~uint64_t{0} << (begin & 63));
+    while (holes == 0 && ++word < word_count) {
+      holes = ~words[word];
+    }
+    const int end =
+        holes == 0 ? width
+                   : std::min(width, (word << 6) + count_trailing_zeros(holes));
+    runs.push_back({begin, end, -1});
+    x = end;
+  }
+}
+
+// 一个行带 [y_begin, y_end) 的标记结果，首末行的游程留给接缝合并用；
+// 其余成员是标记过程的临时缓冲区，跨帧复用
+struct Band {
+  std::vector<Accumulator> components;  // 只含根，按光栅顺序
+  std::vector<Run> first_runs;          // label 为 components 的下标
+  std::vector<Run> last_runs;
+
+  std::vector<uint64_t> words;
+  std::vector<Run> previous;
+  std::vector<Run> current;
+  std::vector<int> parent;
+  std::vector<int> compact;
+  std::vector<Accumulator> accumulators;
+};
+
+template <typename T>
+size_t capacity_bytes(const std::vector<T>& v) {
+  return v.capacity() * sizeof(T);
+}
+
+size_t capacity_bytes(const Band& band) {
+  return capacity_bytes(band.components) + capacity_bytes(band.first_runs) +
+         capacity_bytes(band.last_runs) + capacity_bytes(band.words) +
+         capacity_bytes(band.previous) + capacity_bytes(band.current) +
+         capacity_bytes(band.parent) + capacity_bytes(band.compact) +
+         capacity_bytes(band.accumulators);
+}
+
+// 逐行：分区比较得到位掩码 → 提取游程 → 与上一行的游程合并
+void label_band(const cv::Mat& gray,
+                std::span<const ColumnThreshold> partitions, int y_begin,
+                int y_end, Band& band) {
+  const int width = gray.cols;
+  const int word_count = (width + 63) / 64 + 1;  // 多一个字给跨字写入
+  std::vector<uint64_t>& words = band.words;
+  std::vector<Run>& previous = band.previous;
+  std::vector<Run>& current = band.current;
+  std::vector<int>& parent = band.parent;
+  std::vector<Accumulator>& accumulators = band.accumulators;
+  words.resize(word_count);
+  previous.clear();
+  current.clear();
+  parent.clear();
+  accumulators.clear();
+  band.first_runs.clear();
+
+  for (int y = y_begin; y < y_end; ++y) {
+    const uint8_t* row = gray.ptr<uint8_t>(y);
+    std::fill(words.begin(), words.end(), 0);
+    int begin = 0;
+    for (size_t p = 0; p < partitions.size() && begin < width; ++p) {
+      const int end = p + 1 == partitions.size()
+                          ? width
+                          : std::clamp(partitions[p].end_col, begin, width);
+      compare_segment(row, begin, end, partitions[p].thresh, words.data());
+      begin = end;
+    }
+
+    extract_runs(words.data(), word_count, width, current);
+
+    // 与上一行的游程合并；8 连通时对角相邻也算重叠
+    size_t k = 0;
+    for (Run& run : current) {
+      while (k < previous.size() && previous[k].end < run.begin) {
+        ++k;
+      }
+      for (size_t j = k; j < previous.size() && previous[j].begin <= run.end;
+           ++j) {
+        if (run.label < 0) {
+          run.label = previous[j].label;
+        } else {
+          unite(parent, run.label, previous[j].label);
+        }
+      }
+      if (run.label < 0) {
+        run.label = static_cast<int>(parent.size());
+        parent.push_back(run.label);
+        accumulators.emplace_back();
+      }
+      accumulators[run.label].add_run(y, run.begin, run.end);
+    }
+    if (y == y_begin) {
+      band.first_runs = current;
+    }
+    std::swap(previous, current);
+  }
+  // 复制而不是交换，各缓冲区的容量只增不减，不会在帧间轮换
+  band.last_runs.assign(previous.begin(), previous.end());
+
+  // 临时标签按从小到大的顺序合并到根，根的顺序即光栅顺序
+  std::vector<int>& compact = band.compact;
+  compact.assign(parent.size(), -1);
+  band.components.clear();
+  for (size_t label = 0; label < parent.size(); ++label) {
+    const int root = find_root(parent, static_cast<int>(label));
+    if (root == static_cast<int>(label)) {
+      compact[label] = static_cast<int>(band.components.size());
+      band.components.push_back(accumulators[label]);
+    } else {
+      band.components[compact[root]].merge(accumulators[label]);
+    }
+  }
+  for (auto* runs : {&band.first_runs, &band.last_runs}) {
+    for (Run& run : *runs) {
+      run.label = compact[find_root(parent, run.label)];
+    }
+  }
+}
+
+ComponentStats to_stats(const Accumulator& acc) {
+  ComponentStats stats;
+  stats.left = acc.min_x;
+  stats.top = acc.min_y;
+  stats.width = acc.max_x - acc.min_x + 1;
+  stats.height = acc.max_y - acc.min_y + 1;
+  stats.area = static_cast<int>(acc.area);
+  stats.cx = static_cast<double>(acc.sum_x) / acc.area;
+  stats.cy = static_cast<double>(acc.sum_y) / acc.area;
+  return stats;
+}
+
+}  // namespace
+
+struct ComponentScratch::Buffers {
+  std::vector<Band> bands;  // 单线程时只用 bands[0]
+  // 接缝合并
+  std::vector<int> offset;
+  std::vector<int> parent;
+  std::vector<Accumulator> merged;
+  std::vector<const Accumulator*> roots;
+};
+
+ComponentScratch::ComponentScratch() : buffers_(std::make_unique<Buffers>()) {}
+ComponentScratch::~ComponentScratch() = default;
+ComponentScratch::ComponentScratch(ComponentScratch&&) noexcept = default;
+ComponentScratch& ComponentScratch::operator=(ComponentScratch&&) noexcept =
+    default;
+
+size_t ComponentScratch::reserved_bytes() const {
+  if (!buffers_) {
+    return 0;
+  }
+  size_t bytes = capacity_bytes(buffers_->bands) +
+                 capacity_bytes(buffers_->offset) +
+                 capacity_bytes(buffers_->parent) +
+                 capacity_bytes(buffers_->merged) +
+                 capacity_bytes(buffers_->roots);
+  for (const Band& band : buffers_->bands) {
+    bytes += capacity_bytes(band);
+  }
+  return bytes;
+}
+
+std::vector<ComponentStats> threshold_components(
+    const cv::Mat& gray, std::span<const ColumnThreshold> partitions) {
+  ComponentScratch scratch;
+  std::vector<ComponentStats> components;
+  threshold_components(gray, partitions, scratch, components);
+  return components;
+}
+
+void threshold_components(const cv::Mat& gray,
+                          std::span<const ColumnThreshold> partitions,
+                          ComponentScratch& scratch,
+                          std::vector<ComponentStats>& components) {
+  components.clear();
+  if (gray.empty() || gray.type() != CV_8UC1 || partitions.empty()) {
+    return;
+  }
+
+  auto& bands = scratch.buffers_->bands;
+  if (bands.empty()) {
+    bands.resize(1);
+  }
+  Band& band = bands.front();
+  label_band(gray, partitions, 0, gray.rows, band);
+  components.reserve(band.components.size());
+  for (const Accumulator& acc : band.components) {
+    components.push_back(to_stats(acc));
+  }
+}
+
+std::vector<ComponentStats> threshold_components_banded(
+    const cv::Mat& gray, std::span<const ColumnThreshold> partitions,
+    size_t bands, const BandRunner& run) {
+  ComponentScratch scratch;
+  std::vector<ComponentStats> components;
+  threshold_components_banded(gray, partitions, bands, run, scratch,
+                              components);
+  return components;
+}
+
+void threshold_components_banded(const cv::Mat& gray,
+                                 std::span<const ColumnThreshold> partitions,
+                                 size_t bands, const BandRunner& run,
+                                 ComponentScratch& scratch,
+                                 std::vector<ComponentStats>& components) {
+  bands = std::min<size_t>(bands, std::max(gray.rows, 0));
+  if (bands <= 1 || !run) {
+    threshold_components(gray, partitions, scratch, components);
+    return;
+  }
+  components.clear();
+  if (gray.type() != CV_8UC1 || partitions.empty()) {
+    return;
+  }
+
+  ComponentScratch::Buffers& buffers = *scratch.buffers_;
+  std::vector<Band>& results = buffers.bands;
+  if (results.size() < bands) {
+    results.resize(bands);
+  }
+  run(bands, [&](size_t i) {
+    const int y_begin = static_cast<int>(gray.rows * i / bands);
+    const int y_end = static_cast<int>(gray.rows * (i + 1) / bands);
+    label_band(gray, partitions, y_begin, y_end, results[i]);
+  });
+
+  // 各带的连通域编上全局号，接缝两侧相邻的游程属于同一个连通域
+  std::vector<int>& offset = buffers.offset;
+  offset.assign(bands + 1, 0);
+  for (size_t i = 0; i < bands; ++i) {
+    offset[i + 1] = offset[i] + static_cast<int>(results[i].components.size());
+  }
+  std::vector<int>& parent = buffers.parent;
+  parent.resize(offset[bands]);
+  std::iota(parent.begin(), parent.end(), 0);
+  for (size_t i = 0; i + 1 < bands; ++i) {
+    const auto& above = results[i].last_runs;
+    size_t k = 0;
+    for (const Run& run_below : results[i + 1].first_runs) {
+      while (k < above.size() && above[k].end < run_below.begin) {
+        ++k;
+      }
+      for (size_t j = k; j < above.size() && above[j].begin <= run_below.end;
+           ++j) {
+        unite(parent, offset[i] + above[j].label,
+              offset[i + 1] + run_below.label);
+      }
+    }
+  }
+
+  // 合并到根后按第一个像素的光栅顺序输出，与单线程结果一致
+  std::vector<Accumulator>& merged = buffers.merged;
+  merged.assign(parent.size(), Accumulator{});
+  for (size_t i = 0; i < bands; ++i) {
+    for (size_t c = 0; c < results[i].components.size(); ++c) {
+      const int root = find_root(parent, offset[i] + static_cast<int>(c));
+      if (merged[root].area == 0) {
+        merged[root] = results[i].components[c];
+      } else {
+        merged[root].merge(results[i].components[c]);
+      }
+    }
+  }
+  std::vector<const Accumulator*>& roots = buffers.roots;
+  roots.clear();
+  for (const Accumulator& acc : merged) {
+    if (acc.area > 0) {
+      roots.push_back(&acc);
+    }
+  }
+  std::sort(roots.begin(), roots.end(),
+            [](const Accumulator* a, const Accumulator* b) {
+              return a->min_y != b->min_y ? a->min_y < b->min_y
+                                          : a->first_x < b->first_x;
+            });
+  components.reserve(roots.size());
+  for (const Accumulator* acc : roots) {
+    components.push_back(to_stats(*acc));
+  }
+}
+
+}  // namespace algo
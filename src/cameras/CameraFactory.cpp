@@ -27,6 +27,7 @@
 #include "cameras/CameraFactory.hpp"
 
 #include "DvpCameraBuilder.hpp"
+#include "cameras/ReplayCameraCapture.hpp"
 #include "config/CameraConfig.hpp"
 
 std::unique_ptr<CameraCapture> create_camera(const CameraBrand& brand,
@@ -64,6 +65,13 @@ std::unique_ptr<CameraCapture> create_camera(const CameraBrand& brand,
       // 这里需要Mind相机的具体实现
       break;
     }
+    case CameraBrand::Replay: {
+      ReplayConfig replay;
+      replay.source = identifier;
+      auto camera = std::make_unique<ReplayCameraCapture>(replay);
+      camera->set_config(config);
+      return camera;
+    }
   }
   return nullptr;
 }
@@ -113,10 +113,10 @@ bool CameraManager::load_camera_config(const std::string& camera_id,
 }
 
 bool CameraManager::start_camera(const std::string& camera_id,
-                                 const FrameProcessor& processor) {
+                                 std::shared_ptr<FrameProcessor> processor) {
   auto it = cameras_.find(camera_id);
   if (it != cameras_.end()) {
-    return it->second->capture->start(processor);
+    return it->second->capture->start(std::move(processor));
   }
   return false;
 }
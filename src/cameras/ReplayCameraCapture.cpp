@@ -0,0 +1,415 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReplayCameraCapture.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/ReplayCameraCapture.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <opencv2/imgcodecs.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FrameFile.hpp"
+#include "PixelFormat.hpp"
+#include "config/CameraConfig.hpp"
+
+// 回放数据源：把下一帧（数据 + meta）写进 frame
+class ReplaySource {
+ public:
+  virtual ~ReplaySource() = default;
+  virtual bool next(CapturedFrame& frame) = 0;
+  virtual bool rewind() = 0;
+};
+
+namespace {
+
+// 录像：按分段顺序读出，数据直接读进池中的帧
+class RecordingSource : public ReplaySource {
+ public:
+  explicit RecordingSource(std::vector<std::string> segments)
+      : reader_(std::move(segments)) {}
+
+  bool valid() const { return reader_.is_open(); }
+  bool next(CapturedFrame& frame) override { return reader_.next(frame); }
+  bool rewind() override { return reader_.rewind(); }
+
+ private:
+  FrameFileReader reader_;
+};
+
+// 图片：start() 时全部解码，回放时只做一次拷贝（模拟 SDK 缓冲区 -> slab）
+class ImageSource : public ReplaySource {
+ public:
+  explicit ImageSource(const std::vector<std::string>& paths) {
+    for (const auto& path : paths) {
+      cv::Mat image = cv::imread(path, cv::IMREAD_UNCHANGED);
+      if (image.empty() || !image.isContinuous()) {
+        continue;
+      }
+      dvpFrame meta{};
+      if (!describe(image, meta)) {
+        continue;
+      }
+      meta.uFrameID = images_.size();
+      Image entry;
+      entry.meta = meta;
+      entry.data.assign(image.data, image.data + meta.uBytes);
+      images_.push_back(std::move(entry));
+    }
+  }
+
+  bool valid() const { return !images_.empty(); }
+
+  bool next(CapturedFrame& frame) override {
+    if (next_ >= images_.size()) {
+      return false;
+    }
+    const Image& image = images_[next_++];
+    frame.meta = image.meta;
+    frame.data.assign(image.data.begin(), image.data.end());
+    frame.update_layout();
+    return true;
+  }
+
+  bool rewind() override {
+    next_ = 0;
+    return valid();
+  }
+
+ private:
+  struct Image {
+    FrameBuffer data;
+    dvpFrame meta{};
+  };
+
+  // OpenCV 读出的彩色图是 BGR 顺序
+  static bool describe(const cv::Mat& image, dvpFrame& meta) {
+    const bool wide = image.depth() == CV_16U;
+    if (image.depth() != CV_8U && !wide) {
+      return false;
+    }
+    switch (image.channels()) {
+      case 1:
+        meta.format = FORMAT_MONO;
+        break;
+      case 3:
+        meta.format = wide ? FORMAT_BGR48 : FORMAT_BGR24;
+        break;
+      case 4:
+        meta.format = wide ? FORMAT_BGR64 : FORMAT_BGR32;
+        break;
+      default:
+        return false;
+    }
+    meta.bits = wide ? BITS_16 : BITS_8;
+    meta.iWidth = image.cols;
+    meta.iHeight = image.rows;
+    meta.uBytes = static_cast<dvpUint32>(image.total() * image.elemSize());
+    return true;
+  }
+
+  std::vector<Image> images_;
+  size_t next_ = 0;
+};
+
+bool is_image_file(const std::filesystem::path& path) {
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return ext == ".png" || ext == ".bmp" || ext == ".jpg" || ext == ".jpeg" ||
+         ext == ".tif" || ext == ".tiff";
+}
+
+// 按路径判断数据源类型：.dvpr 文件或含 .dvpr 的目录按录像处理，否则按图片
+std::unique_ptr<ReplaySource> make_source(const std::string& path) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+
+  auto segments = frame_file::list_segments(path);
+  if (!segments.empty() &&
+      fs::path(segments.front()).extension() == frame_file::kExtension) {
+    auto recording = std::make_unique<RecordingSource>(std::move(segments));
+    if (recording->valid()) {
+      return recording;
+    }
+    return nullptr;
+  }
+
+  std::vector<std::string> images;
+  if (fs::is_regular_file(path, ec)) {
+    images.push_back(path);
+  } else {
+    for (const auto& entry : fs::directory_iterator(path, ec)) {
+      if (entry.is_regular_file() && is_image_file(entry.path())) {
+        images.push_back(entry.path().string());
+      }
+    }
+    std::sort(images.begin(), images.end());
+  }
+  auto source = std::make_unique<ImageSource>(images);
+  if (source->valid()) {
+    return source;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+ReplayCameraCapture::ReplayCameraCapture(ReplayConfig config)
+    : config_(std::move(config)),
+      fps_(config_.fps),
+      line_rate_(config_.line_rate) {
+  // 原始队列积压说明外部消费者（存图/显示）跟不上，标记 file_io 异常
+  pipeline_.set_raw_saturation_handler([this](bool saturated) {
+    protocol::FrontendStatus status = get_status();
+    status.file_io = !saturated;
+    update_status(status);
+  });
+}
+
+ReplayCameraCapture::~ReplayCameraCapture() {
+  stop();
+  pipeline_.shutdown();
+}
+
+bool ReplayCameraCapture::start(std::shared_ptr<FrameProcessor> processor) {
+  // 重复 start 同一个处理器时不重复添加
+  if (processor && !pipeline_.processors().contains(processor)) {
+    pipeline_.add_frame_processor(std::move(processor));
+  }
+  return start();
+}
+
+bool ReplayCameraCapture::start() {
+  if (running_) {
+    return true;
+  }
+  if (worker_.joinable()) {
+    worker_.join();  // 上一次已经自然播完的线程
+  }
+
+  if (!source_) {
+    source_ = make_source(config_.source);
+  }
+  if (!source_ || !source_->rewind()) {
+    return false;
+  }
+
+  pipeline_.prepare(0);  // 帧大小由数据源决定，第一帧之后池就稳定了
+  {
+    std::lock_guard lock(finish_mutex_);
+    finished_ = false;
+  }
+  frames_emitted_ = 0;
+  running_ = true;
+  worker_ = std::thread([this]() { replay_loop(); });
+
+  protocol::FrontendStatus initial_status;
+  initial_status.self_check = true;
+  initial_status.capture = true;
+  initial_status.file_io = true;
+  update_status(initial_status);
+  return true;
+}
+
+void ReplayCameraCapture::stop() {
+  running_ = false;
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  protocol::FrontendStatus status = get_status();
+  status.capture = false;
+  update_status(status);
+}
+
+bool ReplayCameraCapture::wait_for_finish(std::chrono::milliseconds timeout) {
+  std::unique_lock lock(finish_mutex_);
+  if (!finish_cv_.wait_for(lock, timeout, [this]() { return finished_; })) {
+    return false;
+  }
+  lock.unlock();
+  pipeline_.wait_idle();
+  return true;
+}
+
+std::chrono::nanoseconds ReplayCameraCapture::frame_interval(
+    int height) const {
+  using namespace std::chrono;
+  const double line_rate = line_rate_.load();
+  const double fps = fps_.load();
+  double seconds = 0.0;
+  if (line_rate > 0.0) {
+    seconds = std::max(height, 1) / line_rate;
+  } else if (fps > 0.0) {
+    seconds = 1.0 / fps;
+  }
+  return duration_cast<nanoseconds>(duration<double>(seconds));
+}
+
+void ReplayCameraCapture::replay_loop() {
+  using clock = std::chrono::steady_clock;
+
+  // ROI 裁剪时先读进这一帧，再把 ROI 拷进池中的帧
+  CapturedFrame staging;
+  size_t frame_bytes = 0;
+  auto deadline = clock::now();
+
+  while (running_) {
+    if (config_.max_frames > 0 && frames_emitted_ >= config_.max_frames) {
+      break;
+    }
+
+    Roi roi;
+    {
+      std::lock_guard lock(roi_mutex_);
+      roi = roi_;
+    }
+    const bool cropping = roi.width > 0 && roi.height > 0;
+
+    auto frame = pipeline_.acquire(frame_bytes);
+    bool ok = source_->next(cropping ? staging : *frame);
+    if (!ok && config_.loop && source_->rewind()) {
+      ok = source_->next(cropping ? staging : *frame);
+    }
+    if (!ok) {
+      break;
+    }
+    if (cropping && !crop_into(staging, roi, *frame)) {
+      break;  // ROI 超出了帧的范围，不再继续回放
+    }
+    frame_bytes = std::max(frame_bytes, frame->data.size());
+
+    // 按帧率/行频节流；落后超过一帧时不补发，从当前时刻重新计时
+    const auto interval = frame_interval(frame->height());
+    if (interval.count() > 0) {
+      const auto now = clock::now();
+      if (deadline + interval < now) {
+        deadline = now;
+      }
+      std::this_thread::sleep_until(deadline);
+      deadline += interval;
+    }
+
+    pipeline_.publish(std::move(frame));
+    ++frames_emitted_;
+  }
+
+  {
+    std::lock_guard lock(finish_mutex_);
+    finished_ = true;
+  }
+  finish_cv_.notify_all();
+  running_ = false;
+}
+
+bool ReplayCameraCapture::crop_into(const CapturedFrame& source,
+                                    const Roi& roi, CapturedFrame& target) {
+  const size_t pixel_bytes = bytes_per_pixel(source.pixel_format);
+  if (pixel_bytes == 0 || roi.x < 0 || roi.y < 0 ||
+      roi.x + roi.width > source.width() ||
+      roi.y + roi.height > source.height()) {
+    return false;
+  }
+
+  const size_t row_bytes = static_cast<size_t>(roi.width) * pixel_bytes;
+  target.data.resize_uninitialized(row_bytes * roi.height);
+  const uint8_t* src = source.data.data() + roi.y * source.stride +
+                       static_cast<size_t>(roi.x) * pixel_bytes;
+  uint8_t* dst = target.data.data();
+  for (int row = 0; row < roi.height; ++row) {
+    std::memcpy(dst, src, row_bytes);
+    src += source.stride;
+    dst += row_bytes;
+  }
+
+  target.meta = source.meta;
+  target.meta.iWidth = roi.width;
+  target.meta.iHeight = roi.height;
+  target.meta.uBytes = static_cast<dvpUint32>(target.data.size());
+  target.update_layout();
+  return true;
+}
+
+void ReplayCameraCapture::set_config(const CameraConfig& cfg) {
+  if (cfg.acquisition_frame_rate_enable) {
+    fps_ = cfg.acquisition_frame_rate;
+  }
+  if (cfg.roi_w > 0 && cfg.roi_h > 0) {
+    set_roi(cfg.roi_x, cfg.roi_y, cfg.roi_w, cfg.roi_h);
+  }
+}
+
+void ReplayCameraCapture::set_roi(int x, int y, int width, int height) {
+  std::lock_guard lock(roi_mutex_);
+  roi_ = Roi{x, y, width, height};
+}
+
+void ReplayCameraCapture::set_admission_config(
+    const FrameAdmissionConfig& cfg) {
+  pipeline_.set_admission_config(cfg);
+}
+
+void ReplayCameraCapture::set_worker_budget(const WorkerBudget& budget) {
+  // 回放中不替换 lane，下次 start() 时按新预算重新申请
+  if (!running_) {
+    pipeline_.set_worker_budget(budget);
+  }
+}
+
+size_t ReplayCameraCapture::add_frame_processor(
+    std::shared_ptr<FrameProcessor> processor, std::string name) {
+  return pipeline_.add_frame_processor(std::move(processor), std::move(name));
+}
+
+bool ReplayCameraCapture::set_frame_processor_enabled(size_t index,
+                                                      bool enabled) {
+  return pipeline_.processors().set_enabled(index, enabled);
+}
+
+bool ReplayCameraCapture::set_frame_processor_enabled(const std::string& name,
+                                                      bool enabled) {
+  return pipeline_.processors().set_enabled(name, enabled);
+}
+
+protocol::FrontendStatus ReplayCameraCapture::get_status() const {
+  protocol::FrontendStatus status;
+  {
+    std::shared_lock lock(status_mutex_);
+    status = current_status_;
+  }
+  status.processing_queue = pipeline_.processing_queue_stats();
+  status.raw_queue = pipeline_.raw_queue_stats();
+  return status;
+}
+
+void ReplayCameraCapture::update_status(
+    const protocol::FrontendStatus& new_status) {
+  std::unique_lock lock(status_mutex_);
+  current_status_ = new_status;
+}
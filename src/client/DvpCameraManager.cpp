@@ -30,6 +30,7 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <utility>
 
 #include "DvpCameraCapture.hpp"
 
@@ -377,10 +378,10 @@ bool DvpCameraManager::loadCameraConfig(const QString& cameraId,
 }
 
 bool DvpCameraManager::startCamera(const QString& cameraId,
-                                   const FrameProcessor& processor) {
+                                   std::shared_ptr<FrameProcessor> processor) {
   auto it = m_cameras.find(cameraId);
   if (it != m_cameras.end()) {
-    return it->second->capture->start(processor);
+    return it->second->capture->start(std::move(processor));
   }
   return false;
 }
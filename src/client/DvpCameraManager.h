@@ -57,7 +57,8 @@ class DvpCameraManager : public QObject {
   bool loadCameraConfig(const QString& cameraId, const QString& filePath);
 
   // 相机操作
-  bool startCamera(const QString& cameraId, const FrameProcessor& processor);
+  bool startCamera(const QString& cameraId,
+                   std::shared_ptr<FrameProcessor> processor);
   void stopCamera(const QString& cameraId);
 
  private:
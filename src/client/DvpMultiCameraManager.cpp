@@ -30,6 +30,7 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <utility>
 
 // 添加缺失的包含文件
 #include "DvpCameraCapture.hpp"
@@ -383,10 +384,10 @@ bool DvpMultiCameraManager::loadCameraConfig(const QString& cameraId,
 }
 
 bool DvpMultiCameraManager::startCamera(const QString& cameraId,
-                                        const FrameProcessor& processor) {
+                                        std::shared_ptr<FrameProcessor> processor) {
   auto it = m_cameras.find(cameraId);
   if (it != m_cameras.end()) {
-    return it->second->capture->start(processor);
+    return it->second->capture->start(std::move(processor));
   }
   return false;
 }
@@ -121,7 +121,8 @@ class DvpMultiCameraManager : public QObject {
    * @param processor 帧处理对象
    * @return 是否启动成功
    */
-  bool startCamera(const QString& cameraId, const FrameProcessor& processor);
+  bool startCamera(const QString& cameraId,
+                   std::shared_ptr<FrameProcessor> processor);
 
   /**
    * @brief 停止相机捕获
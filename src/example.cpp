@@ -31,6 +31,7 @@
 #include "DvpCameraBuilder.hpp"
 #include "FrameProcessor.hpp"
 #include "MultiCameraCoordinator.hpp"
+#include "StripStitcher.hpp"
 #include "algo/HoleDetection.hpp"
 #include "cameras/CameraFactory.hpp"
 #include "cameras/CameraManager.hpp"
@@ -290,21 +291,17 @@ int main() {
   // edgeDetection->configure("ratio", "2.5");
 
   // === 1. 创建融合策略（外部传入）===
-  auto fusion_strategy =
-      [](const std::vector<CapturedFrame>& frames) -> CapturedFrame {
-    // TODO(cmx): 根据需求的变化，前端机只负责采集一个相机图像并且处理
-    // 所以说，我们需要做的仅仅就是通过改变一个相机的ROI,或者是丢弃多余的部分来达到(图像融合的操作)
-    // 每一台前端机是单独发给服务器的
-    if (frames.size() != 2) {
-      return {};
-    }
+  // TODO(cmx): 根据需求的变化，前端机只负责采集一个相机图像并且处理
+  // 所以说，我们需要做的仅仅就是通过改变一个相机的ROI,或者是丢弃多余的部分来达到(图像融合的操作)
+  // 每一台前端机是单独发给服务器的
+  // 两台相机横向拼接：第二台相机的第 0 列标定在拼接坐标 1800 处，
+  // 重叠的 120 列从中间切开，每台相机各取一半
+  const int camera_widths[] = {1920, 1920};
+  const int camera_offsets[] = {0, 1800};
+  StripStitcher fusion_strategy(
+      StripStitcher::slices_from_offsets(camera_widths, camera_offsets));
 
-    // 实现图像融合逻辑
-    // 这里只是一个占位符实现
-    return frames[0];  // 返回第一帧作为示例
-  };
-
-  // === 2. 创建协调器 - 使用2个相机 ===
+  // === 2. 创建协调器 - 使用2个相机，按时间戳配对 ===
   MultiCameraCoordinator coordinator(2, fusion_strategy);
 
   // 设置下游处理器
@@ -52,6 +52,7 @@
  *  - Username: Administrator
  *  - CopyrightYear: 2025
  */
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -60,6 +61,7 @@
 #include "asio.hpp"
 // and then we could include others
 #include "DvpCameraBuilder.hpp"
+#include "StageTimings.hpp"
 #include "algo/AlgoBase.hpp"
 #include "algo/HoleDetection.hpp"
 #include "config/ConfigManager.hpp"
@@ -81,29 +83,32 @@ int main() {
       std::make_unique<protocol::AsioTcpTransport>(io_context),
       std::make_unique<protocol::AsioTcpTransport>(io_context));
 
-  // 启动 Asio 事件循环线程
-  std::thread asio_thread([&io_context]() { io_context.run(); });
-
-  // 连接服务器 (19700 端口接收配置)
-  session->async_connect("192.1.53.9", 19700, [session](std::error_code ec) {
-    if (ec) {
-      std::cerr << "Connect failed: " << ec.message() << "\n";
-      return;
-    }
-    session->async_receive_config(
-        [](std::shared_ptr<protocol::ServerConfig> config) {
-          if (config) {
-            std::cout << "Config: " << config->roll_id << "\n";
-          }
-        });
-  });
-
   auto &config_manager = config::ConfigManager::instance();
   config_manager.start();
   auto initial_config = config_manager.get_current_config();
 
   auto holedetection = config_manager.create_algorithm<algo::HoleDetection>();
 
+  // 启动 Asio 事件循环线程
+  std::thread asio_thread([&io_context]() { io_context.run(); });
+
+  // 连接服务器 (19700 端口接收配置)
+  session->async_connect(
+      "192.1.53.9", 19700, [session, holedetection](std::error_code ec) {
+        if (ec) {
+          std::cerr << "Connect failed: " << ec.message() << "\n";
+          return;
+        }
+        session->async_receive_config(
+            [holedetection](std::shared_ptr<protocol::ServerConfig> config) {
+              if (config) {
+                std::cout << "Config: " << config->roll_id << "\n";
+                // 换卷后带材边缘位置会突变，重新完整查找白边
+                holedetection->reset_border_tracking();
+              }
+            });
+      });
+
   auto camera = std::make_shared<DvpCameraCapture>(
       DvpCameraBuilder::fromUserId("123")
           .bufferQueueSize(10)
@@ -113,6 +118,12 @@ int main() {
 
   camera->start();
 
+  // 各阶段耗时由后台线程定期打印，处理线程不直接写控制台
+  StageTimingReporter timing_reporter;
+  timing_reporter.start(
+      [holedetection] { return holedetection->get_stage_timings(); },
+      StageTimingReporter::print, std::chrono::seconds(10));
+
   std::thread status_thread([session, camera]() {
     while (true) {
       auto status = camera->get_status();
@@ -128,6 +139,7 @@ int main() {
   std::cin.get();
 
   // 清理
+  timing_reporter.stop();
   camera->stop();
   work_guard.reset();
   io_context.stop();
@@ -0,0 +1,143 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: mapped_file.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "utils/mapped_file.h"
+
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace DvpUtils {
+
+MappedFile::~MappedFile() { close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::create(const std::string &path, size_t bytes) {
+  close();
+  if (bytes == 0) {
+    return false;
+  }
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  const auto size = static_cast<unsigned long long>(bytes);
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                         static_cast<DWORD>(size >> 32),
+                         static_cast<DWORD>(size & 0xffffffffULL), nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    return false;
+  }
+  void *view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, bytes);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  file_ = file;
+  mapping_ = mapping;
+  data_ = static_cast<uint8_t *>(view);
+  size_ = bytes;
+  return true;
+}
+
+void MappedFile::close(size_t keepBytes) {
+  if (data_ == nullptr) {
+    return;
+  }
+  UnmapViewOfFile(data_);
+  CloseHandle(static_cast<HANDLE>(mapping_));
+  // the mapping extended the file to its full size, trim the unused tail
+  LARGE_INTEGER end;
+  end.QuadPart = static_cast<LONGLONG>(keepBytes < size_ ? keepBytes : size_);
+  SetFilePointerEx(static_cast<HANDLE>(file_), end, nullptr, FILE_BEGIN);
+  SetEndOfFile(static_cast<HANDLE>(file_));
+  CloseHandle(static_cast<HANDLE>(file_));
+  file_ = nullptr;
+  mapping_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#else
+
+bool MappedFile::create(const std::string &path, size_t bytes) {
+  close();
+  if (bytes == 0) {
+    return false;
+  }
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+    ::close(fd);
+    return false;
+  }
+  void *view =
+      ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (view == MAP_FAILED) {
+    ::close(fd);
+    return false;
+  }
+  // written strictly front to back
+  ::madvise(view, bytes, MADV_SEQUENTIAL);
+  fd_ = fd;
+  data_ = static_cast<uint8_t *>(view);
+  size_ = bytes;
+  return true;
+}
+
+void MappedFile::close(size_t keepBytes) {
+  if (data_ == nullptr) {
+    return;
+  }
+  ::munmap(data_, size_);
+  // the file was sized up front, trim the unused tail
+  const off_t keep = static_cast<off_t>(keepBytes < size_ ? keepBytes : size_);
+  if (::ftruncate(fd_, keep) != 0) {
+    // a zero-filled tail is harmless, readers stop at the first empty record
+  }
+  ::close(fd_);
+  fd_ = -1;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#endif
+
+}  // namespace DvpUtils
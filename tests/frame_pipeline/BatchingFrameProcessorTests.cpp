@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BatchingFrameProcessor.hpp"
+
+// 记录每次 process_batch 收到的帧序号
+class RecordingProcessor : public FrameProcessor {
+ public:
+  void process_batch(std::span<const CapturedFrame* const> frames) override {
+    std::vector<uint64_t> batch;
+    for (const CapturedFrame* frame : frames) {
+      batch.push_back(frame->sequence);
+    }
+    std::lock_guard lock(mutex);
+    batches.push_back(std::move(batch));
+  }
+
+  std::vector<std::vector<uint64_t>> snapshot() {
+    std::lock_guard lock(mutex);
+    return batches;
+  }
+
+  std::mutex mutex;
+  std::vector<std::vector<uint64_t>> batches;
+};
+
+// 测试逐帧调用攒成批次的行为
+class BatchingFrameProcessorTests : public ::testing::Test {
+ protected:
+  std::shared_ptr<RecordingProcessor> inner =
+      std::make_shared<RecordingProcessor>();
+
+  static std::shared_ptr<CapturedFrame> make_frame(uint64_t sequence) {
+    auto frame = std::make_shared<CapturedFrame>();
+    frame->sequence = sequence;
+    frame->data.assign(16, 0);
+    return frame;
+  }
+};
+
+// 攒满 max_frames 帧时立即交给 inner，帧按到达顺序排列
+TEST_F(BatchingFrameProcessorTests, FullBatchIsProcessedImmediately) {
+  BatchingFrameProcessor batching(inner, {3, std::chrono::seconds(10)});
+  for (uint64_t i = 0; i < 7; ++i) {
+    batching.process(*make_frame(i));
+  }
+
+  auto batches = inner->snapshot();
+  ASSERT_EQ(batches.size(), 2u);
+  EXPECT_EQ(batches[0], (std::vector<uint64_t>{0, 1, 2}));
+  EXPECT_EQ(batches[1], (std::vector<uint64_t>{3, 4, 5}));
+
+  batching.flush();
+  batches = inner->snapshot();
+  ASSERT_EQ(batches.size(), 3u);
+  EXPECT_EQ(batches[2], (std::vector<uint64_t>{6}));
+  EXPECT_EQ(batching.stats().frames, 7u);
+  EXPECT_EQ(batching.stats().timed_out, 0u);
+}
+
+// 不满一批的帧等待超时后由定时线程处理
+TEST_F(BatchingFrameProcessorTests, PartialBatchIsProcessedAfterDelay) {
+  BatchingFrameProcessor batching(inner, {8, std::chrono::milliseconds(5)});
+  batching.process(*make_frame(1));
+  batching.process(*make_frame(2));
+
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (inner->snapshot().empty() &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto batches = inner->snapshot();
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[0], (std::vector<uint64_t>{1, 2}));
+  EXPECT_EQ(batching.stats().timed_out, 1u);
+}
+
+// 等待中的帧在处理前保持存活，即使调用方已经释放
+TEST_F(BatchingFrameProcessorTests, PendingFramesAreRetained) {
+  BatchingFrameProcessor batching(inner, {4, std::chrono::seconds(10)});
+  std::weak_ptr<CapturedFrame> weak;
+  {
+    auto frame = make_frame(9);
+    weak = frame;
+    batching.process(*frame);
+  }
+  EXPECT_FALSE(weak.expired());
+
+  batching.flush();
+  EXPECT_TRUE(weak.expired());
+}
+
+// 最后一个拷贝析构时处理剩余的帧
+TEST_F(BatchingFrameProcessorTests, DestructionFlushesPendingFrames) {
+  {
+    BatchingFrameProcessor batching(inner, {4, std::chrono::seconds(10)});
+    auto copy = batching;
+    batching.process(*make_frame(1));
+    copy.process(*make_frame(2));
+  }
+
+  auto batches = inner->snapshot();
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[0], (std::vector<uint64_t>{1, 2}));
+}
+
+// 默认的 process_batch 逐帧调用 process
+TEST_F(BatchingFrameProcessorTests, DefaultProcessBatchCallsProcess) {
+  std::vector<uint64_t> seen;
+  auto processor = make_function_processor(
+      [&seen](const CapturedFrame& frame) { seen.push_back(frame.sequence); });
+
+  auto a = make_frame(4);
+  auto b = make_frame(5);
+  const CapturedFrame* frames[] = {a.get(), b.get()};
+  processor.process_batch(frames);
+
+  EXPECT_EQ(seen, (std::vector<uint64_t>{4, 5}));
+}
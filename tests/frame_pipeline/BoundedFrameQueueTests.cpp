@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "BoundedFrameQueue.hpp"
+
+namespace {
+
+CapturedFramePtr make_frame(unsigned int id) {
+  auto frame = std::make_shared<CapturedFrame>();
+  frame->meta.uFrameID = id;
+  return frame;
+}
+
+}  // namespace
+
+// 测试有界帧队列在各种背压策略下的准入行为
+class BoundedFrameQueueTests : public ::testing::Test {
+ protected:
+  static constexpr size_t kCapacity = 3;
+
+  FrameAdmissionConfig config(BackpressurePolicy policy) const {
+    FrameAdmissionConfig cfg;
+    cfg.policy = policy;
+    cfg.block_timeout = std::chrono::microseconds(1000);
+    cfg.keep_every_n = 2;
+    return cfg;
+  }
+};
+
+// 未满时正常入队
+TEST_F(BoundedFrameQueueTests, AdmitsUntilFull) {
+  BoundedFrameQueue queue(kCapacity, BackpressurePolicy::DropNewest);
+  for (unsigned int i = 0; i < kCapacity; ++i) {
+    EXPECT_EQ(queue.push(make_frame(i)),
+              BoundedFrameQueue::Admission::Admitted);
+  }
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(queue.stats().admitted, kCapacity);
+  EXPECT_EQ(queue.stats().depth, kCapacity);
+}
+
+// DropOldest：队列保留最新的帧
+TEST_F(BoundedFrameQueueTests, DropOldestKeepsNewestFrames) {
+  BoundedFrameQueue queue(kCapacity, BackpressurePolicy::DropOldest);
+  for (unsigned int i = 0; i < 5; ++i) {
+    queue.push(make_frame(i));
+  }
+  auto stats = queue.stats();
+  EXPECT_EQ(stats.dropped_oldest, 2u);
+  EXPECT_EQ(stats.depth, kCapacity);
+
+  CapturedFramePtr frame;
+  ASSERT_TRUE(queue.try_pop(frame));
+  EXPECT_EQ(frame->meta.uFrameID, 2u);
+}
+
+// DropNewest：新帧被拒绝，旧帧不动
+TEST_F(BoundedFrameQueueTests, DropNewestRejectsArrivals) {
+  BoundedFrameQueue queue(kCapacity, BackpressurePolicy::DropNewest);
+  for (unsigned int i = 0; i < 5; ++i) {
+    queue.push(make_frame(i));
+  }
+  EXPECT_EQ(queue.stats().dropped_newest, 2u);
+
+  CapturedFramePtr frame;
+  ASSERT_TRUE(queue.try_pop(frame));
+  EXPECT_EQ(frame->meta.uFrameID, 0u);
+}
+
+// BlockWithTimeout：没有消费者时超时丢弃
+TEST_F(BoundedFrameQueueTests, BlockWithTimeoutGivesUp) {
+  BoundedFrameQueue queue(kCapacity, BackpressurePolicy::DropNewest);
+  queue.configure(kCapacity, config(BackpressurePolicy::BlockWithTimeout));
+  for (unsigned int i = 0; i < kCapacity; ++i) {
+    queue.push(make_frame(i));
+  }
+  EXPECT_EQ(queue.push(make_frame(9)), BoundedFrameQueue::Admission::Rejected);
+  EXPECT_EQ(queue.stats().timed_out, 1u);
+}
+
+// KeepEveryNth：积压期间每 N 帧保留一帧
+TEST_F(BoundedFrameQueueTests, KeepEveryNthDecimates) {
+  BoundedFrameQueue queue(kCapacity, BackpressurePolicy::DropNewest);
+  queue.configure(kCapacity, config(BackpressurePolicy::KeepEveryNth));
+  for (unsigned int i = 0; i < kCapacity + 4; ++i) {
+    queue.push(make_frame(i));
+  }
+  auto stats = queue.stats();
+  EXPECT_EQ(stats.dropped_oldest, 2u);
+  EXPECT_EQ(stats.decimated, 2u);
+  EXPECT_EQ(stats.depth, kCapacity);
+}
+
+// 被拒绝的新帧和被挤掉的旧帧都交给丢帧回调
+TEST_F(BoundedFrameQueueTests, DropHandlerSeesEveryDroppedFrame) {
+  std::vector<unsigned int> dropped;
+  BoundedFrameQueue queue(kCapacity, BackpressurePolicy::DropOldest);
+  queue.set_drop_handler([&dropped](const CapturedFramePtr& frame) {
+    dropped.push_back(frame->meta.uFrameID);
+  });
+  for (unsigned int i = 0; i < kCapacity + 1; ++i) {
+    queue.push(make_frame(i));
+  }
+  queue.configure(kCapacity, config(BackpressurePolicy::DropNewest));
+  queue.push(make_frame(9));
+  EXPECT_EQ(dropped, (std::vector<unsigned int>{0, 9}));
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "FrameBufferPool.hpp"
+
+// 测试帧缓冲池的回收与复用
+class FrameBufferPoolTests : public ::testing::Test {
+ protected:
+  static constexpr size_t kSlabBytes = 4096;
+  std::shared_ptr<FrameBufferPool> pool;
+
+  void SetUp() override { pool = FrameBufferPool::create(kSlabBytes, 4); }
+};
+
+// 最后一个引用释放后，同一块 slab 会被下一次 acquire 复用
+TEST_F(FrameBufferPoolTests, ReleasedFrameIsReused) {
+  const CapturedFrame* first_address = nullptr;
+  const uint8_t* first_buffer = nullptr;
+  {
+    auto frame = pool->acquire(kSlabBytes);
+    frame->data.assign(kSlabBytes, 0x7f);
+    first_address = frame.get();
+    first_buffer = frame->data.data();
+  }
+
+  auto frame = pool->acquire(kSlabBytes);
+  EXPECT_EQ(frame.get(), first_address);
+  EXPECT_EQ(frame->data.data(), first_buffer);
+  EXPECT_TRUE(frame->data.empty());
+  EXPECT_GE(frame->data.capacity(), kSlabBytes);
+  EXPECT_EQ(pool->stats().total_slabs, 1u);
+}
+
+// 多个共享引用都释放之后才归还
+TEST_F(FrameBufferPoolTests, SharedReferencesKeepFrameAlive) {
+  auto frame = pool->acquire(kSlabBytes);
+  CapturedFramePtr algo_ref = frame;
+  CapturedFramePtr queue_ref = frame;
+  frame.reset();
+  algo_ref.reset();
+  EXPECT_EQ(pool->stats().free_slabs, 0u);
+  queue_ref.reset();
+  EXPECT_EQ(pool->stats().free_slabs, 1u);
+}
+
+// 超过上限时临时分配，不扩大池
+TEST_F(FrameBufferPoolTests, OverflowDoesNotGrowPool) {
+  std::vector<std::shared_ptr<CapturedFrame>> held;
+  for (int i = 0; i < 6; ++i) {
+    held.push_back(pool->acquire(kSlabBytes));
+  }
+  auto stats = pool->stats();
+  EXPECT_EQ(stats.total_slabs, 4u);
+  EXPECT_EQ(stats.overflow, 2u);
+
+  held.clear();
+  EXPECT_EQ(pool->stats().free_slabs, 4u);
+}
+
+// 池先析构时，帧依然可以安全释放
+TEST_F(FrameBufferPoolTests, FrameOutlivesPool) {
+  auto frame = pool->acquire(kSlabBytes);
+  pool.reset();
+  frame->data.assign(16, 1);
+  frame.reset();
+  SUCCEED();
+}
+
+// 预分配后采集过程中不再创建新 slab
+TEST_F(FrameBufferPoolTests, ReserveAllocatesUpFront) {
+  pool->reserve(kSlabBytes * 2, 3);
+  EXPECT_EQ(pool->stats().total_slabs, 3u);
+  EXPECT_EQ(pool->stats().slab_bytes, kSlabBytes * 2);
+
+  auto frame = pool->acquire(kSlabBytes * 2);
+  EXPECT_GE(frame->data.capacity(), kSlabBytes * 2);
+  EXPECT_EQ(pool->stats().total_slabs, 3u);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "FrameProcessor.hpp"
+
+// 测试对齐帧缓冲区和像素格式描述
+class FrameBufferTests : public ::testing::Test {
+ protected:
+  std::vector<uint8_t> source = std::vector<uint8_t>(1000, 0x5a);
+};
+
+// 起始地址对齐，容量向上取整
+TEST_F(FrameBufferTests, StorageIsAligned) {
+  FrameBuffer buffer;
+  buffer.assign(source.data(), source.data() + source.size());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) %
+                FrameBuffer::kAlignment,
+            0u);
+  EXPECT_EQ(buffer.size(), source.size());
+  EXPECT_EQ(buffer.capacity() % FrameBuffer::kAlignment, 0u);
+  EXPECT_EQ(buffer.data()[999], 0x5a);
+}
+
+// 容量足够时复用原有存储
+TEST_F(FrameBufferTests, ReusesCapacity) {
+  FrameBuffer buffer;
+  buffer.reserve(4096);
+  const uint8_t* storage = buffer.data();
+  buffer.assign(source.data(), source.data() + source.size());
+  buffer.clear();
+  buffer.resize_uninitialized(2048);
+  EXPECT_EQ(buffer.data(), storage);
+  EXPECT_EQ(buffer.size(), 2048u);
+}
+
+// 拷贝是深拷贝，移动转移存储
+TEST_F(FrameBufferTests, CopyAndMove) {
+  FrameBuffer original;
+  original.assign(16, 7);
+  FrameBuffer copy = original;
+  EXPECT_NE(copy.data(), original.data());
+  EXPECT_EQ(copy.data()[15], 7);
+
+  const uint8_t* storage = original.data();
+  FrameBuffer moved = std::move(original);
+  EXPECT_EQ(moved.data(), storage);
+  EXPECT_EQ(moved.size(), 16u);
+}
+
+// SDK 格式到像素格式的映射
+TEST_F(FrameBufferTests, MapsSdkFormats) {
+  EXPECT_EQ(pixel_format_from_frame(FORMAT_MONO, BITS_8), PixelFormat::Mono8);
+  EXPECT_EQ(pixel_format_from_frame(FORMAT_MONO, BITS_12),
+            PixelFormat::Mono16);
+  EXPECT_EQ(pixel_format_from_frame(FORMAT_BAYER_RG, BITS_8),
+            PixelFormat::BayerRG8);
+  EXPECT_EQ(pixel_format_from_frame(FORMAT_BGR32, BITS_8), PixelFormat::BGR32);
+  // 以 S_RGB64 输出的帧，SDK 头文件里没有对应的 FORMAT_ 枚举值
+  EXPECT_EQ(pixel_format_from_frame(static_cast<dvpImageFormat>(S_RGB64),
+                                    BITS_16),
+            PixelFormat::RGB64);
+  EXPECT_EQ(pixel_format_from_stream(S_RAW8), PixelFormat::Unknown);
+  EXPECT_EQ(bytes_per_pixel(S_RAW8), 1u);
+  EXPECT_EQ(bytes_per_pixel(S_B8_G8_R8), 3u);
+  EXPECT_EQ(bytes_per_pixel(PixelFormat::BGR48), 6u);
+  EXPECT_EQ(channel_count(PixelFormat::BayerGB16), 1);
+}
+
+// 由 meta 推出格式和行步长
+TEST_F(FrameBufferTests, FrameLayoutFromMeta) {
+  CapturedFrame frame;
+  frame.meta.format = FORMAT_BGR24;
+  frame.meta.bits = BITS_8;
+  frame.meta.iWidth = 100;
+  frame.meta.iHeight = 10;
+  frame.meta.uBytes = 3000;
+  frame.update_layout();
+  EXPECT_EQ(frame.pixel_format, PixelFormat::BGR24);
+  EXPECT_EQ(frame.stride, 300u);
+}
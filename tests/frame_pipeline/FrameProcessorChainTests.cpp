@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FrameProcessorChain.hpp"
+
+namespace {
+
+class CountingProcessor : public FrameProcessor {
+ public:
+  void process(const CapturedFrame& frame) override {
+    ++calls;
+    last_frame = &frame;
+  }
+  std::atomic<int> calls{0};
+  const CapturedFrame* last_frame = nullptr;
+};
+
+}  // namespace
+
+// 测试处理阶段链
+class FrameProcessorChainTests : public ::testing::Test {
+ protected:
+  FrameProcessorChain chain;
+  std::shared_ptr<CountingProcessor> first =
+      std::make_shared<CountingProcessor>();
+  std::shared_ptr<CountingProcessor> second =
+      std::make_shared<CountingProcessor>();
+  CapturedFramePtr frame = std::make_shared<CapturedFrame>();
+};
+
+// 通过基类指针调用派生类，不会被切片
+TEST_F(FrameProcessorChainTests, KeepsDerivedProcessors) {
+  std::shared_ptr<FrameProcessor> base = first;
+  chain.add(base);
+  chain.process(*frame);
+  EXPECT_EQ(first->calls.load(), 1);
+}
+
+// 禁用的阶段不再收到帧
+TEST_F(FrameProcessorChainTests, DisabledStageIsSkipped) {
+  chain.add(first, "first");
+  chain.add(second, "second");
+  EXPECT_TRUE(chain.set_enabled("second", false));
+  chain.process(*frame);
+  EXPECT_EQ(first->calls.load(), 1);
+  EXPECT_EQ(second->calls.load(), 0);
+
+  EXPECT_TRUE(chain.set_enabled(1, true));
+  EXPECT_FALSE(chain.set_enabled(5, true));
+  chain.process(*frame);
+  EXPECT_EQ(second->calls.load(), 1);
+}
+
+// 并行分发：所有阶段看到同一帧，全部结束后 done 只调用一次
+TEST_F(FrameProcessorChainTests, FanOutSharesFrame) {
+  chain.add(first);
+  chain.add(second);
+
+  std::vector<std::thread> workers;
+  std::atomic<int> done_calls{0};
+  chain.fan_out(
+      frame,
+      [&workers](std::function<void()> task) {
+        workers.emplace_back(std::move(task));
+      },
+      [&done_calls](const CapturedFramePtr&) { ++done_calls; });
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(first->last_frame, frame.get());
+  EXPECT_EQ(second->last_frame, frame.get());
+  EXPECT_EQ(done_calls.load(), 1);
+}
+
+// 快照不受之后修改的影响
+TEST_F(FrameProcessorChainTests, SnapshotIsStable) {
+  chain.add(first);
+  auto snapshot = chain.snapshot();
+  chain.add(second);
+  EXPECT_EQ(snapshot->size(), 1u);
+  EXPECT_EQ(chain.size(), 2u);
+  EXPECT_TRUE(chain.contains(second));
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FrameBufferPool.hpp"
+#include "FrameFile.hpp"
+#include "FrameRecorder.hpp"
+
+// 测试录像阶段：写入分段文件后能被读取器原样读回
+class FrameRecorderTests : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = 32;
+  static constexpr int kHeight = 8;
+
+  std::filesystem::path dir;
+  std::shared_ptr<FrameBufferPool> pool = FrameBufferPool::create();
+
+  void SetUp() override {
+    dir = std::filesystem::temp_directory_path() /
+          (std::string("recorder_") +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  RecorderConfig config() const {
+    RecorderConfig cfg;
+    cfg.directory = dir.string();
+    cfg.segment_bytes = 4096;  // 每个分段只能放下几帧，强制换分段
+    return cfg;
+  }
+
+  // 池中的 Mono8 帧，每个像素为 sequence
+  std::shared_ptr<CapturedFrame> make_frame(uint64_t sequence) {
+    auto frame = pool->acquire(kWidth * kHeight);
+    frame->meta.format = FORMAT_MONO;
+    frame->meta.bits = BITS_8;
+    frame->meta.iWidth = kWidth;
+    frame->meta.iHeight = kHeight;
+    frame->meta.uBytes = kWidth * kHeight;
+    frame->meta.uFrameID = sequence * 10;
+    frame->meta.uTimestamp = sequence * 1000;
+    frame->sequence = sequence;
+    frame->data.assign(static_cast<size_t>(kWidth * kHeight),
+                       static_cast<uint8_t>(sequence));
+    frame->update_layout();
+    return frame;
+  }
+};
+
+// 多个分段按顺序读回，数据和 dvpFrame 都保持不变
+TEST_F(FrameRecorderTests, RoundTripsAcrossSegments) {
+  FrameRecorder recorder(config());
+  ASSERT_TRUE(recorder.start());
+  for (uint64_t i = 0; i < 20; ++i) {
+    recorder.process(*make_frame(i));
+  }
+  recorder.stop();
+
+  const auto stats = recorder.stats();
+  EXPECT_EQ(stats.frames + stats.dropped, 20u);
+  EXPECT_GT(stats.segments, 1u);
+
+  const auto segments = frame_file::list_segments(dir.string());
+  ASSERT_EQ(segments.size(), stats.segments);
+
+  FrameFileReader reader(segments);
+  CapturedFrame frame;
+  uint64_t read = 0;
+  uint64_t last_sequence = 0;
+  while (reader.next(frame)) {
+    EXPECT_TRUE(read == 0 || frame.sequence > last_sequence);
+    EXPECT_EQ(frame.meta.uFrameID, frame.sequence * 10);
+    EXPECT_EQ(frame.width(), kWidth);
+    EXPECT_EQ(frame.data.size(), static_cast<size_t>(kWidth * kHeight));
+    EXPECT_EQ(frame.data.data()[kWidth], static_cast<uint8_t>(frame.sequence));
+    last_sequence = frame.sequence;
+    ++read;
+  }
+  EXPECT_EQ(read, stats.frames);
+}
+
+// 索引记录每一帧在分段中的位置
+TEST_F(FrameRecorderTests, IndexPointsAtRecords) {
+  FrameRecorder recorder(config());
+  ASSERT_TRUE(recorder.start());
+  for (uint64_t i = 0; i < 3; ++i) {
+    recorder.process(*make_frame(i));
+  }
+  recorder.stop();
+
+  const auto segments = frame_file::list_segments(dir.string());
+  ASSERT_FALSE(segments.empty());
+  const auto index = frame_file::load_index(segments.front());
+  ASSERT_FALSE(index.empty());
+  EXPECT_EQ(index[0].offset, sizeof(frame_file::FrameFileHeader));
+  EXPECT_EQ(index[0].timestamp_us, index[0].sequence * 1000);
+  if (index.size() > 1) {
+    EXPECT_EQ(index[1].offset,
+              index[0].offset + frame_file::record_bytes(kWidth * kHeight));
+  }
+
+  // 关闭时分段被截断到实际写入的大小
+  EXPECT_EQ(std::filesystem::file_size(segments.front()),
+            index.back().offset + frame_file::record_bytes(kWidth * kHeight));
+}
+
+// 单帧超过分段上限时丢弃而不是写坏文件
+TEST_F(FrameRecorderTests, OversizedFrameIsDropped) {
+  auto cfg = config();
+  cfg.segment_bytes = 256;
+  FrameRecorder recorder(cfg);
+  ASSERT_TRUE(recorder.start());
+  recorder.process(*make_frame(1));
+  recorder.stop();
+
+  EXPECT_EQ(recorder.stats().frames, 0u);
+  EXPECT_EQ(recorder.stats().dropped, 1u);
+}
+
+// 录像期间帧被 recorder 持有，写完后归还缓冲池
+TEST_F(FrameRecorderTests, FramesReturnToPoolAfterWrite) {
+  FrameRecorder recorder(config());
+  ASSERT_TRUE(recorder.start());
+  for (uint64_t i = 0; i < 4; ++i) {
+    recorder.process(*make_frame(i));
+  }
+  recorder.stop();
+  EXPECT_EQ(pool->stats().free_slabs, pool->stats().total_slabs);
+}
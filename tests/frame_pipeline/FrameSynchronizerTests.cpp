@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "FrameSynchronizer.hpp"
+#include "MultiCameraCoordinator.hpp"
+
+// 测试多相机帧按时间戳配组
+class FrameSynchronizerTests : public ::testing::Test {
+ protected:
+  std::mutex mutex;
+  std::condition_variable arrived;
+  std::vector<FrameSynchronizer::FrameSet> sets;
+
+  FrameSynchronizer::SetHandler collector() {
+    return [this](FrameSynchronizer::FrameSet&& set) {
+      std::lock_guard lock(mutex);
+      sets.push_back(std::move(set));
+      arrived.notify_all();
+    };
+  }
+
+  bool wait_for_sets(size_t count) {
+    std::unique_lock lock(mutex);
+    return arrived.wait_for(lock, std::chrono::seconds(5),
+                            [&] { return sets.size() >= count; });
+  }
+
+  static CapturedFramePtr frame(uint64_t timestamp) {
+    auto f = std::make_shared<CapturedFrame>();
+    f->meta.uTimestamp = timestamp;
+    f->meta.uFrameID = timestamp / 1000;
+    return f;
+  }
+};
+
+TEST_F(FrameSynchronizerTests, MatchesFramesWithinTolerance) {
+  SyncOptions options;
+  options.tolerance = 500;
+  FrameSynchronizer sync(2, options, collector());
+
+  sync.push(1, frame(10100));
+  sync.push(0, frame(10000));
+  ASSERT_TRUE(wait_for_sets(1));
+
+  std::lock_guard lock(mutex);
+  ASSERT_EQ(sets[0].size(), 2u);
+  EXPECT_EQ(sets[0][0]->meta.uTimestamp, 10000u);
+  EXPECT_EQ(sets[0][1]->meta.uTimestamp, 10100u);
+  EXPECT_EQ(sync.stats().matched, 1u);
+}
+
+// 快相机多出来的帧不会和慢相机的帧错配
+TEST_F(FrameSynchronizerTests, FasterCameraDoesNotMismatch) {
+  SyncOptions options;
+  options.tolerance = 100;
+  options.timeout = std::chrono::seconds(10);
+  FrameSynchronizer sync(2, options, collector());
+
+  for (uint64_t ts : {1000, 2000, 3000}) {
+    sync.push(0, frame(ts));
+  }
+  sync.push(1, frame(2050));
+  ASSERT_TRUE(wait_for_sets(1));
+
+  std::lock_guard lock(mutex);
+  ASSERT_EQ(sets.size(), 1u);
+  EXPECT_EQ(sets[0][0]->meta.uTimestamp, 2000u);
+  EXPECT_EQ(sets[0][1]->meta.uTimestamp, 2050u);
+  EXPECT_EQ(sync.stats().unmatched, 1u);
+}
+
+TEST_F(FrameSynchronizerTests, MatchesByFrameId) {
+  SyncOptions options;
+  options.key = SyncKey::FrameId;
+  options.tolerance = 0;
+  FrameSynchronizer sync(2, options, collector());
+
+  sync.push(0, frame(5000));
+  sync.push(1, frame(5900));  // 时间戳差得远，帧号相同
+  ASSERT_TRUE(wait_for_sets(1));
+  EXPECT_EQ(sync.stats().matched, 1u);
+}
+
+// 相机掉线时超时交付已到的帧
+TEST_F(FrameSynchronizerTests, TimeoutEmitsPartialSet) {
+  SyncOptions options;
+  options.timeout = std::chrono::milliseconds(20);
+  options.partial_policy = PartialPolicy::Emit;
+  FrameSynchronizer sync(2, options, collector());
+
+  sync.push(0, frame(1000));
+  ASSERT_TRUE(wait_for_sets(1));
+
+  std::lock_guard lock(mutex);
+  ASSERT_TRUE(sets[0][0]);
+  EXPECT_FALSE(sets[0][1]);
+  EXPECT_EQ(sync.stats().partial, 1u);
+}
+
+TEST_F(FrameSynchronizerTests, TimeoutDropsPartialSet) {
+  SyncOptions options;
+  options.timeout = std::chrono::milliseconds(10);
+  FrameSynchronizer sync(2, options, collector());
+
+  sync.push(0, frame(1000));
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (sync.stats().timed_out == 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(sync.stats().timed_out, 1u);
+  std::lock_guard lock(mutex);
+  EXPECT_TRUE(sets.empty());
+}
+
+TEST_F(FrameSynchronizerTests, FullRingDropsOldest) {
+  SyncOptions options;
+  options.ring_capacity = 2;
+  options.timeout = std::chrono::seconds(10);
+  FrameSynchronizer sync(2, options, collector());
+
+  for (uint64_t ts : {1000, 2000, 3000}) {
+    sync.push(0, frame(ts));
+  }
+  EXPECT_EQ(sync.stats().ring_overflow, 1u);
+
+  sync.push(1, frame(2000));
+  ASSERT_TRUE(wait_for_sets(1));
+  std::lock_guard lock(mutex);
+  EXPECT_EQ(sets[0][0]->meta.uTimestamp, 2000u);
+}
+
+// 融合在同步器线程上执行，栈上的帧也能安全交给协调器
+TEST_F(FrameSynchronizerTests, CoordinatorFusesMatchedFrames) {
+  MultiCameraCoordinator coordinator(
+      2, [this](const std::vector<CapturedFrame>& frames) {
+        std::lock_guard lock(mutex);
+        FrameSynchronizer::FrameSet set;
+        for (const auto& f : frames) {
+          set.push_back(std::make_shared<CapturedFrame>(f));
+        }
+        sets.push_back(std::move(set));
+        arrived.notify_all();
+        return frames[0];
+      });
+
+  CapturedFrame a;
+  a.meta.uTimestamp = 7000;
+  CapturedFrame b;
+  b.meta.uTimestamp = 7200;
+  coordinator[0]->process(a);
+  coordinator[1]->process(b);
+  ASSERT_TRUE(wait_for_sets(1));
+
+  std::lock_guard lock(mutex);
+  EXPECT_EQ(sets[0][1]->meta.uTimestamp, 7200u);
+  EXPECT_EQ(coordinator.sync_stats().matched, 1u);
+}
+
+// 回调抛出的异常被计数，同步线程继续交付之后的组
+TEST_F(FrameSynchronizerTests, HandlerExceptionIsCounted) {
+  bool thrown = false;
+  FrameSynchronizer sync(
+      1, SyncOptions{}, [this, &thrown](FrameSynchronizer::FrameSet&& set) {
+        if (!thrown) {
+          thrown = true;
+          throw std::runtime_error("fusion failed");
+        }
+        collector()(std::move(set));
+      });
+
+  sync.push(0, frame(1000));
+  sync.push(0, frame(2000));
+  ASSERT_TRUE(wait_for_sets(1));
+  std::lock_guard lock(mutex);
+  EXPECT_EQ(sets[0][0]->meta.uTimestamp, 2000u);
+  EXPECT_EQ(sync.stats().handler_errors, 1u);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "ProcessingExecutor.hpp"
+
+// 测试共享执行器的 worker 预算分配
+class ProcessingExecutorTests : public ::testing::Test {
+ protected:
+  ProcessingExecutor& executor = ProcessingExecutor::instance();
+
+  void SetUp() override {
+    ExecutorConfig cfg;
+    cfg.total_workers = 8;
+    cfg.expected_lanes = 4;
+    cfg.opencv_threads = -1;
+    executor.configure(cfg);
+  }
+};
+
+// 未指定预算时按预计相机数平分
+TEST_F(ProcessingExecutorTests, DefaultBudgetSplitsWorkers) {
+  auto lane = executor.acquire_lane();
+  EXPECT_EQ(lane->worker_count(), 2u);
+  EXPECT_EQ(executor.workers_in_use(), 2u);
+}
+
+// lane 释放后归还 worker
+TEST_F(ProcessingExecutorTests, ReleasedLaneReturnsWorkers) {
+  {
+    auto lane = executor.acquire_lane(WorkerBudget{3, {}});
+    EXPECT_EQ(executor.workers_in_use(), 3u);
+  }
+  EXPECT_EQ(executor.workers_in_use(), 0u);
+}
+
+// 总数不超过预算，预算用完后仍保底 1 个 worker
+TEST_F(ProcessingExecutorTests, BudgetIsCapped) {
+  auto big = executor.acquire_lane(WorkerBudget{6, {}});
+  auto rest = executor.acquire_lane(WorkerBudget{6, {}});
+  auto extra = executor.acquire_lane(WorkerBudget{2, {}});
+  EXPECT_EQ(big->worker_count(), 6u);
+  EXPECT_EQ(rest->worker_count(), 2u);
+  // 预算用完后共用已有的 worker，不再超出总数
+  EXPECT_TRUE(extra->shares_workers_with(*big) ||
+              extra->shares_workers_with(*rest));
+  EXPECT_EQ(executor.workers_in_use(), 8u);
+}
+
+// 共用 worker 的 lane 各自等待自己的任务，最后一个释放时才归还预算
+TEST_F(ProcessingExecutorTests, SharedLaneKeepsWorkersUntilLastRelease) {
+  auto all = executor.acquire_lane(WorkerBudget{8, {}});
+  auto shared = executor.acquire_lane(WorkerBudget{2, {}});
+  ASSERT_TRUE(shared->shares_workers_with(*all));
+
+  std::atomic<int> counter{0};
+  shared->detach([&counter]() { ++counter; });
+  shared->wait();
+  EXPECT_EQ(counter.load(), 1);
+
+  all.reset();
+  EXPECT_EQ(executor.workers_in_use(), 8u);
+  shared.reset();
+  EXPECT_EQ(executor.workers_in_use(), 0u);
+}
+
+// 显式指定的核心与已占用的核心重叠时改为顺序分配
+TEST_F(ProcessingExecutorTests, OverlappingCpusAreNotShared) {
+  ExecutorConfig cfg;
+  cfg.total_workers = 4;
+  cfg.pin_threads = true;
+  cfg.opencv_threads = -1;
+  executor.configure(cfg);
+
+  auto first = executor.acquire_lane(WorkerBudget{1, {0}});
+  auto second = executor.acquire_lane(WorkerBudget{1, {0}});
+  ASSERT_EQ(first->cpus(), (std::vector<int>{0}));
+  for (int cpu : second->cpus()) {
+    EXPECT_NE(cpu, 0);
+  }
+}
+
+// 提交的任务都会执行
+TEST_F(ProcessingExecutorTests, LaneRunsTasks) {
+  std::atomic<int> counter{0};
+  auto lane = executor.acquire_lane(WorkerBudget{2, {}});
+  for (int i = 0; i < 16; ++i) {
+    lane->detach([&counter]() { ++counter; });
+  }
+  lane->wait();
+  EXPECT_EQ(counter.load(), 16);
+}
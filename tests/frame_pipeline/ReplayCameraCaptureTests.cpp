@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FrameFile.hpp"
+#include "cameras/ReplayCameraCapture.hpp"
+
+// 测试软件相机：从录像文件回放并驱动处理阶段
+class ReplayCameraCaptureTests : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = 8;
+  static constexpr int kHeight = 4;
+  static constexpr int kFrames = 5;
+
+  std::filesystem::path dir;
+  std::string recording;
+
+  std::mutex mutex;
+  std::vector<uint64_t> frame_ids;
+  std::vector<uint64_t> sequences;
+  std::vector<std::vector<uint8_t>> payloads;
+
+  void SetUp() override {
+    dir = std::filesystem::temp_directory_path() /
+          (std::string("replay_") +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::create_directories(dir);
+    recording = (dir / "roll_000000.dvpr").string();
+    write_recording(recording);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  // 按录像格式写 kFrames 帧 Mono8，第 i 帧每个像素为 i*16 + 列号
+  static void write_recording(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    const auto header = frame_file::make_file_header(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const size_t payload = kWidth * kHeight;
+    std::vector<char> record(frame_file::record_bytes(payload), 0);
+    for (int i = 0; i < kFrames; ++i) {
+      frame_file::FrameRecordHeader rec{};
+      rec.magic = frame_file::kRecordMagic;
+      rec.sequence = 100 + i;
+      rec.payload_bytes = payload;
+      rec.meta.format = FORMAT_MONO;
+      rec.meta.bits = BITS_8;
+      rec.meta.iWidth = kWidth;
+      rec.meta.iHeight = kHeight;
+      rec.meta.uBytes = payload;
+      rec.meta.uFrameID = i;
+      std::memcpy(record.data(), &rec, sizeof(rec));
+      char* pixels = record.data() + frame_file::record_header_bytes();
+      for (size_t p = 0; p < payload; ++p) {
+        pixels[p] = static_cast<char>(i * 16 + p % kWidth);
+      }
+      out.write(record.data(), static_cast<std::streamsize>(record.size()));
+    }
+  }
+
+  std::shared_ptr<FrameProcessor> recorder() {
+    return make_shared_function_processor([this](const CapturedFrame& frame) {
+      std::lock_guard lock(mutex);
+      frame_ids.push_back(frame.meta.uFrameID);
+      sequences.push_back(frame.sequence);
+      payloads.emplace_back(frame.data.begin(), frame.data.end());
+    });
+  }
+};
+
+// 读取器按顺序读出全部帧，meta 与写入时一致
+TEST_F(ReplayCameraCaptureTests, ReaderReadsAllRecords) {
+  FrameFileReader reader(frame_file::list_segments(dir.string()));
+  ASSERT_TRUE(reader.is_open());
+
+  CapturedFrame frame;
+  int count = 0;
+  while (reader.next(frame)) {
+    EXPECT_EQ(frame.sequence, 100u + count);
+    EXPECT_EQ(frame.width(), kWidth);
+    EXPECT_EQ(frame.pixel_format, PixelFormat::Mono8);
+    EXPECT_EQ(frame.stride, static_cast<size_t>(kWidth));
+    EXPECT_EQ(frame.data.data()[1], count * 16 + 1);
+    ++count;
+  }
+  EXPECT_EQ(count, kFrames);
+
+  ASSERT_TRUE(reader.rewind());
+  ASSERT_TRUE(reader.next(frame));
+  EXPECT_EQ(frame.meta.uFrameID, 0u);
+}
+
+// payload_bytes 与 meta 不符或超出文件的记录被拒绝，不再继续读这个分段
+TEST_F(ReplayCameraCaptureTests, ReaderRejectsBadPayloadSize) {
+  const size_t record = frame_file::record_bytes(kWidth * kHeight);
+  auto patch_payload = [&](int index, uint64_t payload_bytes) {
+    std::fstream file(recording,
+                      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(frame_file::FrameFileHeader) + index * record +
+               offsetof(frame_file::FrameRecordHeader, payload_bytes));
+    file.write(reinterpret_cast<const char*>(&payload_bytes),
+               sizeof(payload_bytes));
+  };
+
+  auto count_frames = [&]() {
+    FrameFileReader reader(frame_file::list_segments(dir.string()));
+    CapturedFrame frame;
+    int count = 0;
+    while (reader.next(frame)) {
+      ++count;
+    }
+    return count;
+  };
+
+  patch_payload(3, kWidth * kHeight + 1);
+  EXPECT_EQ(count_frames(), 3);
+
+  patch_payload(1, uint64_t{1} << 40);
+  EXPECT_EQ(count_frames(), 1);
+}
+
+// 不限速回放一遍：所有帧按顺序经过处理阶段和原始队列，序号重新编排
+TEST_F(ReplayCameraCaptureTests, ReplaysRecordingThroughPipeline) {
+  ReplayConfig config;
+  config.source = recording;
+  config.loop = false;
+  ReplayCameraCapture camera(config);
+  camera.set_worker_budget({1, {}});
+
+  ASSERT_TRUE(camera.start(recorder()));
+  ASSERT_TRUE(camera.wait_for_finish(std::chrono::seconds(5)));
+  camera.stop();
+
+  EXPECT_EQ(camera.frames_emitted(), static_cast<uint64_t>(kFrames));
+  ASSERT_EQ(frame_ids.size(), static_cast<size_t>(kFrames));
+  for (int i = 0; i < kFrames; ++i) {
+    EXPECT_EQ(frame_ids[i], static_cast<uint64_t>(i));
+    EXPECT_EQ(sequences[i], static_cast<uint64_t>(i));
+  }
+
+  CapturedFramePtr raw;
+  int queued = 0;
+  while (camera.get_frame_queue().try_dequeue(raw)) {
+    ++queued;
+  }
+  EXPECT_EQ(queued, kFrames);
+}
+
+// 循环播放并限制帧数
+TEST_F(ReplayCameraCaptureTests, LoopStopsAtMaxFrames) {
+  ReplayConfig config;
+  config.source = dir.string();
+  config.max_frames = 12;
+  ReplayCameraCapture camera(config);
+  camera.set_worker_budget({1, {}});
+
+  ASSERT_TRUE(camera.start(recorder()));
+  ASSERT_TRUE(camera.wait_for_finish(std::chrono::seconds(5)));
+  camera.stop();
+
+  ASSERT_EQ(frame_ids.size(), 12u);
+  EXPECT_EQ(frame_ids[kFrames], 0u);
+  EXPECT_EQ(frame_ids[11], 1u);
+}
+
+// ROI 在回放的帧上裁剪
+TEST_F(ReplayCameraCaptureTests, RoiCropsReplayedFrames) {
+  ReplayConfig config;
+  config.source = recording;
+  config.loop = false;
+  ReplayCameraCapture camera(config);
+  camera.set_worker_budget({1, {}});
+  camera.set_roi(2, 1, 3, 2);
+
+  ASSERT_TRUE(camera.start(recorder()));
+  ASSERT_TRUE(camera.wait_for_finish(std::chrono::seconds(5)));
+  camera.stop();
+
+  ASSERT_EQ(payloads.size(), static_cast<size_t>(kFrames));
+  const std::vector<uint8_t> expected = {2, 3, 4, 2, 3, 4};
+  EXPECT_EQ(payloads[0], expected);
+}
+
+// 按帧率节流
+TEST_F(ReplayCameraCaptureTests, FrameRateThrottlesOutput) {
+  ReplayConfig config;
+  config.source = recording;
+  config.loop = false;
+  config.fps = 100.0;
+  ReplayCameraCapture camera(config);
+  camera.set_worker_budget({1, {}});
+
+  const auto begin = std::chrono::steady_clock::now();
+  ASSERT_TRUE(camera.start(recorder()));
+  ASSERT_TRUE(camera.wait_for_finish(std::chrono::seconds(5)));
+  const auto elapsed = std::chrono::steady_clock::now() - begin;
+  camera.stop();
+
+  // 5 帧之间有 4 个 10ms 的间隔
+  EXPECT_GE(elapsed, std::chrono::milliseconds(35));
+}
+
+// 多个处理阶段的任务仍在执行时停止并析构，所有已开始的帧两个阶段都处理完
+TEST_F(ReplayCameraCaptureTests, ShutdownWaitsForFanOutTasks) {
+  std::atomic<int> first{0};
+  std::atomic<int> second{0};
+  auto slow_stage = [](std::atomic<int>& counter) {
+    return make_shared_function_processor([&counter](const CapturedFrame&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      ++counter;
+    });
+  };
+
+  for (int round = 0; round < 3; ++round) {
+    ReplayConfig config;
+    config.source = recording;
+    auto camera = std::make_unique<ReplayCameraCapture>(config);
+    camera->set_worker_budget({2, {}});
+    camera->add_frame_processor(slow_stage(first));
+    camera->add_frame_processor(slow_stage(second));
+    ASSERT_TRUE(camera->start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (round == 1) {
+      camera->stop();
+      camera->set_worker_budget({1, {}});  // 换预算同样要先等任务结束
+    }
+    camera.reset();
+    EXPECT_EQ(first.load(), second.load());
+  }
+  EXPECT_GT(first.load(), 0);
+}
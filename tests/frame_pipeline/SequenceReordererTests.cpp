@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "OrderedFrameProcessor.hpp"
+#include "SequenceReorderer.hpp"
+
+// 测试乱序结果的重排
+class SequenceReordererTests : public ::testing::Test {
+ protected:
+  std::vector<uint64_t> delivered;
+
+  SequenceReorderer<int> make(size_t max_pending) {
+    return SequenceReorderer<int>(
+        [this](uint64_t seq, int&&) { delivered.push_back(seq); },
+        max_pending);
+  }
+};
+
+// 乱序到达，按序交付
+TEST_F(SequenceReordererTests, DeliversInOrder) {
+  auto reorderer = make(8);
+  for (uint64_t seq : {2, 0, 3, 1, 4}) {
+    reorderer.push(seq, 0);
+  }
+  EXPECT_EQ(delivered, (std::vector<uint64_t>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(reorderer.pending(), 0u);
+}
+
+// 缺口等待超过窗口后被跳过
+TEST_F(SequenceReordererTests, SkipsGapWhenWindowOverflows) {
+  auto reorderer = make(2);
+  reorderer.push(1, 0);
+  reorderer.push(2, 0);
+  EXPECT_TRUE(delivered.empty());
+  reorderer.push(3, 0);
+  EXPECT_EQ(delivered, (std::vector<uint64_t>{1, 2, 3}));
+  EXPECT_EQ(reorderer.skipped(), 1u);
+
+  // 迟到的帧被丢弃
+  reorderer.push(0, 0);
+  EXPECT_EQ(reorderer.late(), 1u);
+  EXPECT_EQ(delivered.size(), 3u);
+}
+
+// 显式跳过丢弃的序号
+TEST_F(SequenceReordererTests, ExplicitSkipReleasesWaiting) {
+  auto reorderer = make(8);
+  reorderer.push(2, 0);
+  reorderer.skip(1);
+  EXPECT_TRUE(delivered.empty());
+  reorderer.skip(0);
+  EXPECT_EQ(delivered, (std::vector<uint64_t>{2}));
+  EXPECT_EQ(reorderer.skipped(), 2u);
+}
+
+// 包装的处理器先执行，再按序交付共享的帧
+TEST_F(SequenceReordererTests, OrderedProcessorSharesFrames) {
+  int processed = 0;
+  auto inner = std::make_shared<FunctionFrameProcessor<std::function<void(
+      const CapturedFrame&)>>>([&processed](const CapturedFrame&) {
+    ++processed;
+  });
+  std::vector<const CapturedFrame*> seen;
+  OrderedFrameProcessor ordered(
+      inner, [&seen](const CapturedFramePtr& f) { seen.push_back(f.get()); });
+
+  auto second = std::make_shared<CapturedFrame>();
+  second->sequence = 1;
+  auto first = std::make_shared<CapturedFrame>();
+  first->sequence = 0;
+  ordered.process(*second);
+  ordered.process(*first);
+
+  EXPECT_EQ(processed, 2);
+  ASSERT_EQ(seen.size(), 2u);
+  EXPECT_EQ(seen[0], first.get());
+  EXPECT_EQ(seen[1], second.get());
+}
+
+// 处理队列丢帧通知跳过缺口，不必等待窗口溢出
+TEST_F(SequenceReordererTests, OrderedProcessorSkipsDroppedFrames) {
+  std::vector<uint64_t> seen;
+  OrderedFrameProcessor ordered(nullptr, [&seen](const CapturedFramePtr& f) {
+    seen.push_back(f->sequence);
+  });
+
+  auto frame = std::make_shared<CapturedFrame>();
+  frame->sequence = 1;
+  ordered.process(*frame);
+  EXPECT_TRUE(seen.empty());
+
+  ordered.on_dropped(0);
+  EXPECT_EQ(seen, (std::vector<uint64_t>{1}));
+  EXPECT_EQ(ordered.reorderer().skipped(), 1u);
+}
+
+// sink 在锁外调用，可以在 sink 里再次 push 而不会死锁，顺序仍然正确
+TEST_F(SequenceReordererTests, SinkRunsOutsideLock) {
+  SequenceReorderer<int>* self = nullptr;
+  SequenceReorderer<int> reorderer(
+      [&](uint64_t seq, int&&) {
+        delivered.push_back(seq);
+        EXPECT_EQ(self->pending(), 0u);
+        if (seq == 0) {
+          self->push(2, 0);
+        }
+      },
+      8);
+  self = &reorderer;
+  reorderer.push(1, 0);
+  reorderer.push(0, 0);
+  EXPECT_EQ(delivered, (std::vector<uint64_t>{0, 1, 2}));
+}
+
+// 析构时交付还在等待缺口的结果
+TEST_F(SequenceReordererTests, DestructorFlushesPending) {
+  {
+    auto reorderer = make(8);
+    reorderer.push(3, 0);
+    reorderer.push(1, 0);
+    EXPECT_TRUE(delivered.empty());
+  }
+  EXPECT_EQ(delivered, (std::vector<uint64_t>{1, 3}));
+}
+
+// 多个线程同时 push，交付仍然严格按序
+TEST_F(SequenceReordererTests, ConcurrentPushDeliversInOrder) {
+  constexpr uint64_t kCount = 4000;
+  constexpr uint64_t kThreads = 4;
+  auto reorderer = make(kCount);
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&reorderer, t]() {
+      for (uint64_t seq = t; seq < kCount; seq += kThreads) {
+        reorderer.push(seq, 0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(delivered.size(), kCount);
+  for (uint64_t i = 0; i < kCount; ++i) {
+    ASSERT_EQ(delivered[i], i);
+  }
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "StageTimings.hpp"
+
+// 测试阶段耗时统计：直方图精度、多线程汇总与后台输出
+class StageTimingsTests : public ::testing::Test {
+ protected:
+  StageTimings timings{{"preprocess", "merge"}};
+};
+
+// 每个值都落在上界不小于它、误差不超过 1/8 的桶里
+TEST_F(StageTimingsTests, BucketsBoundRelativeError) {
+  for (uint64_t v = 0; v < (uint64_t{1} << 36); v = v * 3 / 2 + 1) {
+    const size_t bucket = LatencyHistogram::bucket_of(v);
+    ASSERT_LT(bucket, LatencyHistogram::kBuckets);
+    const uint64_t upper = LatencyHistogram::bucket_upper(bucket);
+    EXPECT_GE(upper, v);
+    EXPECT_LE(upper - v, v / 8 + 1) << v;
+  }
+}
+
+// 分位数与已知分布一致
+TEST_F(StageTimingsTests, PercentilesFollowDistribution) {
+  using std::chrono::microseconds;
+  for (int i = 1; i <= 100; ++i) {
+    timings.record(0, microseconds(i));
+  }
+  const auto stats = timings.snapshot();
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].stage, "preprocess");
+  EXPECT_EQ(stats[0].count, 100u);
+  EXPECT_NEAR(stats[0].mean_us, 50.5, 1e-9);
+  EXPECT_NEAR(stats[0].p50_us, 50.0, 50.0 / 8);
+  EXPECT_NEAR(stats[0].p99_us, 99.0, 99.0 / 8);
+  EXPECT_DOUBLE_EQ(stats[0].max_us, 100.0);
+  EXPECT_EQ(stats[1].count, 0u);
+}
+
+// 多个线程各写自己的分片，汇总时不丢计数
+TEST_F(StageTimingsTests, ConcurrentWritersAreAggregated) {
+  constexpr int kThreads = 4;
+  constexpr int kRecords = 5000;
+  std::atomic<bool> done{false};
+  std::thread reader([&] {
+    while (!done.load()) {
+      timings.snapshot();
+    }
+  });
+  std::vector<std::thread> writers;
+  for (int t = 0; t < kThreads; ++t) {
+    writers.emplace_back([&, t] {
+      for (int i = 0; i < kRecords; ++i) {
+        timings.record(t % 2, std::chrono::nanoseconds(1000 + i));
+      }
+    });
+  }
+  for (auto& w : writers) {
+    w.join();
+  }
+  done = true;
+  reader.join();
+
+  const auto stats = timings.snapshot();
+  EXPECT_EQ(stats[0].count + stats[1].count,
+            static_cast<uint64_t>(kThreads) * kRecords);
+}
+
+// 后台线程定期调用 sink，stop() 不必等满一个周期
+TEST_F(StageTimingsTests, ReporterDeliversSnapshots) {
+  timings.record(1, std::chrono::microseconds(3));
+  std::atomic<int> calls{0};
+  StageTimingReporter reporter;
+  reporter.start([this] { return timings.snapshot(); },
+                 [&](const std::vector<StageTimingStats>& stats) {
+                   EXPECT_EQ(stats[1].count, 1u);
+                   ++calls;
+                 },
+                 std::chrono::milliseconds(5));
+  while (calls.load() < 2) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto start = std::chrono::steady_clock::now();
+  reporter.start([this] { return timings.snapshot(); },
+                 [](const std::vector<StageTimingStats>&) {},
+                 std::chrono::hours(1));
+  reporter.stop();
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::seconds(1));
+}
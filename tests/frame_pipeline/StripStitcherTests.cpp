@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "MultiCameraCoordinator.hpp"
+#include "StripStitcher.hpp"
+
+// 测试多相机横向拼接
+class StripStitcherTests : public ::testing::Test {
+ protected:
+  // 像素值为 camera * 100 + x，便于检查每一列来自哪台相机
+  static CapturedFramePtr mono_frame(int camera, int width, int height,
+                                     uint64_t timestamp = 0) {
+    auto frame = std::make_shared<CapturedFrame>();
+    frame->pixel_format = PixelFormat::Mono8;
+    frame->stride = static_cast<size_t>(width);
+    frame->meta.iWidth = width;
+    frame->meta.iHeight = height;
+    frame->meta.uTimestamp = timestamp;
+    frame->data.resize_uninitialized(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        frame->data.data()[y * width + x] =
+            static_cast<uint8_t>(camera * 100 + x);
+      }
+    }
+    return frame;
+  }
+
+  static std::vector<uint8_t> row(const CapturedFrame& frame, int y) {
+    const uint8_t* begin = frame.data.data() + y * frame.stride;
+    return {begin, begin + frame.width()};
+  }
+};
+
+// 重叠区从中线切开
+TEST_F(StripStitcherTests, SlicesSplitOverlapAtMidline) {
+  const int widths[] = {100, 100};
+  const int offsets[] = {0, 80};
+  const auto slices = StripStitcher::slices_from_offsets(widths, offsets);
+
+  ASSERT_EQ(slices.size(), 2u);
+  EXPECT_EQ(slices[0].src_x, 0);
+  EXPECT_EQ(slices[0].width, 90);
+  EXPECT_EQ(slices[0].dst_x, 0);
+  EXPECT_EQ(slices[1].src_x, 10);
+  EXPECT_EQ(slices[1].width, 90);
+  EXPECT_EQ(slices[1].dst_x, 90);
+  EXPECT_EQ(StripStitcher(slices).output_width(), 180);
+}
+
+TEST_F(StripStitcherTests, RejectsGapsBetweenCameras) {
+  const int widths[] = {100, 100};
+  const int offsets[] = {0, 120};
+  EXPECT_THROW(StripStitcher::slices_from_offsets(widths, offsets),
+               std::invalid_argument);
+  EXPECT_THROW(StripStitcher({{0, 10, 0}, {0, 10, 12}}),
+               std::invalid_argument);
+}
+
+TEST_F(StripStitcherTests, StitchesEachSliceIntoOutput) {
+  const int widths[] = {4, 4};
+  const int offsets[] = {0, 2};
+  StripStitcher stitcher(StripStitcher::slices_from_offsets(widths, offsets));
+
+  const auto out = stitcher.stitch({mono_frame(0, 4, 2, 123),
+                                    mono_frame(1, 4, 2, 456)});
+  ASSERT_TRUE(out);
+  EXPECT_EQ(out->width(), 6);
+  EXPECT_EQ(out->height(), 2);
+  EXPECT_EQ(out->pixel_format, PixelFormat::Mono8);
+  EXPECT_EQ(out->stride, 6u);
+  EXPECT_EQ(out->meta.uTimestamp, 123u);
+  const std::vector<uint8_t> expected{0, 1, 2, 101, 102, 103};
+  EXPECT_EQ(row(*out, 0), expected);
+  EXPECT_EQ(row(*out, 1), expected);
+}
+
+TEST_F(StripStitcherTests, MissingCameraIsZeroFilled) {
+  StripStitcher stitcher({{0, 2, 0}, {0, 2, 2}});
+  const auto out = stitcher.stitch({nullptr, mono_frame(1, 2, 1)});
+  ASSERT_TRUE(out);
+  EXPECT_EQ(row(*out, 0), (std::vector<uint8_t>{0, 0, 100, 101}));
+}
+
+TEST_F(StripStitcherTests, MismatchedFramesAreRejected) {
+  StripStitcher stitcher({{0, 2, 0}, {0, 2, 2}});
+  EXPECT_FALSE(stitcher.stitch({mono_frame(0, 2, 1), mono_frame(1, 2, 2)}));
+  EXPECT_FALSE(stitcher.stitch({mono_frame(0, 2, 1)}));
+  EXPECT_FALSE(stitcher.stitch({mono_frame(0, 1, 1), mono_frame(1, 2, 1)}));
+}
+
+// Bayer 帧的切片列偏移为奇数时会错开 CFA 相位，拒绝拼接
+TEST_F(StripStitcherTests, OddShiftIsRejectedForBayer) {
+  const int widths[] = {4, 4};
+  const auto bayer = [](CapturedFramePtr frame) {
+    auto copy = std::make_shared<CapturedFrame>(*frame);
+    copy->pixel_format = PixelFormat::BayerRG8;
+    return CapturedFramePtr(copy);
+  };
+
+  const int odd[] = {0, 1};
+  StripStitcher odd_stitcher(StripStitcher::slices_from_offsets(widths, odd));
+  EXPECT_TRUE(odd_stitcher.stitch({mono_frame(0, 4, 2), mono_frame(1, 4, 2)}));
+  EXPECT_FALSE(odd_stitcher.stitch(
+      {bayer(mono_frame(0, 4, 2)), bayer(mono_frame(1, 4, 2))}));
+
+  const int even[] = {0, 2};
+  StripStitcher even_stitcher(StripStitcher::slices_from_offsets(widths, even));
+  EXPECT_TRUE(even_stitcher.stitch(
+      {bayer(mono_frame(0, 4, 2)), bayer(mono_frame(1, 4, 2))}));
+}
+
+// 输出帧来自缓冲池，释放后被下一次拼接复用
+TEST_F(StripStitcherTests, OutputFramesAreRecycled) {
+  auto pool = FrameBufferPool::create(0, 4);
+  StripStitcher stitcher({{0, 2, 0}, {0, 2, 2}}, pool);
+  const auto a = mono_frame(0, 2, 2);
+  const auto b = mono_frame(1, 2, 2);
+
+  const uint8_t* first = stitcher.stitch({a, b})->data.data();
+  const uint8_t* second = stitcher.stitch({a, b})->data.data();
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(pool->stats().total_slabs, 1u);
+}
+
+TEST_F(StripStitcherTests, CoordinatorRunsStitcherDownstream) {
+  std::promise<int> fused_width;
+  MultiCameraCoordinator coordinator(2, StripStitcher({{0, 2, 0}, {0, 2, 2}}));
+  coordinator.set_downstream_processor(
+      std::make_unique<FunctionFrameProcessor<std::function<void(
+          const CapturedFrame&)>>>([&](const CapturedFrame& frame) {
+        fused_width.set_value(frame.width());
+      }));
+
+  coordinator[0]->process(*mono_frame(0, 2, 1, 1000));
+  coordinator[1]->process(*mono_frame(1, 2, 1, 1000));
+  auto future = fused_width.get_future();
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_EQ(future.get(), 4);
+}
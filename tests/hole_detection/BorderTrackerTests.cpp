@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+
+#include "algo/BorderTracker.hpp"
+
+// 测试白边跟踪：结果与每帧完整查找一致，跳变时退回完整查找
+class BorderTrackerTests : public ::testing::Test {
+ protected:
+  static constexpr int kRows = 64;
+  static constexpr int kCols = 2000;
+  static constexpr int kStep = 8;
+  static constexpr double kRatio = 0.1;
+
+  // 左右两侧为白边，中间为暗的随机纹理
+  static cv::Mat strip(int cols, int left, int right, unsigned seed) {
+    cv::Mat gray(kRows, cols, CV_8UC1);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> texture(0, 120);
+    for (int y = 0; y < kRows; ++y) {
+      uint8_t* row = gray.ptr<uint8_t>(y);
+      for (int x = 0; x < cols; ++x) {
+        const bool border = x < left || x >= cols - right;
+        row[x] = static_cast<uint8_t>(border ? 240 : texture(rng));
+      }
+    }
+    return gray;
+  }
+
+  std::pair<int, int> track(const cv::Mat& gray) {
+    algo::ColumnProfile profile(gray, kStep, 200);
+    return tracker.update(profile, kRatio);
+  }
+
+  static std::pair<int, int> full(const cv::Mat& gray) {
+    algo::ColumnProfile profile(gray, kStep, 200);
+    return algo::find_content_bounds(profile, kRatio);
+  }
+
+  algo::BorderTracker tracker{64, 1000};
+};
+
+// 边缘每帧移动几个像素时只做一次完整查找
+TEST_F(BorderTrackerTests, SlowDriftIsTrackedLocally) {
+  for (int i = 0; i < 40; ++i) {
+    cv::Mat gray = strip(kCols, 300 + i * 3, 200 - i * 2, i);
+    EXPECT_EQ(track(gray), full(gray)) << i;
+  }
+  EXPECT_EQ(tracker.stats().full_searches, 1u);
+  EXPECT_EQ(tracker.stats().tracked, 39u);
+}
+
+// 边缘出现或消失也能在窗口内跟上
+TEST_F(BorderTrackerTests, BorderAppearingAndDisappearing) {
+  const int lefts[] = {0, 10, 40, 0, 0, 30};
+  for (int i = 0; i < 6; ++i) {
+    cv::Mat gray = strip(kCols, lefts[i], 0, i);
+    EXPECT_EQ(track(gray), full(gray)) << i;
+  }
+  EXPECT_EQ(tracker.stats().full_searches, 1u);
+}
+
+// 边缘跳出窗口时退回完整查找
+TEST_F(BorderTrackerTests, LargeJumpFallsBackToFullSearch) {
+  cv::Mat first = strip(kCols, 300, 200, 1);
+  cv::Mat jumped = strip(kCols, 900, 200, 2);
+  EXPECT_EQ(track(first), full(first));
+  EXPECT_EQ(track(jumped), full(jumped));
+  EXPECT_EQ(tracker.stats().full_searches, 2u);
+}
+
+// reset() 和宽度变化都会触发完整查找
+TEST_F(BorderTrackerTests, ResetAndWidthChangeForceFullSearch) {
+  cv::Mat gray = strip(kCols, 300, 200, 1);
+  track(gray);
+  tracker.reset();
+  track(gray);
+  cv::Mat narrower = strip(kCols - 100, 300, 200, 1);
+  EXPECT_EQ(track(narrower), full(narrower));
+  EXPECT_EQ(tracker.stats().full_searches, 3u);
+  EXPECT_EQ(tracker.stats().tracked, 0u);
+}
+
+// 乱序完成的旧帧不会覆盖新帧发布的边界
+TEST_F(BorderTrackerTests, OlderFrameDoesNotOverwriteState) {
+  cv::Mat newer = strip(kCols, 300, 200, 1);
+  cv::Mat older = strip(kCols, 900, 200, 2);
+  algo::ColumnProfile newer_profile(newer, kStep, 200);
+  algo::ColumnProfile older_profile(older, kStep, 200);
+
+  EXPECT_EQ(tracker.update(newer_profile, kRatio, 10), full(newer));
+  // 旧帧照常得到自己的边界（完整查找），但不发布
+  EXPECT_EQ(tracker.update(older_profile, kRatio, 9), full(older));
+
+  // 下一帧仍从 300 附近跟踪
+  cv::Mat next = strip(kCols, 303, 198, 3);
+  algo::ColumnProfile next_profile(next, kStep, 200);
+  EXPECT_EQ(tracker.update(next_profile, kRatio, 11), full(next));
+  EXPECT_EQ(tracker.stats().full_searches, 2u);
+  EXPECT_EQ(tracker.stats().tracked, 1u);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "algo/ColumnProfile.hpp"
+
+// 测试列统计：与逐列读取的标量实现一致
+class ColumnProfileTests : public ::testing::Test {
+ protected:
+  static std::vector<uint32_t> reference(const cv::Mat& gray, int row_step,
+                                         uint8_t threshold) {
+    std::vector<uint32_t> counts(gray.cols, 0);
+    for (int x = 0; x < gray.cols; ++x) {
+      for (int y = 0; y < gray.rows; y += row_step) {
+        counts[x] += gray.ptr<uint8_t>(y)[x] > threshold;
+      }
+    }
+    return counts;
+  }
+
+  // 左右两侧为白边，中间为随机纹理
+  static cv::Mat bordered_image(int rows, int cols, int left, int right,
+                                unsigned seed) {
+    cv::Mat gray(rows, cols, CV_8UC1);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> texture(0, 255);
+    for (int y = 0; y < rows; ++y) {
+      uint8_t* row = gray.ptr<uint8_t>(y);
+      for (int x = 0; x < cols; ++x) {
+        const bool border = x < left || x >= cols - right;
+        row[x] = static_cast<uint8_t>(border ? 250 : texture(rng) / 2);
+      }
+    }
+    return gray;
+  }
+};
+
+// 行数超过 255 时 8 位计数器不会溢出，宽度不是向量宽度的整数倍
+TEST_F(ColumnProfileTests, CountsMatchReferenceAcrossBatches) {
+  cv::Mat gray(700, 83, CV_8UC1);
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> level(0, 255);
+  for (int y = 0; y < gray.rows; ++y) {
+    for (int x = 0; x < gray.cols; ++x) {
+      gray.ptr<uint8_t>(y)[x] = static_cast<uint8_t>(level(rng));
+    }
+  }
+  for (int step : {1, 3, 8}) {
+    std::vector<uint32_t> counts;
+    const int sampled = algo::count_bright_columns(gray, step, 200, counts);
+    EXPECT_EQ(sampled, (gray.rows + step - 1) / step);
+    EXPECT_EQ(counts, reference(gray, step, 200));
+  }
+}
+
+// 阈值 255 时没有亮像素
+TEST_F(ColumnProfileTests, MaxThresholdCountsNothing) {
+  cv::Mat gray(10, 40, CV_8UC1, cv::Scalar(255));
+  std::vector<uint32_t> counts;
+  EXPECT_EQ(algo::count_bright_columns(gray, 1, 255, counts), 10);
+  EXPECT_EQ(counts, std::vector<uint32_t>(40, 0));
+}
+
+// 白边宽度被准确找到
+TEST_F(ColumnProfileTests, FindsBothBorders) {
+  cv::Mat gray = bordered_image(64, 1200, 130, 77, 3);
+  algo::ColumnProfile profile(gray, 8, 200);
+  const auto [x_min, x_max] = algo::find_content_bounds(profile, 0.1);
+  EXPECT_EQ(x_min, 130);
+  EXPECT_EQ(x_max, 1200 - 77 - 1);
+}
+
+// 两侧没有白边时保持整幅图像
+TEST_F(ColumnProfileTests, NoBorderKeepsFullWidth) {
+  cv::Mat gray = bordered_image(32, 500, 0, 0, 5);
+  algo::ColumnProfile profile(gray, 1, 200);
+  const auto [x_min, x_max] = algo::find_content_bounds(profile, 0.1);
+  EXPECT_EQ(x_min, 0);
+  EXPECT_EQ(x_max, 499);
+}
+
+// 按需计算的列统计与整幅统计一致，包括不足一块的最后一块
+TEST_F(ColumnProfileTests, LazyBlocksMatchFullProfile) {
+  cv::Mat gray = bordered_image(300, 1000, 40, 90, 11);
+  std::vector<uint32_t> counts;
+  const int sampled = algo::count_bright_columns(gray, 3, 60, counts);
+  algo::ColumnProfile profile(gray, 3, 60);
+  EXPECT_EQ(profile.sampled_rows(), sampled);
+  for (int x = gray.cols - 1; x >= 0; x -= 7) {
+    EXPECT_EQ(profile.count(x), counts[x]) << x;
+  }
+}
+
+// release() 之后不再引用图像，reset() 后可以继续使用
+TEST_F(ColumnProfileTests, ReleaseDropsImage) {
+  cv::Mat gray = bordered_image(16, 300, 20, 30, 9);
+  algo::ColumnProfile profile(gray, 1, 200);
+  EXPECT_EQ(profile.count(0), 16u);
+  profile.release();
+  EXPECT_EQ(profile.width(), 0);
+  EXPECT_EQ(profile.sampled_rows(), 0);
+
+  profile.reset(gray, 1, 200);
+  const auto [x_min, x_max] = algo::find_content_bounds(profile, 0.1);
+  EXPECT_EQ(x_min, 20);
+  EXPECT_EQ(x_max, 300 - 30 - 1);
+}
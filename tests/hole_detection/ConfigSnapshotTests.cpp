@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algo/ConfigSnapshot.hpp"
+
+// 测试配置快照：读者拿到的快照不会被之后的更新修改
+class ConfigSnapshotTests : public ::testing::Test {
+ protected:
+  struct Settings {
+    int threshold = 20;
+    std::string name = "default";
+  };
+};
+
+TEST_F(ConfigSnapshotTests, LoadedSnapshotIsImmutable) {
+  algo::ConfigSnapshot<Settings> snapshot;
+  const auto before = snapshot.load();
+  snapshot.update([](Settings& s) { s.threshold = 30; });
+
+  EXPECT_EQ(before->threshold, 20);
+  EXPECT_EQ(snapshot.load()->threshold, 30);
+  EXPECT_EQ(snapshot.load()->name, "default");
+  EXPECT_EQ(snapshot.version(), 1u);
+}
+
+// 修改函数抛出异常时不发布
+TEST_F(ConfigSnapshotTests, ThrowingUpdateKeepsCurrentSnapshot) {
+  algo::ConfigSnapshot<Settings> snapshot(Settings{5, "init"});
+  EXPECT_THROW(snapshot.update([](Settings& s) {
+    s.threshold = 99;
+    throw std::invalid_argument("bad value");
+  }),
+               std::invalid_argument);
+  EXPECT_EQ(snapshot.load()->threshold, 5);
+  EXPECT_EQ(snapshot.version(), 0u);
+}
+
+// 并发写者的修改不会互相覆盖，读者始终看到完整的快照
+TEST_F(ConfigSnapshotTests, ConcurrentUpdatesAreNotLost) {
+  algo::ConfigSnapshot<Settings> snapshot(Settings{0, "0"});
+  std::atomic<bool> stop{false};
+  std::thread reader([&] {
+    while (!stop.load()) {
+      const auto s = snapshot.load();
+      ASSERT_EQ(std::to_string(s->threshold), s->name);
+    }
+  });
+
+  constexpr int kWriters = 4;
+  constexpr int kUpdates = 500;
+  std::vector<std::thread> writers;
+  for (int w = 0; w < kWriters; ++w) {
+    writers.emplace_back([&] {
+      for (int i = 0; i < kUpdates; ++i) {
+        snapshot.update([](Settings& s) {
+          ++s.threshold;
+          s.name = std::to_string(s.threshold);
+        });
+      }
+    });
+  }
+  for (auto& t : writers) {
+    t.join();
+  }
+  stop = true;
+  reader.join();
+
+  EXPECT_EQ(snapshot.load()->threshold, kWriters * kUpdates);
+  EXPECT_EQ(snapshot.version(), static_cast<uint64_t>(kWriters * kUpdates));
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "ImageSignalBus.hpp"
+#include "ProcessingExecutor.hpp"
+#include "algo/HoleDetection.hpp"
+
+// 在 HoleDetection 层面测试分带并行标记和逐帧工作区
+class HoleDetectionTests : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = 1200;
+  static constexpr int kHeight = 1200;
+
+  // 暗背景上的几个亮斑当作针孔，其中几个跨过 4 带时的行带接缝
+  static CapturedFrame make_frame(uint64_t sequence) {
+    CapturedFrame frame;
+    frame.sequence = sequence;
+    frame.meta.format = FORMAT_MONO;
+    frame.meta.bits = BITS_8;
+    frame.meta.iWidth = kWidth;
+    frame.meta.iHeight = kHeight;
+    frame.meta.uBytes = kWidth * kHeight;
+    frame.data.assign(static_cast<size_t>(kWidth) * kHeight, 0);
+
+    struct Spot {
+      int x, y, w, h;
+    };
+    const Spot spots[] = {{200, 294, 6, 12},
+                          {600, 596, 8, 8},
+                          {900, 897, 5, 9},
+                          {450, 450, 4, 4}};
+    uint8_t* pixels = frame.data.data();
+    for (const Spot& spot : spots) {
+      for (int y = spot.y; y < spot.y + spot.h; ++y) {
+        for (int x = spot.x; x < spot.x + spot.w; ++x) {
+          pixels[static_cast<size_t>(y) * kWidth + x] = 200;
+        }
+      }
+    }
+    frame.update_layout();
+    return frame;
+  }
+
+  // 分别以单线程和 parallel_bands 处理同一帧，返回两张缺陷标注图
+  static std::vector<cv::Mat> defect_maps(int parallel_bands) {
+    auto detection = std::make_shared<algo::HoleDetection>();
+    detection->initialize();
+
+    std::vector<cv::Mat> maps;
+    auto& bus = ImageSignalBus::instance();
+    const auto id = bus.subscribe("defect_map", [&](const cv::Mat& image) {
+      maps.push_back(image.clone());
+    });
+    const CapturedFrame frame = make_frame(1);
+    detection->process(frame);
+    detection->configure("parallel_bands", std::to_string(parallel_bands));
+    detection->process(frame);
+    bus.unsubscribe(id);
+    return maps;
+  }
+};
+
+// 分带标记与单线程标记的结果一致
+TEST_F(HoleDetectionTests, ParallelBandsMatchSinglePass) {
+  const auto maps = defect_maps(4);
+  ASSERT_EQ(maps.size(), 2u);
+  EXPECT_EQ(cv::norm(maps[0], maps[1], cv::NORM_INF), 0.0);
+}
+
+// worker 预算用完时分带 lane 与已有 lane 共用 worker，调用线程自己也
+// 领取行带，不会等待排在后面的任务
+TEST_F(HoleDetectionTests, ParallelBandsWithSharedWorkers) {
+  auto& executor = ProcessingExecutor::instance();
+  std::vector<std::shared_ptr<ProcessingExecutor::Lane>> held;
+  while (executor.workers_in_use() < executor.total_workers()) {
+    held.push_back(executor.acquire_lane(WorkerBudget{1, {}}));
+  }
+
+  const auto maps = defect_maps(4);
+  held.clear();
+  ASSERT_EQ(maps.size(), 2u);
+  EXPECT_EQ(cv::norm(maps[0], maps[1], cv::NORM_INF), 0.0);
+}
+
+// 同尺寸的帧预热之后，工作区不再扩容
+TEST_F(HoleDetectionTests, ScratchStopsGrowingAfterWarmup) {
+  algo::HoleDetection detection;
+  constexpr int kWarmup = 3;
+  constexpr int kFrames = 10;
+  uint64_t growth_after_warmup = 0;
+  for (int i = 0; i < kFrames; ++i) {
+    detection.process(make_frame(static_cast<uint64_t>(i)));
+    if (i + 1 == kWarmup) {
+      growth_after_warmup = detection.get_scratch_stats().growth_frames;
+    }
+  }
+
+  const auto stats = detection.get_scratch_stats();
+  EXPECT_EQ(stats.frames, static_cast<uint64_t>(kFrames));
+  EXPECT_EQ(stats.growth_frames, growth_after_warmup);
+  EXPECT_LE(stats.growth_frames, static_cast<uint64_t>(kWarmup));
+  EXPECT_GT(stats.peak_reserved_bytes, 0u);
+}
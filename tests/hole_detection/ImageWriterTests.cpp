@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "ImageWriter.hpp"
+
+// 测试异步证据图保存服务
+class ImageWriterTests : public ::testing::Test {
+ protected:
+  std::filesystem::path dir;
+
+  void SetUp() override {
+    dir = std::filesystem::temp_directory_path() /
+          (std::string("image_writer_") +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::create_directories(dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  static cv::Mat gray_image() { return cv::Mat(16, 16, CV_8UC1, cv::Scalar(7)); }
+};
+
+// flush() 返回时所有图像都已按 codec 的扩展名写盘
+TEST_F(ImageWriterTests, FlushWaitsForAllWrites) {
+  ImageWriterConfig config;
+  config.codec = ImageCodec::Png;
+  config.workers = 2;
+  ImageWriter writer(config);
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(
+        writer.submit((dir / ("img_" + std::to_string(i))).string(),
+                      gray_image()));
+  }
+  writer.flush();
+
+  EXPECT_EQ(writer.stats().written, 5u);
+  EXPECT_TRUE(std::filesystem::exists(dir / "img_4.png"));
+}
+
+// 析构时写完队列中剩余的图像
+TEST_F(ImageWriterTests, DestructorDrainsQueue) {
+  {
+    ImageWriter writer;
+    writer.submit((dir / "last").string(), gray_image());
+  }
+  EXPECT_TRUE(std::filesystem::exists(dir / "last.jpg"));
+}
+
+// 空图像不入队
+TEST_F(ImageWriterTests, EmptyImageIsRejected) {
+  ImageWriter writer;
+  EXPECT_FALSE(writer.submit((dir / "empty").string(), cv::Mat()));
+  writer.flush();
+  EXPECT_EQ(writer.stats().submitted, 0u);
+}
+
+// 证据模式决定是否需要保存
+TEST_F(ImageWriterTests, EvidenceModeGatesSaving) {
+  ImageWriterConfig config;
+  config.mode = EvidenceMode::DefectsOnly;
+  ImageWriter defects_only(config);
+  EXPECT_TRUE(defects_only.should_save(true));
+  EXPECT_FALSE(defects_only.should_save(false));
+
+  config.mode = EvidenceMode::Off;
+  ImageWriter off(config);
+  EXPECT_FALSE(off.should_save(true));
+
+  config.mode = EvidenceMode::Always;
+  ImageWriter always(config);
+  EXPECT_TRUE(always.should_save(false));
+}
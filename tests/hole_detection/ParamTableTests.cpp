@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algo/ParamTable.hpp"
+
+// 测试参数表：解析、范围校验、批量更新和参数信息
+class ParamTableTests : public ::testing::Test {
+ protected:
+  struct Config {
+    int count = 0;
+    float scale = 0.0f;
+    bool enabled = false;
+    std::string mode;
+  };
+
+  static algo::ParamTable<Config> make_table() {
+    algo::ParamTable<Config> table;
+    table.add("count", &Config::count, "数量", 3, 1, 10);
+    table.add("scale", &Config::scale, "比例", 0.5f, 0.0f);
+    table.add("enabled", &Config::enabled, "开关", true);
+    table.add<std::string>("mode", &Config::mode, "模式", "fast",
+                           [](const std::string& v) {
+                             return v == "fast" || v == "slow";
+                           });
+    return table;
+  }
+};
+
+TEST_F(ParamTableTests, DefaultsAndDescription) {
+  const auto table = make_table();
+  Config cfg;
+  table.apply_defaults(cfg);
+  EXPECT_EQ(cfg.count, 3);
+  EXPECT_FLOAT_EQ(cfg.scale, 0.5f);
+  EXPECT_TRUE(cfg.enabled);
+  EXPECT_EQ(cfg.mode, "fast");
+
+  const auto infos = table.describe(cfg);
+  ASSERT_EQ(infos.size(), 4u);
+  EXPECT_EQ(infos[0].name, "count");
+  EXPECT_EQ(infos[0].type, "int");
+  EXPECT_EQ(infos[0].min_value, "1");
+  EXPECT_EQ(infos[0].max_value, "10");
+  EXPECT_EQ(infos[1].type, "float");
+  EXPECT_EQ(infos[1].default_value, "0.5");
+  EXPECT_EQ(infos[1].min_value, "0");
+  EXPECT_TRUE(infos[1].max_value.empty());
+  EXPECT_EQ(infos[2].current_value, "1");
+  EXPECT_EQ(infos[3].type, "string");
+}
+
+// 整个字符串必须是合法值，且在范围内
+TEST_F(ParamTableTests, InvalidValuesAreRejected) {
+  const auto table = make_table();
+  Config cfg;
+  table.apply_defaults(cfg);
+
+  EXPECT_THROW(table.apply(cfg, "count", "12abc"), std::invalid_argument);
+  EXPECT_THROW(table.apply(cfg, "count", "11"), std::invalid_argument);
+  EXPECT_THROW(table.apply(cfg, "scale", "-1"), std::invalid_argument);
+  EXPECT_THROW(table.apply(cfg, "enabled", "yes"), std::invalid_argument);
+  EXPECT_THROW(table.apply(cfg, "mode", "turbo"), std::invalid_argument);
+  EXPECT_THROW(table.apply(cfg, "missing", "1"), std::invalid_argument);
+  EXPECT_EQ(cfg.count, 3);
+
+  table.apply(cfg, "count", " 7 ");
+  table.apply(cfg, "scale", "2.25");
+  table.apply(cfg, "enabled", "false");
+  EXPECT_EQ(cfg.count, 7);
+  EXPECT_FLOAT_EQ(cfg.scale, 2.25f);
+  EXPECT_FALSE(cfg.enabled);
+}
+
+// 批量更新中任何一项失败，之前的项也不生效
+TEST_F(ParamTableTests, BatchIsAllOrNothing) {
+  const auto table = make_table();
+  Config cfg;
+  table.apply_defaults(cfg);
+
+  EXPECT_THROW(table.apply_all(cfg, {{"count", "5"}, {"mode", "turbo"}}),
+               std::invalid_argument);
+  EXPECT_EQ(cfg.count, 3);
+  EXPECT_EQ(cfg.mode, "fast");
+
+  table.apply_all(cfg, {{"count", "5"}, {"mode", "slow"}});
+  EXPECT_EQ(cfg.count, 5);
+  EXPECT_EQ(cfg.mode, "slow");
+}
+
+// 整体替换的配置按同样的范围和校验函数检查
+TEST_F(ParamTableTests, ValidateChecksWholeConfig) {
+  const auto table = make_table();
+  Config cfg;
+  table.apply_defaults(cfg);
+  EXPECT_NO_THROW(table.validate(cfg));
+
+  Config bad = cfg;
+  bad.count = 0;
+  EXPECT_THROW(table.validate(bad), std::invalid_argument);
+  bad = cfg;
+  bad.scale = -0.5f;
+  EXPECT_THROW(table.validate(bad), std::invalid_argument);
+  bad = cfg;
+  bad.mode = "turbo";
+  EXPECT_THROW(table.validate(bad), std::invalid_argument);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "algo/PointClustering.hpp"
+
+// 测试网格聚类：与暴力 single-linkage 的结果一致
+class PointClusteringTests : public ::testing::Test {
+ protected:
+  // O(n^2) 的参考实现：反复合并标签直到稳定
+  static std::vector<int> brute_force(const std::vector<cv::Point>& points,
+                                      int distance) {
+    std::vector<int> labels(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      labels[i] = static_cast<int>(i);
+    }
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = 0; j < points.size(); ++j) {
+          const long dx = points[i].x - points[j].x;
+          const long dy = points[i].y - points[j].y;
+          if (dx * dx + dy * dy <= static_cast<long>(distance) * distance &&
+              labels[j] < labels[i]) {
+            labels[i] = labels[j];
+            changed = true;
+          }
+        }
+      }
+    }
+    // 按首次出现的顺序重新编号
+    std::vector<int> dense(points.size(), -1);
+    int next = 0;
+    for (int& label : labels) {
+      if (dense[label] < 0) {
+        dense[label] = next++;
+      }
+      label = dense[label];
+    }
+    return labels;
+  }
+};
+
+// 链式相邻的点传递地归为一簇
+TEST_F(PointClusteringTests, ClustersAreTransitive) {
+  const std::vector<cv::Point> points = {{0, 0}, {8, 0}, {16, 0}, {100, 100}};
+  const auto labels = algo::cluster_points_grid(points, 10);
+  EXPECT_EQ(labels, (std::vector<int>{0, 0, 0, 1}));
+}
+
+// 距离恰好等于阈值时合并
+TEST_F(PointClusteringTests, ThresholdIsInclusive) {
+  const std::vector<cv::Point> points = {{0, 0}, {6, 8}, {6, 19}};
+  const auto labels = algo::cluster_points_grid(points, 10);
+  EXPECT_EQ(labels, (std::vector<int>{0, 0, 1}));
+}
+
+// 编号按每簇最小的点下标分配，与遍历网格的顺序无关
+TEST_F(PointClusteringTests, LabelsFollowInputOrder) {
+  const std::vector<cv::Point> points = {
+      {500, 500}, {0, 0}, {503, 498}, {2, 1}};
+  const auto labels = algo::cluster_points_grid(points, 5);
+  EXPECT_EQ(labels, (std::vector<int>{0, 1, 0, 1}));
+}
+
+// 随机点集上与参考实现一致
+TEST_F(PointClusteringTests, MatchesBruteForce) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> coord(-50, 400);
+  for (int round = 0; round < 20; ++round) {
+    std::vector<cv::Point> points(200);
+    for (auto& p : points) {
+      p = cv::Point(coord(rng), coord(rng));
+    }
+    const int distance = 5 + round;
+    EXPECT_EQ(algo::cluster_points_grid(points, distance),
+              brute_force(points, distance));
+  }
+}
+
+// 复用同一个 scratch 时结果不变，同样规模的输入不再扩容
+TEST_F(PointClusteringTests, ScratchReuseMatchesAndStopsGrowing) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> coord(0, 300);
+  algo::GridClusterScratch scratch;
+  std::vector<int> labels;
+  size_t warm = 0;
+  for (int round = 0; round < 10; ++round) {
+    std::vector<cv::Point> points(150);
+    for (auto& p : points) {
+      p = cv::Point(coord(rng), coord(rng));
+    }
+    algo::cluster_points_grid(points, 12, scratch, labels);
+    EXPECT_EQ(labels, brute_force(points, 12));
+    if (round == 0) {
+      warm = scratch.reserved_bytes();
+    }
+    EXPECT_EQ(scratch.reserved_bytes(), warm);
+  }
+}
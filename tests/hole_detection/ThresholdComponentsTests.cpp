@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "algo/ThresholdComponents.hpp"
+
+// 测试融合阈值 + 连通域标记：与先二值化再洪水填充的结果一致
+class ThresholdComponentsTests : public ::testing::Test {
+ protected:
+  // 参考实现：逐列阈值得到二值图，再按光栅顺序做 8 连通洪水填充
+  static std::vector<algo::ComponentStats> reference(
+      const cv::Mat& gray, const std::vector<algo::ColumnThreshold>& parts) {
+    const int w = gray.cols;
+    const int h = gray.rows;
+    std::vector<int> thresh(w, parts.back().thresh);
+    int begin = 0;
+    for (size_t p = 0; p + 1 < parts.size(); ++p) {
+      const int end = std::clamp(parts[p].end_col, begin, w);
+      std::fill(thresh.begin() + begin, thresh.begin() + end, parts[p].thresh);
+      begin = end;
+    }
+
+    std::vector<uint8_t> fg(static_cast<size_t>(w) * h);
+    for (int y = 0; y < h; ++y) {
+      const uint8_t* row = gray.ptr<uint8_t>(y);
+      for (int x = 0; x < w; ++x) {
+        fg[static_cast<size_t>(y) * w + x] = row[x] > thresh[x];
+      }
+    }
+
+    std::vector<algo::ComponentStats> out;
+    std::vector<int> stack;
+    for (int i = 0; i < w * h; ++i) {
+      if (!fg[i]) {
+        continue;
+      }
+      fg[i] = 0;
+      stack.push_back(i);
+      int min_x = w, min_y = h, max_x = -1, max_y = -1, area = 0;
+      double sx = 0, sy = 0;
+      while (!stack.empty()) {
+        const int p = stack.back();
+        stack.pop_back();
+        const int x = p % w;
+        const int y = p / w;
+        ++area;
+        sx += x;
+        sy += y;
+        min_x = std::min(min_x, x);
+        max_x = std::max(max_x, x);
+        min_y = std::min(min_y, y);
+        max_y = std::max(max_y, y);
+        for (int dy = -1; dy <= 1; ++dy) {
+          for (int dx = -1; dx <= 1; ++dx) {
+            const int nx = x + dx;
+            const int ny = y + dy;
+            if (nx >= 0 && nx < w && ny >= 0 && ny < h && fg[ny * w + nx]) {
+              fg[ny * w + nx] = 0;
+              stack.push_back(ny * w + nx);
+            }
+          }
+        }
+      }
+      out.push_back({min_x, min_y, max_x - min_x + 1, max_y - min_y + 1, area,
+                     sx / area, sy / area});
+    }
+    return out;
+  }
+
+  static void expect_same(const std::vector<algo::ComponentStats>& actual,
+                          const std::vector<algo::ComponentStats>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      EXPECT_EQ(actual[i].left, expected[i].left) << i;
+      EXPECT_EQ(actual[i].top, expected[i].top) << i;
+      EXPECT_EQ(actual[i].width, expected[i].width) << i;
+      EXPECT_EQ(actual[i].height, expected[i].height) << i;
+      EXPECT_EQ(actual[i].area, expected[i].area) << i;
+      EXPECT_NEAR(actual[i].cx, expected[i].cx, 1e-9) << i;
+      EXPECT_NEAR(actual[i].cy, expected[i].cy, 1e-9) << i;
+    }
+  }
+
+  static cv::Mat random_image(int rows, int cols, double density,
+                              unsigned seed) {
+    cv::Mat gray(rows, cols, CV_8UC1);
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution bright(density);
+    std::uniform_int_distribution<int> level(0, 255);
+    for (int y = 0; y < rows; ++y) {
+      uint8_t* row = gray.ptr<uint8_t>(y);
+      for (int x = 0; x < cols; ++x) {
+        row[x] = static_cast<uint8_t>(bright(rng) ? level(rng) : 0);
+      }
+    }
+    return gray;
+  }
+};
+
+// 单个分区下的统计量与参考实现一致，U 形区域在底部合并为一个连通域
+TEST_F(ThresholdComponentsTests, SinglePartitionMatchesReference) {
+  cv::Mat gray(8, 8, CV_8UC1, cv::Scalar(0));
+  for (int y = 1; y < 6; ++y) {
+    gray.ptr<uint8_t>(y)[1] = 200;
+    gray.ptr<uint8_t>(y)[5] = 200;
+  }
+  for (int x = 1; x <= 5; ++x) {
+    gray.ptr<uint8_t>(6)[x] = 200;
+  }
+  const std::vector<algo::ColumnThreshold> parts{{8, 100}};
+  const auto components = algo::threshold_components(gray, parts);
+  ASSERT_EQ(components.size(), 1u);
+  EXPECT_EQ(components[0].area, 15);
+  EXPECT_EQ(components[0].left, 1);
+  EXPECT_EQ(components[0].width, 5);
+  expect_same(components, reference(gray, parts));
+}
+
+// 只在对角方向相邻的像素属于同一个连通域
+TEST_F(ThresholdComponentsTests, DiagonalPixelsAreConnected) {
+  cv::Mat gray(4, 4, CV_8UC1, cv::Scalar(0));
+  for (int i = 0; i < 4; ++i) {
+    gray.ptr<uint8_t>(i)[3 - i] = 255;
+  }
+  const std::vector<algo::ColumnThreshold> parts{{4, 0}};
+  const auto components = algo::threshold_components(gray, parts);
+  ASSERT_EQ(components.size(), 1u);
+  EXPECT_EQ(components[0].area, 4);
+  EXPECT_DOUBLE_EQ(components[0].cx, 1.5);
+}
+
+// 每个分区使用各自的阈值，分区边界不对齐 SIMD 宽度
+TEST_F(ThresholdComponentsTests, PartitionThresholdsApplyPerColumnRange) {
+  cv::Mat gray(3, 100, CV_8UC1, cv::Scalar(120));
+  const std::vector<algo::ColumnThreshold> parts{
+      {37, 100}, {71, 150}, {100, 119}};
+  const auto components = algo::threshold_components(gray, parts);
+  ASSERT_EQ(components.size(), 2u);
+  EXPECT_EQ(components[0].left, 0);
+  EXPECT_EQ(components[0].width, 37);
+  EXPECT_EQ(components[1].left, 71);
+  EXPECT_EQ(components[1].width, 29);
+  expect_same(components, reference(gray, parts));
+}
+
+// 随机图像（宽度跨越多个 64 位字）与参考实现逐项一致
+TEST_F(ThresholdComponentsTests, RandomImagesMatchReference) {
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    const int cols = 1 + static_cast<int>(seed * 37 % 300);
+    cv::Mat gray = random_image(40, cols, 0.3 + 0.02 * seed, seed);
+    const std::vector<algo::ColumnThreshold> parts{
+        {cols / 3, 60}, {cols * 2 / 3, 140}, {cols, 90}};
+    expect_same(algo::threshold_components(gray, parts),
+                reference(gray, parts));
+  }
+}
+
+// 分带并行的结果（包括顺序）与单线程一致，行带数多于行数时也能处理
+TEST_F(ThresholdComponentsTests, BandedMatchesSinglePass) {
+  // 每个任务一个线程，检查各行带之间没有共享可写状态
+  const algo::BandRunner threads = [](size_t count, const auto& task) {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < count; ++i) {
+      workers.emplace_back([&task, i] { task(i); });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+  };
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    const int rows = 5 + static_cast<int>(seed * 13 % 90);
+    const int cols = 10 + static_cast<int>(seed * 37 % 200);
+    cv::Mat gray = random_image(rows, cols, 0.35 + 0.03 * seed, seed);
+    const std::vector<algo::ColumnThreshold> parts{
+        {cols / 2, 80}, {cols, 120}};
+    const auto single = algo::threshold_components(gray, parts);
+    for (size_t bands : {2u, 3u, 7u, 200u}) {
+      expect_same(algo::threshold_components_banded(gray, parts, bands,
+                                                    threads),
+                  single);
+    }
+  }
+}
+
+// 跨越所有行带的竖条合并成一个连通域
+TEST_F(ThresholdComponentsTests, ComponentSpanningAllBandsIsStitched) {
+  cv::Mat gray(64, 16, CV_8UC1, cv::Scalar(0));
+  for (int y = 0; y < 64; ++y) {
+    // 每行向右错开一列再回来，接缝处只有对角相邻
+    gray.ptr<uint8_t>(y)[4 + (y % 2)] = 255;
+  }
+  const std::vector<algo::ColumnThreshold> parts{{16, 100}};
+  const algo::BandRunner serial = [](size_t count, const auto& task) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+  };
+  const auto components =
+      algo::threshold_components_banded(gray, parts, 8, serial);
+  ASSERT_EQ(components.size(), 1u);
+  EXPECT_EQ(components[0].area, 64);
+  EXPECT_EQ(components[0].height, 64);
+}
+
+// 同一个 scratch 在不同尺寸的图像之间复用，结果与每次新建时一致
+TEST_F(ThresholdComponentsTests, ScratchReuseMatchesFreshScratch) {
+  const algo::BandRunner serial = [](size_t count, const auto& task) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+  };
+  algo::ComponentScratch scratch;
+  std::vector<algo::ComponentStats> components;
+  for (unsigned seed = 1; seed <= 12; ++seed) {
+    const int rows = 5 + static_cast<int>(seed * 29 % 80);
+    const int cols = 10 + static_cast<int>(seed * 53 % 250);
+    cv::Mat gray = random_image(rows, cols, 0.4, seed);
+    const std::vector<algo::ColumnThreshold> parts{{cols, 100}};
+    const auto fresh = algo::threshold_components(gray, parts);
+
+    algo::threshold_components(gray, parts, scratch, components);
+    expect_same(components, fresh);
+    algo::threshold_components_banded(gray, parts, 1 + seed % 4, serial,
+                                      scratch, components);
+    expect_same(components, fresh);
+  }
+}
+
+// 同样的图像重复处理时缓冲区不再增长
+TEST_F(ThresholdComponentsTests, ScratchStopsGrowingAfterWarmup) {
+  const algo::BandRunner serial = [](size_t count, const auto& task) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+  };
+  cv::Mat gray = random_image(64, 200, 0.5, 7);
+  const std::vector<algo::ColumnThreshold> parts{{100, 80}, {200, 120}};
+  algo::ComponentScratch scratch;
+  std::vector<algo::ComponentStats> components;
+  // 分带和不分带各跑一遍，两条路径用到的缓冲区都已分配
+  algo::threshold_components_banded(gray, parts, 4, serial, scratch,
+                                    components);
+  algo::threshold_components(gray, parts, scratch, components);
+  const size_t warm = scratch.reserved_bytes();
+  const size_t capacity = components.capacity();
+  EXPECT_GT(warm, 0u);
+
+  for (int i = 0; i < 3; ++i) {
+    algo::threshold_components_banded(gray, parts, 4, serial, scratch,
+                                      components);
+    algo::threshold_components(gray, parts, scratch, components);
+  }
+  EXPECT_EQ(scratch.reserved_bytes(), warm);
+  EXPECT_EQ(components.capacity(), capacity);
+}
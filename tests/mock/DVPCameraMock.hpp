@@ -63,10 +63,11 @@ class MockDvpCapture : public DvpCameraCapture {
   // 使用MOCK_METHOD宏定义模拟方法，不再使用override关键字
   MOCK_METHOD(void, set_config, (const DvpConfig& config), ());
   MOCK_METHOD(DvpConfig, get_config, (), (const));
-  MOCK_METHOD(bool, start, (const FrameProcessor& processor), ());
+  MOCK_METHOD(bool, start, (std::shared_ptr<FrameProcessor> processor), ());
   MOCK_METHOD(void, stop, (), ());
   MOCK_METHOD(bool, is_running, (), (const));
-  MOCK_METHOD(void, register_frame_callback, (const FrameProcessor& proc), ());
+  MOCK_METHOD(void, register_frame_callback,
+              (std::shared_ptr<FrameProcessor> proc), ());
   MOCK_METHOD(void, register_event_callback,
               (DvpEventType type, const DvpEventHandler& handler), ());
 };
@@ -1,6 +1,7 @@
 // tests/mock/TestDvpCamera.h
 #pragma once
 #include <memory>
+#include <utility>
 
 #include "DvpCameraCapture.hpp"
 #include "DvpConfig.hpp"
@@ -38,11 +39,11 @@ class TestDvpCamera : public DvpCameraCapture {
     return DvpConfig();
   }
 
-  bool start(const FrameProcessor& processor) override {
+  bool start(std::shared_ptr<FrameProcessor> processor) override {
     if (!mock_camera_) return false;
 
     // 存储回调
-    processor_ = std::make_shared<FrameProcessor>(processor);
+    processor_ = std::move(processor);
 
     // 注册回调到 Mock 相机
     mock_camera_->registerFrameCallback(processor_);
@@ -68,8 +69,8 @@ class TestDvpCamera : public DvpCameraCapture {
     return false;
   }
 
-  void register_frame_callback(const FrameProcessor& proc) {
-    processor_ = std::make_shared<FrameProcessor>(proc);
+  void register_frame_callback(std::shared_ptr<FrameProcessor> proc) {
+    processor_ = std::move(proc);
     if (mock_camera_) {
       mock_camera_->registerFrameCallback(processor_);
     }
@@ -81,9 +82,13 @@ class TestDvpCamera : public DvpCameraCapture {
     if (processor_) {
       // 创建一个CapturedFrame对象来传递给processor
       CapturedFrame frame;
-      frame.data = frame_data;
+      frame.data.assign(frame_data.data(),
+                        frame_data.data() + frame_data.size());
       frame.meta.iWidth = width;
       frame.meta.iHeight = height;
+      frame.meta.uBytes = static_cast<unsigned int>(frame_data.size());
+      frame.meta.format = FORMAT_BGR24;
+      frame.update_layout();
       processor_->process(frame);
     }
   }
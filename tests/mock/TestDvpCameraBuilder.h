@@ -73,8 +73,8 @@ class TestDvpCameraBuilder : public DvpCameraBuilder {
     return *this;
   }
 
-  TestDvpCameraBuilder& onFrame(const FrameProcessor& proc) {
-    DvpCameraBuilder::onFrame(proc);
+  TestDvpCameraBuilder& onFrame(std::shared_ptr<FrameProcessor> proc) {
+    DvpCameraBuilder::onFrame(std::move(proc));
     return *this;
   }
 
@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ImageSignalBus.hpp"
+
+// 测试图像信号：每次发送最多拷贝一次，没有订阅者时不生成图像。
+// 总线是单例，每个测试使用自己的信号名
+class ImageSignalBusTests : public ::testing::Test {
+ protected:
+  ImageSignalBus& bus = ImageSignalBus::instance();
+};
+
+TEST_F(ImageSignalBusTests, SubscribersShareOneCopy) {
+  const std::string name = "test_share_one_copy";
+  std::vector<const uchar*> seen;
+  ImageSignalBus::SharedImage shared;
+  bus.subscribe(name, [&](const cv::Mat& img) { seen.push_back(img.data); });
+  bus.subscribe(name, [&](const cv::Mat& img) { seen.push_back(img.data); });
+  bus.subscribe_shared(name, [&](const ImageSignalBus::SharedImage& img) {
+    shared = img;
+    seen.push_back(img->data);
+  });
+
+  cv::Mat frame(4, 4, CV_8UC1, cv::Scalar(7));
+  bus.emit(name, frame);
+
+  ASSERT_EQ(seen.size(), 3u);
+  EXPECT_EQ(seen[0], seen[1]);
+  EXPECT_EQ(seen[1], seen[2]);
+  ASSERT_TRUE(shared);
+  EXPECT_EQ(shared->ptr<uchar>(0)[0], 7);
+}
+
+// 已经共享的图像原样转发，不再拷贝
+TEST_F(ImageSignalBusTests, SharedImageIsForwardedWithoutCopy) {
+  const std::string name = "test_forward_shared";
+  const uchar* seen = nullptr;
+  bus.subscribe(name, [&](const cv::Mat& img) { seen = img.data; });
+
+  auto img = std::make_shared<const cv::Mat>(4, 4, CV_8UC1, cv::Scalar(1));
+  bus.emit(name, img);
+  EXPECT_EQ(seen, img->data);
+}
+
+TEST_F(ImageSignalBusTests, ImageIsOnlyMadeWhenSubscribed) {
+  const std::string name = "test_lazy_emit";
+  bus.declare_signal(name);
+  int made = 0;
+  const auto make = [&] {
+    ++made;
+    return cv::Mat(2, 2, CV_8UC1, cv::Scalar(0));
+  };
+
+  EXPECT_FALSE(bus.has_subscribers(name));
+  bus.emit_if_subscribed(name, make);
+  EXPECT_EQ(made, 0);
+
+  int received = 0;
+  bus.subscribe(name, [&](const cv::Mat&) { ++received; });
+  EXPECT_TRUE(bus.has_subscribers(name));
+  bus.emit_if_subscribed(name, make);
+  EXPECT_EQ(made, 1);
+  EXPECT_EQ(received, 1);
+}
+
+namespace {
+
+ImageSignalBus::FeatureData feature_with_id(int id) {
+  ImageSignalBus::FeatureData data;
+  data.roll_id = std::to_string(id);
+  return data;
+}
+
+// 让投递线程停在回调里，便于确定性地构造积压
+struct BlockingCallback {
+  std::promise<void> entered;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  bool first = true;
+
+  void block_once() {
+    if (first) {
+      first = false;
+      entered.set_value();
+      released.wait();
+    }
+  }
+};
+
+const ImageSignalBus::SubscriberStats* find_stats(
+    const std::vector<ImageSignalBus::SubscriberStats>& stats,
+    ImageSignalBus::SubscriptionId id) {
+  for (const auto& s : stats) {
+    if (s.id == id) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST_F(ImageSignalBusTests, QueuedSubscriberRunsOnItsOwnThreadInOrder) {
+  const std::string name = "test_queued_order";
+  std::vector<std::string> received;
+  std::thread::id callback_thread;
+  std::promise<void> done;
+  const auto id = bus.subscribe_feature(
+      name,
+      [&](const ImageSignalBus::FeatureData& data) {
+        callback_thread = std::this_thread::get_id();
+        received.push_back(data.roll_id);
+        if (received.size() == 5) {
+          done.set_value();
+        }
+      },
+      {DeliveryMode::Queued, 8});
+  ASSERT_NE(id, 0u);
+
+  for (int i = 0; i < 5; ++i) {
+    bus.emit_feature(name, feature_with_id(i));
+  }
+  ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_TRUE(bus.unsubscribe(id));
+
+  EXPECT_EQ(received, (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+  EXPECT_NE(callback_thread, std::this_thread::get_id());
+}
+
+TEST_F(ImageSignalBusTests, QueuedSubscriberDropsNewestWhenFull) {
+  const std::string name = "test_queued_overflow";
+  BlockingCallback blocker;
+  std::vector<std::string> received;
+  const auto id = bus.subscribe_feature(
+      name,
+      [&](const ImageSignalBus::FeatureData& data) {
+        received.push_back(data.roll_id);
+        blocker.block_once();
+      },
+      {DeliveryMode::Queued, 2});
+
+  bus.emit_feature(name, feature_with_id(0));
+  blocker.entered.get_future().wait();
+  for (int i = 1; i <= 5; ++i) {
+    bus.emit_feature(name, feature_with_id(i));  // 发送方不会被阻塞
+  }
+
+  const auto all_stats = bus.subscriber_stats();
+  const auto* stats = find_stats(all_stats, id);
+  ASSERT_NE(stats, nullptr);
+  EXPECT_EQ(stats->signal, name);
+  EXPECT_EQ(stats->mode, DeliveryMode::Queued);
+  EXPECT_EQ(stats->mailbox.pending, 2u);
+  EXPECT_EQ(stats->mailbox.dropped, 3u);
+
+  blocker.release.set_value();
+  EXPECT_TRUE(bus.unsubscribe(id));  // 送完已入队的再退出
+  EXPECT_EQ(received, (std::vector<std::string>{"0", "1", "2"}));
+}
+
+// 发送线程还拿着旧的订阅表时取消订阅：信箱在取消订阅的线程上送完并关闭，
+// 不会留给发送线程去等待
+TEST_F(ImageSignalBusTests, UnsubscribeDrainsMailboxOnCallerThread) {
+  const std::string name = "test_unsubscribe_drain";
+  std::vector<std::string> received;
+  const auto queued = bus.subscribe_feature(
+      name,
+      [&](const ImageSignalBus::FeatureData& data) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        received.push_back(data.roll_id);
+      },
+      {DeliveryMode::Queued, 8});
+  BlockingCallback blocker;
+  const auto inline_id = bus.subscribe_feature(
+      name, [&](const ImageSignalBus::FeatureData&) { blocker.block_once(); });
+
+  std::thread emitter([&] { bus.emit_feature(name, feature_with_id(0)); });
+  blocker.entered.get_future().wait();  // 发送线程停在 Inline 回调里
+
+  EXPECT_TRUE(bus.unsubscribe(queued));
+  EXPECT_EQ(received, (std::vector<std::string>{"0"}));
+
+  blocker.release.set_value();
+  emitter.join();
+  bus.emit_feature(name, feature_with_id(1));
+  EXPECT_TRUE(bus.unsubscribe(inline_id));
+  EXPECT_EQ(received.size(), 1u);
+}
+
+TEST_F(ImageSignalBusTests, LatestOnlySubscriberSkipsStaleImages) {
+  const std::string name = "test_latest_only";
+  BlockingCallback blocker;
+  std::vector<uchar> received;
+  const auto id = bus.subscribe(
+      name,
+      [&](const cv::Mat& img) {
+        received.push_back(img.ptr<uchar>(0)[0]);
+        blocker.block_once();
+      },
+      {DeliveryMode::LatestOnly});
+
+  bus.emit(name, cv::Mat(2, 2, CV_8UC1, cv::Scalar(0)));
+  blocker.entered.get_future().wait();
+  for (int i = 1; i <= 3; ++i) {
+    bus.emit(name, cv::Mat(2, 2, CV_8UC1, cv::Scalar(i)));
+  }
+
+  const auto all_stats = bus.subscriber_stats();
+  const auto* stats = find_stats(all_stats, id);
+  ASSERT_NE(stats, nullptr);
+  EXPECT_EQ(stats->mailbox.pending, 1u);
+  EXPECT_EQ(stats->mailbox.dropped, 2u);
+
+  blocker.release.set_value();
+  EXPECT_TRUE(bus.unsubscribe(id));
+  EXPECT_EQ(received, (std::vector<uchar>{0, 3}));
+}
+
+TEST_F(ImageSignalBusTests, FailingSubscriberDoesNotReachEmitter) {
+  const std::string name = "test_failing_subscriber";
+  int after = 0;
+  const auto failing = bus.subscribe_status(
+      name, [](const ImageSignalBus::StatusData&) {
+        throw std::runtime_error("subscriber failure");
+      });
+  const auto healthy = bus.subscribe_status(
+      name, [&](const ImageSignalBus::StatusData&) { ++after; });
+
+  EXPECT_NO_THROW(bus.emit_status(name, {}));
+  EXPECT_EQ(after, 1);
+  const auto stats = bus.subscriber_stats();
+  ASSERT_NE(find_stats(stats, failing), nullptr);
+  EXPECT_EQ(find_stats(stats, failing)->mailbox.failed, 1u);
+  EXPECT_EQ(find_stats(stats, healthy)->mailbox.delivered, 1u);
+
+  EXPECT_TRUE(bus.unsubscribe(failing));
+  EXPECT_FALSE(bus.unsubscribe(failing));
+  bus.emit_status(name, {});
+  EXPECT_EQ(after, 2);
+  EXPECT_TRUE(bus.unsubscribe(healthy));
+}
+
+TEST_F(ImageSignalBusTests, DeclaringTwiceReturnsSameHandle) {
+  const auto first = bus.declare_signal("test_handle_stable");
+  const auto second = bus.declare_signal("test_handle_stable");
+  const auto other = bus.declare_signal("test_handle_other");
+
+  ASSERT_TRUE(first.valid());
+  EXPECT_EQ(first.index, second.index);
+  EXPECT_NE(first.index, other.index);
+  EXPECT_EQ(bus.find_signal("test_handle_stable").index, first.index);
+  EXPECT_FALSE(bus.find_signal("test_handle_never_declared").valid());
+}
+
+// 按名字订阅、按句柄发送的是同一个信号
+TEST_F(ImageSignalBusTests, HandleAndNameReachSameSubscribers) {
+  const std::string name = "test_handle_emit";
+  const auto handle = bus.declare_signal(name);
+  int by_name = 0;
+  int by_handle = 0;
+  const auto a = bus.subscribe(name, [&](const cv::Mat&) { ++by_name; });
+  const auto b = bus.subscribe(handle, [&](const cv::Mat&) { ++by_handle; });
+  EXPECT_TRUE(bus.has_subscribers(handle));
+
+  const cv::Mat img(2, 2, CV_8UC1, cv::Scalar(1));
+  bus.emit(handle, img);
+  bus.emit(name, img);
+  EXPECT_EQ(by_name, 2);
+  EXPECT_EQ(by_handle, 2);
+
+  // 无效句柄什么也不做
+  bus.emit(ImageSignalBus::SignalHandle{}, img);
+  EXPECT_FALSE(bus.has_subscribers(ImageSignalBus::SignalHandle{}));
+  EXPECT_EQ(bus.subscribe(ImageSignalBus::SignalHandle{},
+                          [](const cv::Mat&) {}),
+            0u);
+
+  EXPECT_TRUE(bus.unsubscribe(a));
+  EXPECT_TRUE(bus.unsubscribe(b));
+  EXPECT_FALSE(bus.has_subscribers(handle));
+}
+
+// 相同目标尺寸的预览订阅者共享一次缩放，原尺寸订阅者不受影响
+TEST_F(ImageSignalBusTests, PreviewSubscribersShareOneResize) {
+  const std::string name = "test_preview_shared";
+  ImageSignalBus::PreviewOptions preview;
+  preview.max_size = cv::Size(4, 4);
+  preview.max_fps = 0;
+  preview.mode = DeliveryMode::Inline;
+
+  std::vector<cv::Mat> previews;
+  cv::Mat full;
+  const auto a = bus.subscribe_preview(
+      name, [&](const cv::Mat& img) { previews.push_back(img); }, preview);
+  const auto b = bus.subscribe_preview(
+      name, [&](const cv::Mat& img) { previews.push_back(img); }, preview);
+  const auto c = bus.subscribe(name, [&](const cv::Mat& img) { full = img; });
+
+  bus.emit(name, cv::Mat(8, 16, CV_8UC1, cv::Scalar(5)));
+
+  ASSERT_EQ(previews.size(), 2u);
+  EXPECT_EQ(previews[0].data, previews[1].data);
+  EXPECT_EQ(previews[0].cols, 4);
+  EXPECT_EQ(previews[0].rows, 2);
+  EXPECT_EQ(full.cols, 16);
+  EXPECT_EQ(full.rows, 8);
+
+  for (const auto id : {a, b, c}) {
+    EXPECT_TRUE(bus.unsubscribe(id));
+  }
+}
+
+// 限速窗口没到时连图像都不生成
+TEST_F(ImageSignalBusTests, RateLimitedPreviewSkipsGeneration) {
+  const std::string name = "test_preview_rate";
+  ImageSignalBus::PreviewOptions preview;
+  preview.max_fps = 1.0;
+  preview.mode = DeliveryMode::Inline;
+  int received = 0;
+  const auto id = bus.subscribe_preview(
+      name, [&](const cv::Mat&) { ++received; }, preview);
+
+  int made = 0;
+  const auto make = [&] {
+    ++made;
+    return cv::Mat(2, 2, CV_8UC1, cv::Scalar(0));
+  };
+  EXPECT_TRUE(bus.has_subscribers(name));
+  bus.emit_if_subscribed(name, make);
+  EXPECT_FALSE(bus.has_subscribers(name));
+  bus.emit_if_subscribed(name, make);
+  bus.emit(name, cv::Mat(2, 2, CV_8UC1, cv::Scalar(0)));
+
+  EXPECT_EQ(made, 1);
+  EXPECT_EQ(received, 1);
+  const auto stats = bus.subscriber_stats();
+  const auto* mine = find_stats(stats, id);
+  ASSERT_NE(mine, nullptr);
+  EXPECT_EQ(mine->mailbox.throttled, 1u);
+  EXPECT_TRUE(bus.unsubscribe(id));
+}